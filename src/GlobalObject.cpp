@@ -37,6 +37,7 @@
 #include "notification/NotificationManager.h"
 #include "platform/FileExchange.h"
 #include "platform/PlatformAdaptor.h"
+#include "positioning/FlightRecorder.h"
 #include "positioning/PositionProvider.h"
 #include "traffic/FlarmnetDB.h"
 #include "traffic/PasswordDB.h"
@@ -52,6 +53,7 @@ QPointer<DataManagement::SSLErrorHandler> g_sslErrorHandler {};
 QPointer<DemoRunner> g_demoRunner {};
 QPointer<Platform::FileExchange> g_fileExchange {};
 QPointer<Traffic::FlarmnetDB> g_flarmnetDB {};
+QPointer<Positioning::FlightRecorder> g_flightRecorder {};
 QPointer<GeoMaps::GeoMapProvider> g_geoMapProvider {};
 QPointer<Librarian> g_librarian {};
 QPointer<Platform::PlatformAdaptor> g_platformAdaptor {};
@@ -110,6 +112,7 @@ void GlobalObject::clear()
     delete g_notificationManager;
     delete g_geoMapProvider;
     delete g_flarmnetDB;
+    delete g_flightRecorder;
     delete g_dataManager;
 
     delete g_sslErrorHandler;
@@ -155,6 +158,12 @@ auto GlobalObject::flarmnetDB() -> Traffic::FlarmnetDB*
     return allocateInternal<Traffic::FlarmnetDB>(g_flarmnetDB);
 }
 
+
+auto GlobalObject::flightRecorder() -> Positioning::FlightRecorder*
+{
+    return allocateInternal<Positioning::FlightRecorder>(g_flightRecorder);
+}
+
 auto GlobalObject::geoMapProvider() -> GeoMaps::GeoMapProvider*
 {
     return allocateInternal<GeoMaps::GeoMapProvider>(g_geoMapProvider);
@@ -72,6 +72,7 @@ class PlatformAdaptor_Abstract;
 
 namespace Positioning
 {
+class FlightRecorder;
 class PositionProvider;
 } // namespace Positioning
 
@@ -162,6 +163,12 @@ public:
      */
     Q_INVOKABLE static Traffic::FlarmnetDB* flarmnetDB();
 
+    /*! \brief Pointer to appplication-wide static FlightRecorder instance
+     *
+     * @returns Pointer to appplication-wide static instance.
+     */
+    Q_INVOKABLE static Positioning::FlightRecorder* flightRecorder();
+
     /*! \brief Pointer to appplication-wide static FileExchange instance
      *
      * @returns Pointer to appplication-wide static instance.
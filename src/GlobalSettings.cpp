@@ -276,6 +276,39 @@ void GlobalSettings::setShowAltitudeAGL(bool newShowAltitudeAGL)
 }
 
 
+void GlobalSettings::setTrafficDataThread(bool newTrafficDataThread)
+{
+    if (newTrafficDataThread == trafficDataThread())
+    {
+        return;
+    }
+    settings.setValue(QStringLiteral("trafficDataThread"), newTrafficDataThread);
+    emit trafficDataThreadChanged();
+}
+
+
+void GlobalSettings::setTrafficDataFusion(bool newTrafficDataFusion)
+{
+    if (newTrafficDataFusion == trafficDataFusion())
+    {
+        return;
+    }
+    settings.setValue(QStringLiteral("trafficDataFusion"), newTrafficDataFusion);
+    emit trafficDataFusionChanged();
+}
+
+
+void GlobalSettings::setTrafficDataBroadcast(bool newTrafficDataBroadcast)
+{
+    if (newTrafficDataBroadcast == trafficDataBroadcast())
+    {
+        return;
+    }
+    settings.setValue(QStringLiteral("trafficDataBroadcast"), newTrafficDataBroadcast);
+    emit trafficDataBroadcastChanged();
+}
+
+
 void GlobalSettings::setVoiceNotifications(uint newVoiceNotifications)
 {
     if (newVoiceNotifications == voiceNotifications())
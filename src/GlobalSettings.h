@@ -165,6 +165,32 @@ public:
     /*! \brief Use traffic data receiver for positioning */
     Q_PROPERTY(bool positioningByTrafficDataReceiver READ positioningByTrafficDataReceiver WRITE setPositioningByTrafficDataReceiver NOTIFY positioningByTrafficDataReceiverChanged)
 
+    /*! \brief Read traffic data receivers on a dedicated I/O thread
+     *
+     *  If true, network connections to traffic data receivers are read and
+     *  pre-processed on a dedicated thread, so that slow GUI frames do not delay
+     *  traffic data. Changes take effect when the next connection is
+     *  established.
+     */
+    Q_PROPERTY(bool trafficDataThread READ trafficDataThread WRITE setTrafficDataThread NOTIFY trafficDataThreadChanged)
+
+    /*! \brief Combine traffic data from all sources
+     *
+     *  If false, traffic data is taken from the most preferred traffic data
+     *  source only. If true, traffic data from all sources that receive
+     *  heartbeat messages is combined, and traffic reported by several sources
+     *  is shown only once.
+     */
+    Q_PROPERTY(bool trafficDataFusion READ trafficDataFusion WRITE setTrafficDataFusion NOTIFY trafficDataFusionChanged)
+
+    /*! \brief Re-broadcast traffic data
+     *
+     *  If true, the position of the own aircraft and the traffic picture are
+     *  broadcast in GDL90 format to UDP port 4000, so that other apps on the
+     *  cockpit network can use them.
+     */
+    Q_PROPERTY(bool trafficDataBroadcast READ trafficDataBroadcast WRITE setTrafficDataBroadcast NOTIFY trafficDataBroadcastChanged)
+
     /*! \brief Voice notifications that should be played
      *
      *  This property is an "or" of the entries of Notifications::Notification::Importance. It determines
@@ -273,6 +299,24 @@ public:
      */
     [[nodiscard]] auto showAltitudeAGL() const -> bool { return settings.value(QStringLiteral("showAltitudeAGL"), false).toBool(); }
 
+    /*! \brief Getter function for property of the same name
+     *
+     * @returns Property trafficDataThread
+     */
+    [[nodiscard]] auto trafficDataThread() const -> bool { return settings.value(QStringLiteral("trafficDataThread"), false).toBool(); }
+
+    /*! \brief Getter function for property of the same name
+     *
+     * @returns Property trafficDataFusion
+     */
+    [[nodiscard]] auto trafficDataFusion() const -> bool { return settings.value(QStringLiteral("trafficDataFusion"), false).toBool(); }
+
+    /*! \brief Getter function for property of the same name
+     *
+     * @returns Property trafficDataBroadcast
+     */
+    [[nodiscard]] auto trafficDataBroadcast() const -> bool { return settings.value(QStringLiteral("trafficDataBroadcast"), false).toBool(); }
+
     /*! \brief Getter function for property of the same name
      *
      * @returns Property voiceNotifications
@@ -385,6 +429,24 @@ public:
      */
     void setShowAltitudeAGL(bool newShowAltitudeAGL);
 
+    /*! \brief Setter function for property of the same name
+     *
+     * @param newTrafficDataThread Property trafficDataThread
+     */
+    void setTrafficDataThread(bool newTrafficDataThread);
+
+    /*! \brief Setter function for property of the same name
+     *
+     * @param newTrafficDataFusion Property trafficDataFusion
+     */
+    void setTrafficDataFusion(bool newTrafficDataFusion);
+
+    /*! \brief Setter function for property of the same name
+     *
+     * @param newTrafficDataBroadcast Property trafficDataBroadcast
+     */
+    void setTrafficDataBroadcast(bool newTrafficDataBroadcast);
+
     /*! \brief Setter function for property of the same name
      *
      * @param newVoiceNotifications Property voiceNotifications
@@ -445,6 +507,15 @@ signals:
     /*! \brief Notifier signal */
     void showAltitudeAGLChanged();
 
+    /*! \brief Notifier signal */
+    void trafficDataThreadChanged();
+
+    /*! \brief Notifier signal */
+    void trafficDataFusionChanged();
+
+    /*! \brief Notifier signal */
+    void trafficDataBroadcastChanged();
+
     /*! \brief Notifier signal */
     void voiceNotificationsChanged();
 
@@ -72,47 +72,25 @@ GeoMaps::Airspace::Airspace(const QJsonObject &geoJSONObject) {
         return;
     }
     m_upperBound = properties[QStringLiteral("TOP")].toString();
+    m_upperLimit = VerticalLimit(m_upperBound);
 
     if (!properties.contains(QStringLiteral("BOT"))) {
         return;
     }
     m_lowerBound = properties[QStringLiteral("BOT")].toString();
+    m_lowerLimit = VerticalLimit(m_lowerBound);
 }
 
 
 auto GeoMaps::Airspace::estimatedLowerBoundMSL() const -> Units::Distance
 {
-    double result = 0.0;
-    bool ok = false;
-
-    QString AL = m_lowerBound.simplified();
+    return m_lowerLimit.estimatedMSL(Units::Distance::fromFT(0.0));
+}
 
-    if (AL.startsWith(u"FL"_qs, Qt::CaseInsensitive)) {
-        result = AL.remove(0, 2).toDouble(&ok);
-        if (ok) {
-            return Units::Distance::fromFT(100*result);
-        }
-        return Units::Distance::fromFT(0.0);
-    }
 
-    if (AL.endsWith(u"msl"_qs)) {
-        AL.chop(3);
-        AL = AL.simplified();
-    }
-    if (AL.endsWith(u"agl"_qs)) {
-        AL.chop(3);
-        AL = AL.simplified();
-    }
-    if (AL.endsWith(u"ft"_qs)) {
-        AL.chop(2);
-        AL = AL.simplified();
-    }
-
-    result = AL.toDouble(&ok);
-    if (ok) {
-        return Units::Distance::fromFT(result);
-    }
-    return Units::Distance::fromFT(0.0);
+auto GeoMaps::Airspace::estimatedUpperBoundMSL() const -> Units::Distance
+{
+    return m_upperLimit.estimatedMSL(Units::Distance::fromFT(qInf()));
 }
 
 
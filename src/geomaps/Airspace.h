@@ -23,6 +23,7 @@
 #include <QGeoPolygon>
 #include <QJsonObject>
 
+#include "geomaps/VerticalLimit.h"
 #include "units/Distance.h"
 
 namespace GeoMaps {
@@ -51,7 +52,9 @@ public:
 
     /*! \brief Estimates the lower limit of the airspace above MSL
      *
-     * This method gives a rought estimate for the lower limit of the airspace.
+     * This method gives a rought estimate for the lower limit of the airspace,
+     * see VerticalLimit::estimatedMSL(). The limit is parsed once, when the
+     * airspace is constructed, so that this method is cheap.
      * The result is not reliable enough for aviation purposes but
      * can be used to sort the airspaces in the GUI.
      *
@@ -60,6 +63,16 @@ public:
      */
     [[nodiscard]] auto estimatedLowerBoundMSL() const -> Units::Distance;
 
+    /*! \brief Estimates the upper limit of the airspace above MSL
+     *
+     * This method gives a rough estimate for the upper limit of the airspace,
+     * in the same way as estimatedLowerBoundMSL(). If the upper limit is
+     * "UNL" or cannot be interpreted, the result is infinite.
+     *
+     * @returns Estimated upper bound of the airspace, above main sea level
+     */
+    [[nodiscard]] auto estimatedUpperBoundMSL() const -> Units::Distance;
+
     /*! \brief Validity */
     Q_PROPERTY(bool isValid READ isValid CONSTANT)
 
@@ -83,6 +96,12 @@ public:
      */
     [[nodiscard]] auto lowerBound() const -> QString { return m_lowerBound; }
 
+    /*! \brief Lower limit of the airspace, in numerical form
+     *
+     * @returns Lower limit, parsed from lowerBound
+     */
+    [[nodiscard]] auto lowerLimit() const -> GeoMaps::VerticalLimit { return m_lowerLimit; }
+
     /*! \brief Lower limit of the airspace
      *
      * A string that describes the lower bound of the airspace in metric terms
@@ -139,6 +158,12 @@ public:
      */
     [[nodiscard]] auto upperBound() const -> QString { return m_upperBound; }
 
+    /*! \brief Upper limit of the airspace, in numerical form
+     *
+     * @returns Upper limit, parsed from upperBound
+     */
+    [[nodiscard]] auto upperLimit() const -> GeoMaps::VerticalLimit { return m_upperLimit; }
+
     /*! \brief Upper limit of the airspace
      *
      * A string that describes the upper bound of the airspace in metric terms
@@ -160,6 +185,8 @@ private:
     QString m_CAT;
     QString m_upperBound;
     QString m_lowerBound;
+    VerticalLimit m_upperLimit;
+    VerticalLimit m_lowerLimit;
     QGeoPolygon m_polygon;
 };
 
@@ -33,6 +33,7 @@
 #include "fileFormats/MBTILES.h"
 #include "geomaps/GeoMapProvider.h"
 #include "geomaps/WaypointLibrary.h"
+#include "navigation/Geodesy.h"
 #include "navigation/Navigator.h"
 
 
@@ -193,6 +194,12 @@ auto GeoMaps::GeoMapProvider::airspaces(const QGeoCoordinate& position) -> QVari
     return final;
 }
 
+auto GeoMaps::GeoMapProvider::allAirspaces() -> QList<Airspace>
+{
+    QMutexLocker const lock(&_aviationDataMutex);
+    return _airspaces_;
+}
+
 auto GeoMaps::GeoMapProvider::closestWaypoint(QGeoCoordinate position, const QGeoCoordinate& distPosition) -> Waypoint
 {
     position.setAltitude(qQNaN());
@@ -419,9 +426,57 @@ auto GeoMaps::GeoMapProvider::nearbyWaypoints(const QGeoCoordinate& position, co
         tWps.append(waypoint);
     }
 
-    std::sort(tWps.begin(), tWps.end(), [position](const Waypoint& first, const Waypoint& second) {return position.distanceTo(first.coordinate()) < position.distanceTo(second.coordinate()); });
+    // Find the 20 nearest waypoints. Distances are computed once per waypoint,
+    // in one batch.
+    Navigation::Geodesy::PointArray points;
+    points.reserve(tWps.size());
+    foreach(const auto& waypoint, tWps) {
+        points.append(waypoint.coordinate());
+    }
+    QList<GeoMaps::Waypoint> result;
+    for(auto index : points.nearestIndices(Navigation::Geodesy::Point(position), 20)) {
+        result.append(tWps[index]);
+    }
+    return result;
+}
+
+auto GeoMaps::GeoMapProvider::snapCandidates() -> QList<GeoMaps::Waypoint>
+{
+    // Candidates, in the order in which closestWaypoint() checks them
+    auto candidates = this->waypoints();
+    candidates += GlobalObject::waypointLibrary()->waypoints();
+    candidates += GlobalObject::navigator()->flightRoute()->midFieldWaypoints();
+    return candidates;
+}
+
+auto GeoMaps::GeoMapProvider::snap(const QList<GeoMaps::Waypoint>& waypoints, const QList<GeoMaps::Waypoint>& candidates, Units::Distance maxDistance) -> QList<GeoMaps::Waypoint>
+{
+    Navigation::Geodesy::ProximityGrid grid(maxDistance.toM());
+    for(const auto& candidate : candidates) {
+        grid.insert(candidate.coordinate());
+    }
+
+    QList<GeoMaps::Waypoint> result;
+    result.reserve(waypoints.size());
+    for(const auto& waypoint : waypoints) {
+        auto const index = grid.nearest(waypoint.coordinate());
+        if ((index < 0) || (candidates[index].type() == u"WP")) {
+            result << waypoint;
+        } else {
+            result << candidates[index];
+        }
+    }
+    return result;
+}
+
+auto GeoMaps::GeoMapProvider::snapToWaypoints(const QList<GeoMaps::Waypoint>& waypoints, Units::Distance maxDistance) -> QList<GeoMaps::Waypoint>
+{
+    return snap(waypoints, snapCandidates(), maxDistance);
+}
 
-    return tWps.mid(0,20);
+auto GeoMaps::GeoMapProvider::snapToWaypointsAsync(const QList<GeoMaps::Waypoint>& waypoints, Units::Distance maxDistance) -> QFuture<QList<GeoMaps::Waypoint>>
+{
+    return QtConcurrent::run(&GeoMaps::GeoMapProvider::snap, waypoints, snapCandidates(), maxDistance);
 }
 
 auto GeoMaps::GeoMapProvider::waypoints() -> QVector<Waypoint>
@@ -617,11 +672,8 @@ void GeoMaps::GeoMapProvider::fillAviationDataCache(QStringList JSONFileNames, U
 
         // If 'hideGlidingSector' is set, ignore all objects that are airspaces
         // and that are gliding sectors
-        if (hideGlidingSectors) {
-            Airspace const airspaceTest(object);
-            if (airspaceTest.CAT() == u"GLD"_qs) {
-                continue;
-            }
+        if (hideGlidingSectors && (airspaceTest.CAT() == u"GLD"_qs)) {
+            continue;
         }
 
         newFeatures += object;
@@ -637,12 +689,18 @@ void GeoMaps::GeoMapProvider::fillAviationDataCache(QStringList JSONFileNames, U
     }
     auto _geoJSONChanged = (newGeoJSON != _combinedGeoJSON_);
     auto _waypointsChanged = (newWaypoints != _waypoints_);
+    _aviationDataMutex.lock();
+    auto _airspacesChanged = (newAirspaces != _airspaces_);
+    _aviationDataMutex.unlock();
 
     // Sort waypoints by name
     std::sort(newWaypoints.begin(), newWaypoints.end(), [](const Waypoint& first, const Waypoint& second) {return first.name() < second.name(); });
 
     _aviationDataMutex.lock();
-    _airspaces_ = newAirspaces;
+    if (_airspacesChanged)
+    {
+        _airspaces_ = newAirspaces;
+    }
     if (_waypointsChanged)
     {
         _waypoints_ = newWaypoints;
@@ -657,6 +715,10 @@ void GeoMaps::GeoMapProvider::fillAviationDataCache(QStringList JSONFileNames, U
     }
     _aviationDataMutex.unlock();
 
+    if (_airspacesChanged)
+    {
+        emit airspacesChanged();
+    }
     if (_waypointsChanged)
     {
         emit waypointsChanged();
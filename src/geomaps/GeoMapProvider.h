@@ -208,6 +208,15 @@ public:
      */
     Q_INVOKABLE QVariantList airspaces(const QGeoCoordinate &position);
 
+    /*! \brief List of all airspaces
+     *
+     * This method is thread-safe.
+     *
+     * @returns all airspaces contained in the installed aviation maps,
+     * including those hidden from the moving map
+     */
+    [[nodiscard]] auto allAirspaces() -> QList<GeoMaps::Airspace>;
+
     /*! \brief Find closest waypoint to a given position
      *
      * @param position Position near which waypoints are searched for
@@ -281,8 +290,49 @@ public:
      */
     Q_INVOKABLE QList<GeoMaps::Waypoint> nearbyWaypoints(const QGeoCoordinate& position, const QString& type);
 
+    /*! \brief Snap waypoints to nearby waypoints from the map and library
+     *
+     * This is the batch version of closestWaypoint(), used when importing
+     * flight routes. Every waypoint is replaced by the closest waypoint from
+     * the map, from the waypoint library or from the current flight route,
+     * provided that the distance is at most maxDistance and that the closest
+     * waypoint is not a generic waypoint. Otherwise, the waypoint is kept.
+     *
+     * The candidates are put into a spatial index once, so that the cost of
+     * snapping a whole route is roughly that of one linear scan over the
+     * candidates. For long routes, use snapToWaypointsAsync() instead.
+     *
+     * @param waypoints Waypoints to be snapped
+     *
+     * @param maxDistance Maximal snapping distance
+     *
+     * @returns Snapped waypoints, in the original order
+     */
+    [[nodiscard]] auto snapToWaypoints(const QList<GeoMaps::Waypoint>& waypoints, Units::Distance maxDistance) -> QList<GeoMaps::Waypoint>;
+
+    /*! \brief Snap waypoints to nearby waypoints, on a worker thread
+     *
+     * This method does the same as snapToWaypoints(). The candidate waypoints
+     * are collected on the calling thread. Building the spatial index and
+     * searching run on a worker thread, so that the GUI thread is not blocked
+     * while large routes are imported.
+     *
+     * @param waypoints Waypoints to be snapped
+     *
+     * @param maxDistance Maximal snapping distance
+     *
+     * @returns Future that holds the snapped waypoints, in the original order
+     */
+    [[nodiscard]] auto snapToWaypointsAsync(const QList<GeoMaps::Waypoint>& waypoints, Units::Distance maxDistance) -> QFuture<QList<GeoMaps::Waypoint>>;
 
 signals:
+    /*! \brief Emitted when the list of airspaces changes
+     *
+     * This signal is emitted whenever the result of allAirspaces() changes,
+     * for instance after maps have been installed or removed.
+     */
+    void airspacesChanged();
+
     /*! \brief Notification signal for the property with the same name */
     void baseMapTilesChanged();
 
@@ -314,6 +364,14 @@ private:
     // separate thread.
     void fillAviationDataCache(QStringList JSONFileNames, Units::Distance airspaceAltitudeLimit, bool hideGlidingSectors);
 
+    // Candidate waypoints for snapToWaypoints(). Must be called on the GUI
+    // thread.
+    auto snapCandidates() -> QList<GeoMaps::Waypoint>;
+
+    // Replaces every waypoint by the closest candidate, see
+    // snapToWaypoints(). This function is thread-safe.
+    static auto snap(const QList<GeoMaps::Waypoint>& waypoints, const QList<GeoMaps::Waypoint>& candidates, Units::Distance maxDistance) -> QList<GeoMaps::Waypoint>;
+
     // Caches used to speed up the method simplifySpecialChars
     QRegularExpression specialChars{QStringLiteral("[^a-zA-Z0-9]")};
     QHash<QString, QString> simplifySpecialChars_cache;
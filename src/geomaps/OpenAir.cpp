@@ -27,6 +27,7 @@
 
 #include "OpenAir.h"
 #include "fileFormats/DataFileAbstract.h"
+#include "navigation/Geodesy.h"
 
 #include <cmath>
 
@@ -56,10 +57,12 @@ public:
         }
         if (variableX.isValid())
         {
+            std::vector<double> azimuths;
             for (int i=0; i <= 360; i += 10)
             {
-                polygon.prepend(variableX.atDistanceAndAzimuth(radius, i));
+                azimuths.push_back(i);
             }
+            prependCirclePoints(radius, azimuths);
         }
         else
         {
@@ -170,11 +173,13 @@ public:
             throw QObject::tr("Invalid arc specification", "OpenAir");
         }
 
+        std::vector<double> azimuths;
         do
         {
-            polygon.prepend(variableX.atDistanceAndAzimuth(radius, start));
+            azimuths.push_back(start);
             start += 10;
         } while (start < end);
+        prependCirclePoints(radius, azimuths);
     }
 
     void addArcCounterClockwise(double radius, double start, double end)
@@ -184,11 +189,23 @@ public:
             throw QObject::tr("Invalid arc specification", "OpenAir");
         }
 
+        std::vector<double> azimuths;
         do
         {
-            polygon.prepend(variableX.atDistanceAndAzimuth(radius, start));
+            azimuths.push_back(start);
             start -= 10;
         } while (start > end);
+        prependCirclePoints(radius, azimuths);
+    }
+
+    // Prepends points at the given distance from variableX to the polygon, in
+    // the order of the azimuths
+    void prependCirclePoints(double radius, const std::vector<double>& azimuths)
+    {
+        foreach(const auto& point, Navigation::Geodesy::destinations(variableX, radius, azimuths))
+        {
+            polygon.prepend(point);
+        }
     }
 
     /*
@@ -0,0 +1,170 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include <QStringView>
+
+#include "geomaps/VerticalLimit.h"
+
+
+namespace {
+
+// Removes leading whitespace
+void skipSpace(QStringView& text)
+{
+    while (!text.isEmpty() && text.front().isSpace())
+    {
+        text = text.sliced(1);
+    }
+}
+
+// Removes a keyword from the start of the text. The keyword must not be
+// followed by a letter. Returns true if the keyword was found.
+bool takeKeyword(QStringView& text, QStringView keyword)
+{
+    if (!text.startsWith(keyword, Qt::CaseInsensitive))
+    {
+        return false;
+    }
+    if ((text.size() > keyword.size()) && text[keyword.size()].isLetter())
+    {
+        return false;
+    }
+    text = text.sliced(keyword.size());
+    skipSpace(text);
+    return true;
+}
+
+// Removes the first of a list of keywords from the start of the text
+bool takeAnyKeyword(QStringView& text, std::initializer_list<QStringView> keywords)
+{
+    for(auto keyword : keywords)
+    {
+        if (takeKeyword(text, keyword))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Removes a non-negative decimal number from the start of the text
+bool takeNumber(QStringView& text, double& number)
+{
+    qsizetype length = 0;
+    while ((length < text.size()) && (text[length].isDigit() || (text[length] == u'.')))
+    {
+        length++;
+    }
+    bool ok = false;
+    number = text.first(length).toDouble(&ok);
+    if (!ok)
+    {
+        return false;
+    }
+    text = text.sliced(length);
+    skipSpace(text);
+    return true;
+}
+
+} // namespace
+
+
+GeoMaps::VerticalLimit::VerticalLimit(const QString& limit)
+{
+    QStringView text(limit);
+    skipSpace(text);
+
+    if (takeAnyKeyword(text, {u"GND", u"SFC", u"GROUND", u"SURFACE"}))
+    {
+        m_reference = Reference::GND;
+        return;
+    }
+    if (takeAnyKeyword(text, {u"UNL", u"UNLIM", u"UNLIMITED"}))
+    {
+        m_reference = Reference::UNL;
+        return;
+    }
+
+    double number = 0.0;
+    if (text.startsWith(u"FL", Qt::CaseInsensitive))
+    {
+        text = text.sliced(2);
+        skipSpace(text);
+        if (takeNumber(text, number))
+        {
+            m_value = static_cast<float>(number);
+            m_reference = Reference::FL;
+        }
+        return;
+    }
+
+    if (!takeNumber(text, number))
+    {
+        return;
+    }
+    if (takeKeyword(text, u"M"))
+    {
+        number = Units::Distance::fromM(number).toFeet();
+    }
+    else
+    {
+        (void)takeAnyKeyword(text, {u"FT", u"F"});
+    }
+
+    if (takeAnyKeyword(text, {u"AGL", u"GND", u"SFC", u"ASFC"}))
+    {
+        if (number == 0.0)
+        {
+            m_reference = Reference::GND;
+            return;
+        }
+        m_value = static_cast<float>(number);
+        m_reference = Reference::AGL;
+        return;
+    }
+    (void)takeAnyKeyword(text, {u"MSL", u"AMSL", u"ALT"});
+    m_value = static_cast<float>(number);
+    m_reference = Reference::MSL;
+}
+
+
+//
+// Methods
+//
+
+auto GeoMaps::VerticalLimit::estimatedMSL(Units::Distance fallback) const -> Units::Distance
+{
+    switch (m_reference)
+    {
+    case Reference::MSL:
+    case Reference::AGL:
+        return Units::Distance::fromFT(m_value);
+    case Reference::FL:
+        return Units::Distance::fromFT(100.0*m_value);
+    case Reference::GND:
+        return Units::Distance::fromFT(0.0);
+    case Reference::UNL:
+        return Units::Distance::fromFT(qInf());
+    case Reference::Unknown:
+        break;
+    }
+    return fallback;
+}
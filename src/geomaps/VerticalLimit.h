@@ -0,0 +1,133 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <QString>
+
+#include "units/Distance.h"
+
+
+namespace GeoMaps {
+
+/*! \brief Vertical limit of an airspace, in numerical form
+ *
+ *  This class holds the upper or lower limit of an airspace as a number,
+ *  together with its reference. It is constructed once from the limit string
+ *  found in the aviation maps, so that numerical comparisons do not need to
+ *  parse strings. An instance takes eight bytes.
+ *
+ *  The following grammar is accepted. Letters are case-insensitive, and
+ *  whitespace between the tokens is optional.
+ *
+ *  - "GND", "SFC", "GROUND" or "SURFACE": ground. A number followed by "GND",
+ *    "SFC" or "ASFC" is a height above ground.
+ *
+ *  - "UNL", "UNLIM" or "UNLIMITED": no limit
+ *
+ *  - "FL" followed by a number, such as "FL 65", "FL065" or "FL95"
+ *
+ *  - A number, optionally followed by a unit "FT", "F" or "M", optionally
+ *    followed by a reference "MSL", "AMSL" or "ALT" (mean sea level) or
+ *    "AGL", "GND", "SFC" or "ASFC" (above ground). Numbers without reference
+ *    are taken relative to MSL. A height of zero above ground is ground.
+ *    Examples: "2500", "4500 ft MSL", "1000ft AMSL", "1500 AGL", "300 m AGL"
+ *
+ *  These are the formats found in the GeoJSON files of Enroute Flight
+ *  Navigation, in openAIP data and in OpenAir files (fields AL and AH).
+ *  Anything else, such as "NOTAM" or "by ATC", yields a limit with reference
+ *  Unknown. Text following a valid limit, such as "FL 100 (MON-FRI)", is
+ *  ignored.
+ */
+
+class VerticalLimit
+{
+public:
+    /*! \brief Reference of a vertical limit */
+    enum class Reference : quint8
+    {
+        Unknown, /*!< Limit could not be parsed */
+        MSL,     /*!< Altitude above mean sea level, in feet */
+        AGL,     /*!< Height above ground, in feet */
+        FL,      /*!< Flight level */
+        GND,     /*!< Ground */
+        UNL      /*!< No limit */
+    };
+
+    /*! \brief Constructs a limit with reference Unknown */
+    VerticalLimit() = default;
+
+    /*! \brief Parse limit
+     *
+     *  @param limit Limit string, as described in the class documentation
+     */
+    explicit VerticalLimit(const QString& limit);
+
+
+    //
+    // Getter Methods
+    //
+
+    /*! \brief Reference
+     *
+     *  @returns Reference of the limit
+     */
+    [[nodiscard]] auto reference() const -> Reference { return m_reference; }
+
+    /*! \brief Value
+     *
+     *  @returns Value of the limit, in feet for references MSL and AGL, and
+     *  in hundreds of feet for reference FL. For other references, the value
+     *  is 0.
+     */
+    [[nodiscard]] auto value() const -> float { return m_value; }
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Rough estimate of the limit above MSL
+     *
+     *  Flight levels are converted with the standard pressure at sea level.
+     *  Heights above ground are taken as altitudes, which underestimates them
+     *  by the elevation of the terrain.
+     *
+     *  @param fallback Result for limits with reference Unknown
+     *
+     *  @returns Estimated altitude of the limit; infinite for reference UNL
+     */
+    [[nodiscard]] auto estimatedMSL(Units::Distance fallback) const -> Units::Distance;
+
+    /*! \brief Equality check
+     *
+     *  @param other Limit that is compared to this
+     *
+     *  @result equality
+     */
+    [[nodiscard]] bool operator==(const GeoMaps::VerticalLimit& other) const = default;
+
+private:
+    float m_value {0.0F};
+    Reference m_reference {Reference::Unknown};
+};
+
+} // namespace GeoMaps
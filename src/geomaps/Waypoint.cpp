@@ -24,6 +24,7 @@
 #include "GlobalObject.h"
 #include "Waypoint.h"
 #include "navigation/Aircraft.h"
+#include "navigation/Geodesy.h"
 #include "navigation/Navigator.h"
 #include "units/Distance.h"
 
@@ -217,7 +218,7 @@ auto GeoMaps::Waypoint::isNear(const Waypoint& other) const -> bool
         return false;
     }
 
-    return m_coordinate.distanceTo(other.m_coordinate) < 2000;
+    return Navigation::Geodesy::isCloserThan(m_coordinate, other.m_coordinate, nearDistanceInM);
 }
 
 
@@ -344,7 +344,7 @@ public:
      *  @param other Other waypoint
      *
      *  @returns True if both waypoints are valid and if the distance between
-     *  them is less than 2km
+     *  them is less than nearDistanceInM
      */
     [[nodiscard]] Q_INVOKABLE bool isNear(const GeoMaps::Waypoint& other) const;
 
@@ -368,6 +368,14 @@ public:
      */
     void toGPX(QXmlStreamWriter& stream) const;
 
+
+    //
+    // CONSTANTS
+    //
+
+    /*! \brief Distance below which waypoints are considered near, see isNear() */
+    static constexpr double nearDistanceInM = 2000.0;
+
 protected:
     QGeoCoordinate m_coordinate;
     QMap<QString, QVariant> m_properties;
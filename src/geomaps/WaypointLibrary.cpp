@@ -28,6 +28,7 @@
 #include "geomaps/GPX.h"
 #include "geomaps/GeoJSON.h"
 #include "geomaps/WaypointLibrary.h"
+#include "navigation/Geodesy.h"
 
 GeoMaps::WaypointLibrary::WaypointLibrary(QObject *parent)
     : GlobalObject(parent)
@@ -182,20 +183,19 @@ auto GeoMaps::WaypointLibrary::import(const QString& fileName, bool skip) -> QSt
 
     if (skip)
     {
+        // Index existing waypoints on a grid, so that every new waypoint is
+        // only compared with the waypoints in neighbouring grid cells
+        Navigation::Geodesy::ProximityGrid grid(GeoMaps::Waypoint::nearDistanceInM);
+        foreach(const auto& existingWaypoint, m_waypoints)
+        {
+            grid.insert(existingWaypoint.coordinate());
+        }
         foreach(const auto& newWaypoint, result)
         {
-            bool skip = false;
-            foreach(const auto& existingWaypoint, m_waypoints)
-            {
-                if (newWaypoint.isNear(existingWaypoint))
-                {
-                    skip = true;
-                    break;
-                }
-            }
-            if (!skip)
+            if (!grid.containsNear(newWaypoint.coordinate()))
             {
                 m_waypoints.append(newWaypoint);
+                grid.insert(newWaypoint.coordinate());
             }
         }
     }
@@ -19,6 +19,7 @@
  ***************************************************************************/
 
 #include <QCommandLineParser>
+#include <QDebug>
 #include <QFile>
 #include <QGuiApplication>
 #include <QIcon>
@@ -56,6 +57,7 @@
 #include "geomaps/WaypointLibrary.h"
 #include "platform/FileExchange_Abstract.h"
 #include "platform/PlatformAdaptor_Abstract.h"
+#include "positioning/FlightRecorder.h"
 #include "traffic/TrafficDataProvider.h"
 #include "traffic/TrafficFactor_WithPosition.h"
 #include "weather/Station.h"
@@ -165,6 +167,17 @@ auto main(int argc, char *argv[]) -> int
             "main", "look up string using Librarian::getStringFromRessource and print it to stdout"),
         QCoreApplication::translate("main", "string name"));
     parser.addOption(extractStringOption);
+    QCommandLineOption const replayOption(
+        QStringLiteral("replay"),
+        QCoreApplication::translate("main", "Replay recorded flight, for testing and profiling"),
+        QCoreApplication::translate("main", "flight log"));
+    parser.addOption(replayOption);
+    QCommandLineOption const replaySpeedOption(
+        QStringLiteral("replay-speed"),
+        QCoreApplication::translate("main", "Speed factor for replaying recorded flights"),
+        QCoreApplication::translate("main", "factor"),
+        QStringLiteral("1"));
+    parser.addOption(replaySpeedOption);
     parser.addPositionalArgument(QStringLiteral("[fileName]"), QCoreApplication::translate("main", "File to import."));
     parser.process(app);
 
@@ -202,6 +215,9 @@ auto main(int argc, char *argv[]) -> int
         GlobalObject::fileExchange()->processFileOpenRequest(positionalArguments[0]);
     }
 
+    // Start flight recorder
+    GlobalObject::flightRecorder();
+
 #if !defined(Q_OS_ANDROID) and !defined(Q_OS_IOS)
     QObject::connect(&kdsingleapp,
                      &KDSingleApplication::messageReceived,
@@ -241,6 +257,15 @@ auto main(int argc, char *argv[]) -> int
         QTimer::singleShot(1s, GlobalObject::demoRunner(), &DemoRunner::generateManualScreenshots);
     }
 
+    if (parser.isSet(replayOption))
+    {
+        auto const error = GlobalObject::flightRecorder()->startReplay(parser.value(replayOption), parser.value(replaySpeedOption).toDouble());
+        if (!error.isEmpty())
+        {
+            qWarning() << error;
+        }
+    }
+
     // Load GUI and enter event loop
     auto result = QGuiApplication::exec();
 
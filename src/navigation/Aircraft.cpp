@@ -33,6 +33,24 @@
 // Setter Methods
 //
 
+void Navigation::Aircraft::setClimbRate(Units::Speed newRate)
+{
+    if ((newRate < minValidVerticalSpeed) || (newRate > maxValidVerticalSpeed)) {
+        newRate = Units::Speed();
+    }
+    m_climbRate = newRate;
+}
+
+
+void Navigation::Aircraft::setClimbSpeed(Units::Speed newSpeed)
+{
+    if ((newSpeed < minValidSpeed) || (newSpeed > maxValidSpeed)) {
+        newSpeed = Units::Speed();
+    }
+    m_climbSpeed = newSpeed;
+}
+
+
 void Navigation::Aircraft::setCruiseSpeed(Units::Speed newSpeed)
 {
     if ((newSpeed < minValidSpeed) || (newSpeed > maxValidSpeed)) {
@@ -42,6 +60,15 @@ void Navigation::Aircraft::setCruiseSpeed(Units::Speed newSpeed)
 }
 
 
+void Navigation::Aircraft::setDescentRate(Units::Speed newRate)
+{
+    if ((newRate < minValidVerticalSpeed) || (newRate > maxValidVerticalSpeed)) {
+        newRate = Units::Speed();
+    }
+    m_descentRate = newRate;
+}
+
+
 void Navigation::Aircraft::setDescentSpeed(Units::Speed newSpeed)
 {
     if ((newSpeed < minValidSpeed) || (newSpeed > maxValidSpeed)) {
@@ -220,7 +247,10 @@ auto Navigation::Aircraft::loadFromJSON(const QByteArray &JSON) -> QString
         return QObject::tr("JSON document does not describe an aircraft.");
     }
 
+    setClimbRate( Units::Speed::fromMPS( content[QStringLiteral("climbRate_mps")].toDouble(NAN) ));
+    setClimbSpeed( Units::Speed::fromMPS( content[QStringLiteral("climbSpeed_mps")].toDouble(NAN) ));
     setCruiseSpeed( Units::Speed::fromMPS( content[QStringLiteral("cruiseSpeed_mps")].toDouble(NAN) ));
+    setDescentRate( Units::Speed::fromMPS( content[QStringLiteral("descentRate_mps")].toDouble(NAN) ));
     setDescentSpeed( Units::Speed::fromMPS( content[QStringLiteral("descentSpeed_mps")].toDouble(NAN) ));
     setFuelConsumption( Units::VolumeFlow::fromLPH( content[QStringLiteral("fuelConsumption_lph")].toDouble(NAN) ));
     setFuelConsumptionUnit( static_cast<FuelConsumptionUnit>(content[QStringLiteral("fuelConsumptionUnit")].toInt(LiterPerHour)) );
@@ -235,7 +265,10 @@ auto Navigation::Aircraft::loadFromJSON(const QByteArray &JSON) -> QString
 
 auto Navigation::Aircraft::operator==(const Navigation::Aircraft& other) const -> bool
 {
-    return (m_cruiseSpeed == other.m_cruiseSpeed) &&
+    return (m_climbRate == other.m_climbRate) &&
+            (m_climbSpeed == other.m_climbSpeed) &&
+            (m_cruiseSpeed == other.m_cruiseSpeed) &&
+            (m_descentRate == other.m_descentRate) &&
             (m_descentSpeed == other.m_descentSpeed) &&
             (m_fuelConsumption == other.m_fuelConsumption) &&
             (m_fuelConsumptionUnit == other.m_fuelConsumptionUnit) &&
@@ -272,7 +305,10 @@ auto Navigation::Aircraft::toJSON() const -> QByteArray
     QJsonObject jsonObj;
     jsonObj.insert(QStringLiteral("content"), "aircraft");
 
+    jsonObj.insert(QStringLiteral("climbRate_mps"), m_climbRate.toMPS());
+    jsonObj.insert(QStringLiteral("climbSpeed_mps"), m_climbSpeed.toMPS());
     jsonObj.insert(QStringLiteral("cruiseSpeed_mps"), m_cruiseSpeed.toMPS());
+    jsonObj.insert(QStringLiteral("descentRate_mps"), m_descentRate.toMPS());
     jsonObj.insert(QStringLiteral("descentSpeed_mps"), m_descentSpeed.toMPS());
     jsonObj.insert(QStringLiteral("fuelConsumption_lph"), m_fuelConsumption.toLPH());
     jsonObj.insert(QStringLiteral("fuelConsumptionUnit"), m_fuelConsumptionUnit);
@@ -75,6 +75,22 @@ public:
     // Properties
     //
 
+    /*! \brief Climb Rate
+     *
+     * This property holds the rate of climb of the aircraft. This is a
+     * number that lies in the interval [minValidVerticalSpeed,
+     * maxValidVerticalSpeed] or NaN if the climb rate has not been set.
+     */
+    Q_PROPERTY(Units::Speed climbRate READ climbRate WRITE setClimbRate)
+
+    /*! \brief Climb Speed
+     *
+     * This property holds the true airspeed of the aircraft in the climb.
+     * This is a number that lies in the interval [minAircraftSpeed,
+     * maxAircraftSpeed] or NaN if the climb speed has not been set.
+     */
+    Q_PROPERTY(Units::Speed climbSpeed READ climbSpeed WRITE setClimbSpeed)
+
     /*! \brief Cruise Speed
      *
      * This property holds the cruise speed of the aircraft. This lies in the interval [minAircraftSpeed,
@@ -82,6 +98,14 @@ public:
      */
     Q_PROPERTY(Units::Speed cruiseSpeed READ cruiseSpeed WRITE setCruiseSpeed)
 
+    /*! \brief Descent Rate
+     *
+     * This property holds the rate of descent of the aircraft, as a positive
+     * number. This lies in the interval [minValidVerticalSpeed,
+     * maxValidVerticalSpeed] or is NaN if the descent rate has not been set.
+     */
+    Q_PROPERTY(Units::Speed descentRate READ descentRate WRITE setDescentRate)
+
     /*! \brief Decent Speed
      *
      * This property holds the descent speed of the aircraft. This is a
@@ -107,6 +131,9 @@ public:
     /*! \brief Maximal speed of the aircraft that is considered valid */
     Q_PROPERTY(Units::Speed maxValidSpeed MEMBER maxValidSpeed CONSTANT)
 
+    /*! \brief Maximal vertical speed of the aircraft that is considered valid */
+    Q_PROPERTY(Units::Speed maxValidVerticalSpeed MEMBER maxValidVerticalSpeed CONSTANT)
+
     /*! \brief Maximal fuel consumption that is considered valid */
     Q_PROPERTY(Units::VolumeFlow maxValidFuelConsumption MEMBER maxValidFuelConsumption CONSTANT)
 
@@ -123,6 +150,9 @@ public:
     /*! \brief Minimal speed of the aircraft that is considered valid */
     Q_PROPERTY(Units::Speed minValidSpeed MEMBER minValidSpeed CONSTANT)
 
+    /*! \brief Minimal vertical speed of the aircraft that is considered valid */
+    Q_PROPERTY(Units::Speed minValidVerticalSpeed MEMBER minValidVerticalSpeed CONSTANT)
+
     /*! \brief Name
      *
      * This property holds the name.
@@ -137,12 +167,30 @@ public:
     // Getter Methods
     //
 
+    /*! \brief Getter function for property of the same name
+     *
+     * @returns Property climbRate
+     */
+    [[nodiscard]] auto climbRate() const -> Units::Speed { return m_climbRate; }
+
+    /*! \brief Getter function for property of the same name
+     *
+     * @returns Property climbSpeed
+     */
+    [[nodiscard]] auto climbSpeed() const -> Units::Speed { return m_climbSpeed; }
+
     /*! \brief Getter function for property of the same name
      *
      * @returns Property cruise speed
      */
     [[nodiscard]] auto cruiseSpeed() const -> Units::Speed { return m_cruiseSpeed; }
 
+    /*! \brief Getter function for property of the same name
+     *
+     * @returns Property descentRate
+     */
+    [[nodiscard]] auto descentRate() const -> Units::Speed { return m_descentRate; }
+
     /*! \brief Getter function for property of the same name
      *
      * @returns Property descentSpeed
@@ -190,6 +238,21 @@ public:
     // Setter Methods
     //
 
+    /*! \brief Setter function for property of the same name
+     *
+     * If newRate is outside of the interval [minValidVerticalSpeed,
+     * maxValidVerticalSpeed], the property will be set to NaN.
+     *
+     * @param newRate Climb rate
+     */
+    void setClimbRate(Units::Speed newRate);
+
+    /*! \brief Setter function for property of the same name
+     *
+     * @param newSpeed Climb speed
+     */
+    void setClimbSpeed(Units::Speed newSpeed);
+
     /*! \brief Setter function for property of the same name
      *
      * This method saves the new value in a QSetting object. If speedInKT is
@@ -200,6 +263,15 @@ public:
      */
     void setCruiseSpeed(Units::Speed newSpeed);
 
+    /*! \brief Setter function for property of the same name
+     *
+     * If newRate is outside of the interval [minValidVerticalSpeed,
+     * maxValidVerticalSpeed], the property will be set to NaN.
+     *
+     * @param newRate Descent rate
+     */
+    void setDescentRate(Units::Speed newRate);
+
     /*! \brief Setter function for property of the same name
      *
      * @param newSpeed Descent speed
@@ -379,8 +451,13 @@ private:
     static constexpr Units::Speed maxValidSpeed = Units::Speed::fromKN(400.0);
     static constexpr Units::VolumeFlow minValidFuelConsumption = Units::VolumeFlow::fromLPH(0.0);
     static constexpr Units::VolumeFlow maxValidFuelConsumption = Units::VolumeFlow::fromLPH(300.0);
+    static constexpr Units::Speed minValidVerticalSpeed = Units::Speed::fromFPM(100.0);
+    static constexpr Units::Speed maxValidVerticalSpeed = Units::Speed::fromFPM(6000.0);
 
+    Units::Speed m_climbRate {};
+    Units::Speed m_climbSpeed {};
     Units::Speed m_cruiseSpeed {};
+    Units::Speed m_descentRate {};
     Units::Speed m_descentSpeed {};
     Units::VolumeFlow m_fuelConsumption {};
     FuelConsumptionUnit m_fuelConsumptionUnit {LiterPerHour};
@@ -0,0 +1,305 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include <QGeoPolygon>
+#include <algorithm>
+#include <cmath>
+
+#include "navigation/AirspaceCrossing.h"
+
+
+namespace {
+
+// Point of the latitude/longitude plane
+struct PlanePoint
+{
+    double latitude;
+    double longitude;
+};
+
+// Parameter u in [0, 1) at which the segment a0–a1 meets the segment b0–b1
+// for a parameter in [0, 1) along b0–b1, or NaN if the segments do not meet or
+// are parallel. Parameters are half-open so that a crossing at a shared
+// endpoint of two consecutive segments is found only once.
+double intersect(PlanePoint a0, PlanePoint a1, PlanePoint b0, PlanePoint b1)
+{
+    auto const dALat = a1.latitude - a0.latitude;
+    auto const dALon = a1.longitude - a0.longitude;
+    auto const dBLat = b1.latitude - b0.latitude;
+    auto const dBLon = b1.longitude - b0.longitude;
+    auto const denominator = dALon*dBLat - dALat*dBLon;
+    if (denominator == 0.0)
+    {
+        return qQNaN();
+    }
+    auto const dLat = b0.latitude - a0.latitude;
+    auto const dLon = b0.longitude - a0.longitude;
+    auto const u = (dLon*dBLat - dLat*dBLon)/denominator;
+    auto const v = (dLon*dALat - dLat*dALon)/denominator;
+    if ((u < 0.0) || (u >= 1.0) || (v < 0.0) || (v >= 1.0))
+    {
+        return qQNaN();
+    }
+    return u;
+}
+
+} // namespace
+
+
+Navigation::AirspaceCrossing::AirspaceCrossing(GeoMaps::Airspace airspace, qsizetype leg, const QGeoCoordinate& entry, const QGeoCoordinate& exit, Units::Distance entryDistance, Units::Distance exitDistance)
+    : m_airspace(std::move(airspace)),
+      m_leg(leg),
+      m_entry(entry),
+      m_exit(exit),
+      m_entryDistance(entryDistance),
+      m_exitDistance(exitDistance)
+{
+}
+
+
+Navigation::AirspaceIndex::AirspaceIndex(const QList<GeoMaps::Airspace>& airspaces)
+{
+    m_airspaces.reserve(airspaces.size());
+    m_polygons.reserve(airspaces.size());
+
+    for(const auto& airspace : airspaces)
+    {
+        if (!airspace.isValid())
+        {
+            continue;
+        }
+        auto const perimeter = airspace.polygon().perimeter();
+        if (perimeter.size() < 3)
+        {
+            continue;
+        }
+
+        Polygon polygon;
+        polygon.first = static_cast<qsizetype>(m_latitudes.size());
+        polygon.minLatitude = perimeter[0].latitude();
+        polygon.maxLatitude = perimeter[0].latitude();
+        polygon.minLongitude = perimeter[0].longitude();
+        polygon.maxLongitude = perimeter[0].longitude();
+        for(const auto& vertex : perimeter)
+        {
+            m_latitudes.push_back(vertex.latitude());
+            m_longitudes.push_back(vertex.longitude());
+            polygon.minLatitude = qMin(polygon.minLatitude, vertex.latitude());
+            polygon.maxLatitude = qMax(polygon.maxLatitude, vertex.latitude());
+            polygon.minLongitude = qMin(polygon.minLongitude, vertex.longitude());
+            polygon.maxLongitude = qMax(polygon.maxLongitude, vertex.longitude());
+        }
+        polygon.count = perimeter.size();
+
+        // Sort into all cells that meet the bounding box
+        auto const index = static_cast<qsizetype>(m_polygons.size());
+        for(auto latitude = std::floor(polygon.minLatitude/cellSizeInDEG)*cellSizeInDEG; latitude <= polygon.maxLatitude; latitude += cellSizeInDEG)
+        {
+            for(auto longitude = std::floor(polygon.minLongitude/cellSizeInDEG)*cellSizeInDEG; longitude <= polygon.maxLongitude; longitude += cellSizeInDEG)
+            {
+                m_cells[cellKey(latitude + cellSizeInDEG/2.0, longitude + cellSizeInDEG/2.0)].push_back(index);
+            }
+        }
+
+        m_polygons.push_back(polygon);
+        m_airspaces.append(airspace);
+    }
+}
+
+
+//
+// Methods
+//
+
+quint64 Navigation::AirspaceIndex::cellKey(double latitude, double longitude)
+{
+    auto const row = static_cast<qint64>(std::floor((latitude + 90.0)/cellSizeInDEG));
+    auto const column = static_cast<qint64>(std::floor((longitude + 180.0)/cellSizeInDEG));
+    return (static_cast<quint64>(row) << 32U) | static_cast<quint32>(column);
+}
+
+
+bool Navigation::AirspaceIndex::contains(const Polygon& polygon, double latitude, double longitude) const
+{
+    if ((latitude < polygon.minLatitude) || (latitude > polygon.maxLatitude)
+        || (longitude < polygon.minLongitude) || (longitude > polygon.maxLongitude))
+    {
+        return false;
+    }
+
+    const auto* lat = m_latitudes.data() + polygon.first;
+    const auto* lon = m_longitudes.data() + polygon.first;
+    bool inside = false;
+    for(qsizetype i=0, j=polygon.count-1; i<polygon.count; j=i++)
+    {
+        if ((lat[i] > latitude) != (lat[j] > latitude))
+        {
+            auto const crossing = lon[i] + (latitude - lat[i])*(lon[j] - lon[i])/(lat[j] - lat[i]);
+            if (longitude < crossing)
+            {
+                inside = !inside;
+            }
+        }
+    }
+    return inside;
+}
+
+
+QList<Navigation::AirspaceCrossing> Navigation::AirspaceIndex::crossings(const QList<QGeoCoordinate>& path) const
+{
+    QList<Navigation::AirspaceCrossing> result;
+
+    std::vector<PlanePoint> points;
+    std::vector<double> distances;
+    std::vector<qsizetype> candidates;
+    std::vector<double> parameters;
+
+    double routeDistanceInM = 0.0;
+    for(qsizetype leg=0; leg<path.size()-1; leg++)
+    {
+        const auto& start = path[leg];
+        const auto& end = path[leg+1];
+        if (!start.isValid() || !end.isValid())
+        {
+            continue;
+        }
+        auto const legLengthInM = start.distanceTo(end);
+        auto const azimuth = start.azimuthTo(end);
+
+        // Approximate leg by pieces of at most maxPieceLengthInM. The
+        // distances are measured from the start of the route.
+        auto const numPieces = qMax(1, static_cast<int>(std::ceil(legLengthInM/maxPieceLengthInM)));
+        points.clear();
+        distances.clear();
+        for(int i=0; i<=numPieces; i++)
+        {
+            auto const distanceInM = legLengthInM*i/numPieces;
+            auto const point = (i == numPieces) ? end : start.atDistanceAndAzimuth(distanceInM, azimuth);
+            points.push_back({point.latitude(), point.longitude()});
+            distances.push_back(routeDistanceInM + distanceInM);
+        }
+
+        // Find candidate airspaces, using the grid cells of the pieces
+        candidates.clear();
+        for(int i=0; i<numPieces; i++)
+        {
+            auto const minLatitude = qMin(points[i].latitude, points[i+1].latitude);
+            auto const maxLatitude = qMax(points[i].latitude, points[i+1].latitude);
+            auto const minLongitude = qMin(points[i].longitude, points[i+1].longitude);
+            auto const maxLongitude = qMax(points[i].longitude, points[i+1].longitude);
+            for(auto latitude = std::floor(minLatitude/cellSizeInDEG)*cellSizeInDEG; latitude <= maxLatitude; latitude += cellSizeInDEG)
+            {
+                for(auto longitude = std::floor(minLongitude/cellSizeInDEG)*cellSizeInDEG; longitude <= maxLongitude; longitude += cellSizeInDEG)
+                {
+                    auto const cell = m_cells.constFind(cellKey(latitude + cellSizeInDEG/2.0, longitude + cellSizeInDEG/2.0));
+                    if (cell == m_cells.constEnd())
+                    {
+                        continue;
+                    }
+                    candidates.insert(candidates.end(), cell->begin(), cell->end());
+                }
+            }
+        }
+
+        // Airspaces can be listed in several cells. The candidate list of one
+        // leg is small, so sorting it is cheaper than marking the whole index.
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+        // Point on the leg, at a given distance from the start of the route
+        auto pointAt = [&](double distanceInM) {
+            auto const piece = qBound(qsizetype(0), static_cast<qsizetype>(std::upper_bound(distances.begin(), distances.end(), distanceInM) - distances.begin()) - 1, static_cast<qsizetype>(numPieces-1));
+            auto const length = distances[piece+1] - distances[piece];
+            auto const t = (length > 0.0) ? (distanceInM - distances[piece])/length : 0.0;
+            return PlanePoint {points[piece].latitude + t*(points[piece+1].latitude - points[piece].latitude),
+                              points[piece].longitude + t*(points[piece+1].longitude - points[piece].longitude)};
+        };
+
+        for(auto index : candidates)
+        {
+            const auto& polygon = m_polygons[index];
+            const auto* lat = m_latitudes.data() + polygon.first;
+            const auto* lon = m_longitudes.data() + polygon.first;
+
+            // Intersect pieces with the edges of the polygon
+            parameters.clear();
+            for(int i=0; i<numPieces; i++)
+            {
+                auto const a0 = points[i];
+                auto const a1 = points[i+1];
+                if ((qMax(a0.latitude, a1.latitude) < polygon.minLatitude) || (qMin(a0.latitude, a1.latitude) > polygon.maxLatitude)
+                    || (qMax(a0.longitude, a1.longitude) < polygon.minLongitude) || (qMin(a0.longitude, a1.longitude) > polygon.maxLongitude))
+                {
+                    continue;
+                }
+                for(qsizetype k=0, j=polygon.count-1; k<polygon.count; j=k++)
+                {
+                    auto const u = intersect(a0, a1, {lat[j], lon[j]}, {lat[k], lon[k]});
+                    if (!std::isnan(u))
+                    {
+                        parameters.push_back(distances[i] + u*(distances[i+1]-distances[i]));
+                    }
+                }
+            }
+            parameters.push_back(distances.front());
+            parameters.push_back(distances.back());
+            std::sort(parameters.begin(), parameters.end());
+            parameters.erase(std::unique(parameters.begin(), parameters.end()), parameters.end());
+
+            // Decide for every interval between two crossings whether it lies
+            // inside, by looking at its midpoint. This is robust against
+            // tangencies and against crossings at vertices. Consecutive
+            // intervals inside are merged.
+            double entryInM = qQNaN();
+            for(std::size_t i=0; i+1<parameters.size(); i++)
+            {
+                auto const mid = pointAt((parameters[i] + parameters[i+1])/2.0);
+                auto const inside = contains(polygon, mid.latitude, mid.longitude);
+                if (inside && std::isnan(entryInM))
+                {
+                    entryInM = parameters[i];
+                }
+                auto const isLast = (i+2 == parameters.size());
+                if (!std::isnan(entryInM) && (!inside || isLast))
+                {
+                    auto const exitInM = inside ? parameters[i+1] : parameters[i];
+                    auto const entryPoint = pointAt(entryInM);
+                    auto const exitPoint = pointAt(exitInM);
+                    result.append(Navigation::AirspaceCrossing(m_airspaces[index],
+                                                               leg,
+                                                               QGeoCoordinate(entryPoint.latitude, entryPoint.longitude),
+                                                               QGeoCoordinate(exitPoint.latitude, exitPoint.longitude),
+                                                               Units::Distance::fromM(entryInM),
+                                                               Units::Distance::fromM(exitInM)));
+                    entryInM = qQNaN();
+                }
+            }
+        }
+
+        // Order the crossings of this leg by entry
+        auto const firstOfLeg = std::find_if(result.begin(), result.end(), [leg](const auto& crossing) { return crossing.leg() == leg; });
+        std::stable_sort(firstOfLeg, result.end(), [](const auto& first, const auto& second) { return first.entryDistance() < second.entryDistance(); });
+
+        routeDistanceInM += legLengthInM;
+    }
+
+    return result;
+}
@@ -0,0 +1,249 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <QGeoCoordinate>
+#include <QHash>
+#include <QQmlEngine>
+#include <vector>
+
+#include "geomaps/Airspace.h"
+#include "units/Distance.h"
+
+
+namespace Navigation {
+
+/*! \brief Part of a flight route that lies inside an airspace
+ *
+ *  This class describes one passage of a leg of a flight route through the
+ *  lateral limits of an airspace. If a leg enters the same airspace several
+ *  times, there is one passage per entry.
+ */
+
+class AirspaceCrossing {
+    Q_GADGET
+    QML_VALUE_TYPE(airspaceCrossing)
+
+public:
+    /*! \brief Constructs an invalid crossing */
+    AirspaceCrossing() = default;
+
+    /*! \brief Constructs a crossing
+     *
+     *  @param airspace Airspace
+     *
+     *  @param leg Index of the leg
+     *
+     *  @param entry Point where the leg enters the airspace
+     *
+     *  @param exit Point where the leg leaves the airspace
+     *
+     *  @param entryDistance Distance from the start of the route to the entry
+     *
+     *  @param exitDistance Distance from the start of the route to the exit
+     */
+    AirspaceCrossing(GeoMaps::Airspace airspace, qsizetype leg, const QGeoCoordinate& entry, const QGeoCoordinate& exit, Units::Distance entryDistance, Units::Distance exitDistance);
+
+
+    //
+    // PROPERTIES
+    //
+
+    /*! \brief Airspace, including category and vertical limits */
+    Q_PROPERTY(GeoMaps::Airspace airspace READ airspace CONSTANT)
+
+    /*! \brief Point where the leg enters the airspace
+     *
+     *  If the leg starts inside the airspace, this is the start point of the
+     *  leg.
+     */
+    Q_PROPERTY(QGeoCoordinate entry READ entry CONSTANT)
+
+    /*! \brief Distance from the start of the route to the entry */
+    Q_PROPERTY(Units::Distance entryDistance READ entryDistance CONSTANT)
+
+    /*! \brief Point where the leg leaves the airspace
+     *
+     *  If the leg ends inside the airspace, this is the end point of the
+     *  leg.
+     */
+    Q_PROPERTY(QGeoCoordinate exit READ exit CONSTANT)
+
+    /*! \brief Distance from the start of the route to the exit */
+    Q_PROPERTY(Units::Distance exitDistance READ exitDistance CONSTANT)
+
+    /*! \brief Index of the leg */
+    Q_PROPERTY(qsizetype leg READ leg CONSTANT)
+
+
+    //
+    // Getter Methods
+    //
+
+    /*! \brief Getter function for property with the same name
+     *
+     *  @returns Property airspace
+     */
+    [[nodiscard]] auto airspace() const -> GeoMaps::Airspace { return m_airspace; }
+
+    /*! \brief Getter function for property with the same name
+     *
+     *  @returns Property entry
+     */
+    [[nodiscard]] auto entry() const -> QGeoCoordinate { return m_entry; }
+
+    /*! \brief Getter function for property with the same name
+     *
+     *  @returns Property entryDistance
+     */
+    [[nodiscard]] auto entryDistance() const -> Units::Distance { return m_entryDistance; }
+
+    /*! \brief Getter function for property with the same name
+     *
+     *  @returns Property exit
+     */
+    [[nodiscard]] auto exit() const -> QGeoCoordinate { return m_exit; }
+
+    /*! \brief Getter function for property with the same name
+     *
+     *  @returns Property exitDistance
+     */
+    [[nodiscard]] auto exitDistance() const -> Units::Distance { return m_exitDistance; }
+
+    /*! \brief Getter function for property with the same name
+     *
+     *  @returns Property leg
+     */
+    [[nodiscard]] auto leg() const -> qsizetype { return m_leg; }
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Equality check
+     *
+     *  @param other Crossing that is compared to this
+     *
+     *  @result equality
+     */
+    [[nodiscard]] bool operator==(const Navigation::AirspaceCrossing& other) const = default;
+
+private:
+    GeoMaps::Airspace m_airspace;
+    qsizetype m_leg {-1};
+    QGeoCoordinate m_entry;
+    QGeoCoordinate m_exit;
+    Units::Distance m_entryDistance;
+    Units::Distance m_exitDistance;
+};
+
+
+/*! \brief Spatial index of airspaces, for intersection with flight routes
+ *
+ *  The constructor copies the vertices of all airspace polygons into
+ *  contiguous arrays, computes bounding boxes and sorts the airspaces into the
+ *  cells of a latitude/longitude grid. Construction takes time linear in the
+ *  total number of vertices; it is meant to be done once, whenever the
+ *  aviation data changes.
+ *
+ *  crossings() only looks at airspaces whose cells and bounding boxes meet
+ *  the route, so that its cost depends on the length of the route and on the
+ *  density of airspaces along the route, but not on the total number of
+ *  airspaces.
+ *
+ *  Legs are treated as great circles, approximated by pieces of at most
+ *  maxPieceLengthInM. Pieces and airspace boundaries are intersected exactly,
+ *  in the latitude/longitude plane that QGeoPolygon::contains() also uses.
+ *  Airspaces that cross the antimeridian are not supported.
+ *
+ *  The methods of this class are reentrant. Const methods are thread safe, so
+ *  that one index can be shared between threads.
+ */
+
+class AirspaceIndex
+{
+public:
+    /*! \brief Construct index
+     *
+     *  @param airspaces Airspaces. Invalid airspaces are ignored.
+     */
+    explicit AirspaceIndex(const QList<GeoMaps::Airspace>& airspaces);
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Intersect flight route with airspaces
+     *
+     *  @param path Waypoints of the flight route, as returned by
+     *  FlightRoute::geoPath()
+     *
+     *  @returns Passages of the legs through the airspaces, ordered by leg
+     *  and, within each leg, by entry distance
+     */
+    [[nodiscard]] QList<Navigation::AirspaceCrossing> crossings(const QList<QGeoCoordinate>& path) const;
+
+
+    //
+    // Constants
+    //
+
+    /*! \brief Size of the grid cells */
+    static constexpr double cellSizeInDEG = 1.0;
+
+    /*! \brief Maximal length of the pieces that approximate a leg */
+    static constexpr double maxPieceLengthInM = 5000.0;
+
+private:
+    // Lateral limits of an airspace. The vertices are stored in m_latitudes
+    // and m_longitudes, starting at index first.
+    struct Polygon
+    {
+        qsizetype first {0};
+        qsizetype count {0};
+        double minLatitude {0.0};
+        double maxLatitude {0.0};
+        double minLongitude {0.0};
+        double maxLongitude {0.0};
+    };
+
+    // Returns the key of the grid cell
+    [[nodiscard]] static quint64 cellKey(double latitude, double longitude);
+
+    // Checks if a point lies inside a polygon, by ray casting
+    [[nodiscard]] bool contains(const Polygon& polygon, double latitude, double longitude) const;
+
+    QList<GeoMaps::Airspace> m_airspaces;
+    std::vector<Polygon> m_polygons;
+    std::vector<double> m_latitudes;
+    std::vector<double> m_longitudes;
+
+    // Airspace indices, by cell key
+    QHash<quint64, std::vector<qsizetype>> m_cells;
+};
+
+} // namespace Navigation
+
+// Declare meta types
+Q_DECLARE_METATYPE(Navigation::AirspaceCrossing)
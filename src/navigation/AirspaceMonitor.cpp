@@ -0,0 +1,153 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include <QDateTime>
+#include <cmath>
+
+#include "navigation/AirspaceMonitor.h"
+
+
+//
+// Methods
+//
+
+bool Navigation::AirspaceMonitor::isMonitored(const QString& CAT)
+{
+    static const QStringList monitoredCategories = {u"A"_qs, u"B"_qs, u"C"_qs, u"D"_qs, u"CTR"_qs, u"R"_qs, u"P"_qs, u"DNG"_qs};
+    return monitoredCategories.contains(CAT);
+}
+
+
+auto Navigation::AirspaceMonitor::predict(const Positioning::PositionInfo& info, const AirspaceIndex& index, double horizonInS) -> QList<Warning>
+{
+    auto const groundSpeedInMPS = info.groundSpeed().toMPS();
+    auto const track = info.trueTrack();
+    if (!std::isfinite(groundSpeedInMPS) || (groundSpeedInMPS < minGroundSpeedInMPS) || !track.isFinite())
+    {
+        return {};
+    }
+
+    auto start = info.coordinate();
+    start.setAltitude(qQNaN());
+    auto const end = start.atDistanceAndAzimuth(groundSpeedInMPS*horizonInS, track.toDEG());
+
+    // Predicted altitude a(t) = altitudeInM + verticalSpeedInMPS*t. If the
+    // altitude is unknown, airspaces are checked laterally only.
+    auto const altitudeInM = info.trueAltitudeAMSL().toM();
+    auto verticalSpeedInMPS = info.verticalSpeed().toMPS();
+    if (!std::isfinite(verticalSpeedInMPS))
+    {
+        verticalSpeedInMPS = 0.0;
+    }
+
+    QList<Warning> result;
+    foreach(auto crossing, index.crossings({start, end}))
+    {
+        const auto& airspace = crossing.airspace();
+        if (!isMonitored(airspace.CAT()))
+        {
+            continue;
+        }
+
+        // Times at which the path is laterally inside the airspace
+        auto entryInS = crossing.entryDistance().toM()/groundSpeedInMPS;
+        auto exitInS = crossing.exitDistance().toM()/groundSpeedInMPS;
+
+        // Restrict to times at which the predicted altitude lies between the
+        // vertical limits
+        if (std::isfinite(altitudeInM))
+        {
+            auto const lowerInM = airspace.estimatedLowerBoundMSL().toM();
+            auto const upperInM = airspace.estimatedUpperBoundMSL().toM();
+            if (verticalSpeedInMPS == 0.0)
+            {
+                if ((altitudeInM < lowerInM) || (altitudeInM > upperInM))
+                {
+                    continue;
+                }
+            }
+            else
+            {
+                auto const lowerInS = (lowerInM - altitudeInM)/verticalSpeedInMPS;
+                auto const upperInS = (upperInM - altitudeInM)/verticalSpeedInMPS;
+                entryInS = qMax(entryInS, qMin(lowerInS, upperInS));
+                exitInS = qMin(exitInS, qMax(lowerInS, upperInS));
+            }
+        }
+        if (entryInS > exitInS)
+        {
+            continue;
+        }
+
+        // Airspaces that the aircraft is already in are not entered
+        if (entryInS <= 0.0)
+        {
+            continue;
+        }
+        result.append({airspace, Units::Timespan::fromS(entryInS)});
+    }
+
+    std::sort(result.begin(), result.end(), [](const Warning& first, const Warning& second) { return first.timeToEntry < second.timeToEntry; });
+    return result;
+}
+
+
+bool Navigation::AirspaceMonitor::update(const Positioning::PositionInfo& info, const std::shared_ptr<const AirspaceIndex>& index)
+{
+    auto const timestamp = info.timestamp();
+    auto const nowInMS = timestamp.isValid() ? timestamp.toMSecsSinceEpoch() : QDateTime::currentMSecsSinceEpoch();
+
+    QList<Warning> predictions;
+    if (info.isValid() && (index != nullptr))
+    {
+        predictions = predict(info, *index, lookaheadInS + hysteresisInS);
+    }
+
+    // Keep the existing warning while it is confirmed, or for holdTimeInMS
+    // after it was last confirmed
+    if (m_warning.airspace.isValid())
+    {
+        foreach(auto prediction, predictions)
+        {
+            if (prediction.airspace == m_warning.airspace)
+            {
+                m_warning.timeToEntry = prediction.timeToEntry;
+                m_lastConfirmedInMS = nowInMS;
+                return false;
+            }
+        }
+        if (nowInMS - m_lastConfirmedInMS < holdTimeInMS)
+        {
+            return false;
+        }
+    }
+
+    // Raise new warning, or clear
+    Warning newWarning;
+    if (!predictions.isEmpty() && (predictions.constFirst().timeToEntry.toS() <= lookaheadInS))
+    {
+        newWarning = predictions.constFirst();
+    }
+    auto const changed = !(newWarning.airspace == m_warning.airspace);
+    m_warning = newWarning;
+    m_lastConfirmedInMS = nowInMS;
+    return changed;
+}
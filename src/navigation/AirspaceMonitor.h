@@ -0,0 +1,127 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <memory>
+
+#include "navigation/AirspaceCrossing.h"
+#include "positioning/PositionInfo.h"
+#include "units/Timespan.h"
+
+
+namespace Navigation {
+
+/*! \brief Predicts entries of the own aircraft into airspaces
+ *
+ *  This class extrapolates the current position, track, ground speed and
+ *  vertical speed of the own aircraft over the next lookaheadInS seconds,
+ *  intersects the predicted path with controlled and restricted airspaces and
+ *  reports the airspace that will be entered first.
+ *
+ *  Lateral intersections are computed with an AirspaceIndex, so that an update
+ *  only looks at airspaces near the predicted path and is cheap enough to run
+ *  on every position update. Vertically, the predicted altitude is compared
+ *  with Airspace::estimatedLowerBoundMSL() and
+ *  Airspace::estimatedUpperBoundMSL().
+ *
+ *  To avoid warnings that flicker on and off, the warning is subject to
+ *  hysteresis. A warning is raised only if the entry is predicted within
+ *  lookaheadInS. Once raised, it stays on as long as the entry is predicted
+ *  within lookaheadInS + hysteresisInS, and for another holdTimeInMS after
+ *  the prediction has vanished.
+ */
+
+class AirspaceMonitor
+{
+public:
+    /*! \brief Predicted entry into an airspace */
+    struct Warning
+    {
+        /*! \brief Airspace. The airspace is invalid if there is no warning. */
+        GeoMaps::Airspace airspace;
+
+        /*! \brief Predicted time until entry */
+        Units::Timespan timeToEntry;
+    };
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Check if an airspace category is monitored
+     *
+     *  @param CAT Airspace category, see GeoMaps::Airspace::CAT()
+     *
+     *  @returns True for controlled airspaces of classes A to D, for control
+     *  zones and for restricted, prohibited and danger areas
+     */
+    [[nodiscard]] static bool isMonitored(const QString& CAT);
+
+    /*! \brief Update prediction
+     *
+     *  @param info Position of the own aircraft. If the position is invalid
+     *  or if the ground speed is below minGroundSpeedInMPS, no entry is
+     *  predicted.
+     *
+     *  @param index Airspaces. If nullptr, no entry is predicted.
+     *
+     *  @returns True if the warning has been raised, cleared, or now refers
+     *  to a different airspace. Updates of timeToEntry alone do not count.
+     */
+    bool update(const Positioning::PositionInfo& info, const std::shared_ptr<const AirspaceIndex>& index);
+
+    /*! \brief Current warning
+     *
+     *  @returns Current warning. The airspace member is invalid if there is
+     *  no warning.
+     */
+    [[nodiscard]] auto warning() const -> const Warning& { return m_warning; }
+
+
+    //
+    // Constants
+    //
+
+    /*! \brief Prediction time for new warnings */
+    static constexpr double lookaheadInS = 300.0;
+
+    /*! \brief Additional prediction time for existing warnings */
+    static constexpr double hysteresisInS = 60.0;
+
+    /*! \brief Time that an existing warning is kept after its prediction vanished */
+    static constexpr qint64 holdTimeInMS = 10000;
+
+    /*! \brief Minimal ground speed for predictions */
+    static constexpr double minGroundSpeedInMPS = 15.0;
+
+private:
+    // Predicted entries within horizonInS, earliest first
+    [[nodiscard]] static QList<Warning> predict(const Positioning::PositionInfo& info, const AirspaceIndex& index, double horizonInS);
+
+    Warning m_warning;
+
+    // Time at which the entry into m_warning.airspace was last predicted
+    qint64 m_lastConfirmedInMS {0};
+};
+
+} // namespace Navigation
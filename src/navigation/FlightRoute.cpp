@@ -27,6 +27,7 @@
 #include "geomaps/GeoMapProvider.h"
 #include "geomaps/GPX.h"
 #include "navigation/Navigator.h"
+#include "navigation/RouteOptimizer.h"
 
 
 //
@@ -39,6 +40,9 @@ Navigation::FlightRoute::FlightRoute(QObject *parent)
     connect(this, &FlightRoute::waypointsChanged, this, &Navigation::FlightRoute::summaryChanged);
     connect(GlobalObject::navigator(), &Navigation::Navigator::aircraftChanged, this, &Navigation::FlightRoute::summaryChanged);
     connect(GlobalObject::navigator(), &Navigation::Navigator::windChanged, this, &Navigation::FlightRoute::summaryChanged);
+    connect(GlobalObject::navigator(), &Navigation::Navigator::cruiseAltitudeChanged, this, &Navigation::FlightRoute::summaryChanged);
+    connect(GlobalObject::navigator(), &Navigation::Navigator::windFieldChanged, this, &Navigation::FlightRoute::updateWindField);
+    m_performance.setWindField(GlobalObject::navigator()->windField());
 
     // Setup Bindings
     m_geoPath.setBinding([this]() {return this->computeGeoPath();});
@@ -122,13 +126,15 @@ auto Navigation::FlightRoute::summary() const -> QString
     auto time = Units::Timespan::fromS(0.0);
     auto fuel = Units::Volume::fromL(0.0);
 
-    for(const auto& _leg : m_legs)
+    const auto cruiseAltitude = GlobalObject::navigator()->cruiseAltitude();
+    auto const performance = m_performance.compute(aircraft, wind, cruiseAltitude);
+    for(qsizetype i=0; i<m_legs.size(); i++)
     {
-        dist += _leg.distance();
+        dist += m_legs[i].distance();
         if (dist.toM() > 100)
         {
-            time += _leg.ETE(wind, aircraft);
-            fuel += _leg.Fuel(wind, aircraft);
+            time += performance[i].ETE;
+            fuel += performance[i].fuel;
         }
     }
     if (!dist.isFinite()) {
@@ -156,11 +162,18 @@ auto Navigation::FlightRoute::summary() const -> QString
     {
         complaints += tr("Fuel consumption not specified.");
     }
-    if (!wind.speed().isFinite())
+    // The estimated wind is not needed if winds aloft are known along the
+    // whole route. Winds aloft are only used with a cruise altitude.
+    if (GlobalObject::navigator()->hasWindField() && !cruiseAltitude.isFinite())
+    {
+        complaints += tr("Cruise altitude not specified.");
+    }
+    auto const windFieldUsed = cruiseAltitude.isFinite() && m_performance.windFieldCoversRoute();
+    if (!wind.speed().isFinite() && !windFieldUsed)
     {
         complaints += tr("Wind speed not specified.");
     }
-    if (!wind.directionFrom().isFinite())
+    if (!wind.directionFrom().isFinite() && !windFieldUsed)
     {
         complaints += tr("Wind direction not specified.");
     }
@@ -252,33 +265,9 @@ void Navigation::FlightRoute::insert(const GeoMaps::Waypoint& waypoint)
         return;
     }
 
-    int shortestIndex = 0;
-    double shortestRoute = 10e9;
+    auto const shortestIndex = RouteOptimizer::bestInsertion(m_legs, waypoint.coordinate());
 
     auto newWaypoints = m_waypoints.value();
-    for(int idx=0; idx<newWaypoints.size()-1;  idx++)
-    {
-        double routeSize = 0.0;
-        for(int i=0; i<newWaypoints.size()-1; i++)
-        {
-            if (i == idx)
-            {
-                routeSize += newWaypoints[i].coordinate().distanceTo(waypoint.coordinate());
-                routeSize += waypoint.coordinate().distanceTo(newWaypoints[i+1].coordinate());
-            }
-            else
-            {
-                routeSize += newWaypoints[i].coordinate().distanceTo(newWaypoints[i+1].coordinate());
-            }
-        }
-
-        if (routeSize < shortestRoute)
-        {
-            shortestRoute = routeSize;
-            shortestIndex = idx;
-        }
-    }
-
     newWaypoints.insert(shortestIndex+1, waypoint);
     m_waypoints = newWaypoints;
     updateLegs();
@@ -325,26 +314,16 @@ auto Navigation::FlightRoute::load(const QString& fileName) -> QString
         return tr("The file '%1' contains too many waypoints. Flight routes with more than 100 waypoints are not supported.").arg(myFileName);
     }
 
-    QVector<GeoMaps::Waypoint> newWaypoints;
+    // Snap waypoints to nearby airfields, navaids, etc.
+    QList<GeoMaps::Waypoint> validWaypoints;
     foreach(auto waypoint, result)
     {
-        if (!waypoint.isValid())
-        {
-            continue;
-        }
-
-        auto pos = waypoint.coordinate();
-        auto distPos = pos.atDistanceAndAzimuth(1000.0, 0.0, 0.0);
-        auto nearest = GlobalObject::geoMapProvider()->closestWaypoint(pos, distPos);
-        if (nearest.type() == u"WP")
-        {
-            newWaypoints << waypoint;
-        }
-        else
+        if (waypoint.isValid())
         {
-            newWaypoints << nearest;
+            validWaypoints << waypoint;
         }
     }
+    auto const newWaypoints = GlobalObject::geoMapProvider()->snapToWaypoints(validWaypoints, Units::Distance::fromM(1000.0));
     m_waypoints = newWaypoints;
 
     updateLegs();
@@ -424,6 +403,40 @@ void Navigation::FlightRoute::replaceWaypoint(int idx, const GeoMaps::Waypoint&
     emit waypointsChanged();
 }
 
+void Navigation::FlightRoute::optimize()
+{
+    auto const oldWaypoints = m_waypoints.value();
+    if (oldWaypoints.size() < 4)
+    {
+        return;
+    }
+
+    QList<QGeoCoordinate> coordinates;
+    foreach(const auto& waypoint, oldWaypoints)
+    {
+        if (!waypoint.isValid())
+        {
+            return;
+        }
+        coordinates << waypoint.coordinate();
+    }
+
+    auto const order = RouteOptimizer::optimizedOrder(coordinates);
+    QVector<GeoMaps::Waypoint> newWaypoints;
+    newWaypoints.reserve(oldWaypoints.size());
+    foreach(auto index, order)
+    {
+        newWaypoints << oldWaypoints[index];
+    }
+    if (newWaypoints == oldWaypoints)
+    {
+        return;
+    }
+    m_waypoints = newWaypoints;
+    updateLegs();
+    emit waypointsChanged();
+}
+
 void Navigation::FlightRoute::reverse()
 {
     QVector<GeoMaps::Waypoint> newWaypoints = m_waypoints.value();
@@ -559,5 +572,13 @@ void Navigation::FlightRoute::updateLegs()
     {
         m_legs.append(Leg(m_waypoints.value().at(i), m_waypoints.value().at(i+1)));
     }
+    m_performance.setRoute(m_legs);
+}
+
+
+void Navigation::FlightRoute::updateWindField()
+{
+    m_performance.setWindField(GlobalObject::navigator()->windField());
+    emit summaryChanged();
 }
 
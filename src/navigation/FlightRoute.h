@@ -31,6 +31,7 @@
 
 #include "geomaps/Waypoint.h"
 #include "navigation/Leg.h"
+#include "navigation/RoutePerformance.h"
 
 namespace GeoMaps
 {
@@ -118,8 +119,8 @@ namespace Navigation
          *  This is a string of the form "48 nm · 0:28 h · 1,9 gal", potentially
          *  with HTML complaints if wind or aircraft data was missing.
          *
-         *  The summary is computed for the aircraft and wind that are presently
-         *  set in the global Navigator class.
+         *  The summary is computed for the aircraft, wind, cruise altitude and
+         *  winds aloft that are presently set in the global Navigator class.
          */
         Q_PROPERTY(QString summary READ summary NOTIFY summaryChanged)
 
@@ -296,6 +297,18 @@ namespace Navigation
          */
         Q_INVOKABLE void replaceWaypoint(int idx, const GeoMaps::Waypoint& newWaypoint);
 
+        /*! \brief Reorder the route to make it shorter
+         *
+         *  This method reorders the intermediate waypoints of the route, so
+         *  that the total route length gets shorter.  Departure and
+         *  destination are kept.  This is useful for long cross-country tasks
+         *  that are built from many turnpoints, see
+         *  RouteOptimizer::optimizedOrder() for details.  If the route has
+         *  fewer than four waypoints, or contains invalid waypoints, this
+         *  method does nothing.
+         */
+        Q_INVOKABLE void optimize();
+
         /*! \brief Reverse the route */
         Q_INVOKABLE void reverse();
 
@@ -352,6 +365,9 @@ namespace Navigation
     private slots:
         void updateLegs();
 
+        // Hands the wind field of the Navigator to m_performance
+        void updateWindField();
+
     private:
         Q_DISABLE_COPY_MOVE(FlightRoute)
 
@@ -366,6 +382,12 @@ namespace Navigation
 
         QVector<Leg> m_legs;
 
+        // Performance engine for the summary. Caches the route geometry and
+        // the wind field lookups. The route is set in updateLegs(), the wind
+        // field in updateWindField(). It is mutable because compute() updates
+        // the cache.
+        mutable RoutePerformance m_performance;
+
         QLocale myLocale;
     };
 
@@ -0,0 +1,412 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include "navigation/Geodesy.h"
+
+
+namespace {
+
+constexpr double degreesToRadians = M_PI/180.0;
+constexpr double radiansToDegrees = 180.0/M_PI;
+
+// Converts a squared chord length on the unit sphere into a distance
+double distanceFromSquaredChord(double squaredChord)
+{
+    return 2.0*Navigation::Geodesy::earthRadiusInM*std::asin(qMin(1.0, std::sqrt(squaredChord)/2.0));
+}
+
+// Combines row and column of a grid cell into a key
+quint64 cellKey(qint64 row, qint64 column)
+{
+    return (static_cast<quint64>(row) << 32U) | static_cast<quint64>(column);
+}
+
+// Replaces NaN, which results from invalid coordinates, by infinity, so that
+// invalid points come last when sorting by distance
+void sanitize(std::vector<double>& squaredChords)
+{
+    for(auto& squaredChord : squaredChords)
+    {
+        if (std::isnan(squaredChord))
+        {
+            squaredChord = std::numeric_limits<double>::infinity();
+        }
+    }
+}
+
+} // namespace
+
+
+//
+// Point
+//
+
+Navigation::Geodesy::Point::Point(const QGeoCoordinate& coordinate)
+    : latitude(coordinate.latitude()*degreesToRadians),
+      longitude(coordinate.longitude()*degreesToRadians),
+      sinLatitude(std::sin(latitude)),
+      cosLatitude(std::cos(latitude)),
+      sinLongitude(std::sin(longitude)),
+      cosLongitude(std::cos(longitude)),
+      x(cosLatitude*cosLongitude),
+      y(cosLatitude*sinLongitude),
+      z(sinLatitude)
+{
+}
+
+
+//
+// PointArray
+//
+
+void Navigation::Geodesy::PointArray::append(const QGeoCoordinate& coordinate)
+{
+    Point const point(coordinate);
+    m_x.push_back(point.x);
+    m_y.push_back(point.y);
+    m_z.push_back(point.z);
+}
+
+
+void Navigation::Geodesy::PointArray::azimuths(const Point& origin, double* resultInDEG) const
+{
+    // Local east and north directions at the origin
+    auto const eastX = -origin.sinLongitude;
+    auto const eastY = origin.cosLongitude;
+    auto const northX = -origin.sinLatitude*origin.cosLongitude;
+    auto const northY = -origin.sinLatitude*origin.sinLongitude;
+    auto const northZ = origin.cosLatitude;
+
+    auto const count = m_x.size();
+    const auto* px = m_x.data();
+    const auto* py = m_y.data();
+    const auto* pz = m_z.data();
+    for(std::size_t i=0; i<count; i++)
+    {
+        auto const east = eastX*px[i] + eastY*py[i];
+        auto const north = northX*px[i] + northY*py[i] + northZ*pz[i];
+        auto const azimuth = std::atan2(east, north)*radiansToDegrees;
+        resultInDEG[i] = (azimuth < 0.0) ? azimuth + 360.0 : azimuth;
+    }
+}
+
+
+void Navigation::Geodesy::PointArray::clear()
+{
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+}
+
+
+void Navigation::Geodesy::PointArray::distances(const Point& origin, double* resultInM) const
+{
+    squaredChords(origin, resultInM);
+    auto const count = m_x.size();
+    for(std::size_t i=0; i<count; i++)
+    {
+        resultInM[i] = distanceFromSquaredChord(resultInM[i]);
+    }
+}
+
+
+qsizetype Navigation::Geodesy::PointArray::nearest(const Point& origin) const
+{
+    if (m_x.empty())
+    {
+        return -1;
+    }
+    std::vector<double> chords(m_x.size());
+    squaredChords(origin, chords.data());
+    sanitize(chords);
+    return std::distance(chords.cbegin(), std::min_element(chords.cbegin(), chords.cend()));
+}
+
+
+std::vector<qsizetype> Navigation::Geodesy::PointArray::nearestIndices(const Point& origin, qsizetype count) const
+{
+    std::vector<double> chords(m_x.size());
+    squaredChords(origin, chords.data());
+    sanitize(chords);
+
+    std::vector<qsizetype> result(m_x.size());
+    std::iota(result.begin(), result.end(), 0);
+    auto const middle = result.begin() + qBound(static_cast<qsizetype>(0), count, size());
+    std::partial_sort(result.begin(), middle, result.end(),
+                      [&chords](qsizetype first, qsizetype second) { return chords[first] < chords[second]; });
+    result.erase(middle, result.end());
+    return result;
+}
+
+
+void Navigation::Geodesy::PointArray::reserve(qsizetype size)
+{
+    m_x.reserve(static_cast<std::size_t>(size));
+    m_y.reserve(static_cast<std::size_t>(size));
+    m_z.reserve(static_cast<std::size_t>(size));
+}
+
+
+void Navigation::Geodesy::PointArray::squaredChords(const Point& origin, double* result) const
+{
+    auto const count = m_x.size();
+    const auto* px = m_x.data();
+    const auto* py = m_y.data();
+    const auto* pz = m_z.data();
+    for(std::size_t i=0; i<count; i++)
+    {
+        auto const dx = px[i] - origin.x;
+        auto const dy = py[i] - origin.y;
+        auto const dz = pz[i] - origin.z;
+        result[i] = dx*dx + dy*dy + dz*dz;
+    }
+}
+
+
+//
+// ProximityGrid
+//
+
+Navigation::Geodesy::ProximityGrid::ProximityGrid(double radiusInM)
+    : m_radiusInM(radiusInM)
+{
+    auto const radiusInDEG = qBound(1.0e-6, radiusInM/earthRadiusInM*radiansToDegrees, 360.0);
+    m_columns = qMax(static_cast<qint64>(1), static_cast<qint64>(std::floor(360.0/radiusInDEG)));
+    m_cellSizeInDEG = 360.0/static_cast<double>(m_columns);
+}
+
+
+qint64 Navigation::Geodesy::ProximityGrid::cellIndex(double degrees) const
+{
+    return static_cast<qint64>(std::floor(degrees/m_cellSizeInDEG));
+}
+
+
+bool Navigation::Geodesy::ProximityGrid::containsNear(const QGeoCoordinate& coordinate) const
+{
+    if (!coordinate.isValid() || m_cells.isEmpty())
+    {
+        return false;
+    }
+
+    for(auto key : neighbourhood(coordinate))
+    {
+        auto const it = m_cells.constFind(key);
+        if (it == m_cells.constEnd())
+        {
+            continue;
+        }
+        for(const auto& entry : *it)
+        {
+            if (isCloserThan(coordinate, entry.coordinate, m_radiusInM))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+
+void Navigation::Geodesy::ProximityGrid::insert(const QGeoCoordinate& coordinate)
+{
+    auto const index = m_count++;
+    if (!coordinate.isValid())
+    {
+        return;
+    }
+    auto const row = cellIndex(coordinate.latitude() + 90.0);
+    auto const column = cellIndex(coordinate.longitude() + 180.0) % m_columns;
+    m_cells[cellKey(row, column)].append({coordinate, index});
+}
+
+
+qsizetype Navigation::Geodesy::ProximityGrid::nearest(const QGeoCoordinate& coordinate) const
+{
+    if (!coordinate.isValid() || m_cells.isEmpty())
+    {
+        return -1;
+    }
+
+    qsizetype result = -1;
+    auto shortestDistance = m_radiusInM;
+    for(auto key : neighbourhood(coordinate))
+    {
+        auto const it = m_cells.constFind(key);
+        if (it == m_cells.constEnd())
+        {
+            continue;
+        }
+        for(const auto& entry : *it)
+        {
+            auto const distance = coordinate.distanceTo(entry.coordinate);
+            if ((distance < shortestDistance) || ((distance == shortestDistance) && ((result < 0) || (entry.index < result))))
+            {
+                shortestDistance = distance;
+                result = entry.index;
+            }
+        }
+    }
+    return result;
+}
+
+
+std::vector<quint64> Navigation::Geodesy::ProximityGrid::neighbourhood(const QGeoCoordinate& coordinate) const
+{
+    // Longitude range of the spherical cap around the coordinate. Columns
+    // outside [0, m_columns) wrap around at the anti-meridian. If the cap
+    // contains a pole, all columns need to be searched.
+    auto const sinAngle = std::sin(qMin(m_radiusInM/earthRadiusInM, M_PI/2.0));
+    auto const cosLatitude = std::cos(coordinate.latitude()*degreesToRadians);
+    qint64 firstColumn = 0;
+    qint64 lastColumn = m_columns-1;
+    if (sinAngle < cosLatitude)
+    {
+        auto const deltaLongitude = std::asin(sinAngle/cosLatitude)*radiansToDegrees;
+        auto const first = cellIndex(coordinate.longitude() + 180.0 - deltaLongitude);
+        auto const last = cellIndex(coordinate.longitude() + 180.0 + deltaLongitude);
+        if (last - first < m_columns)
+        {
+            firstColumn = first;
+            lastColumn = last;
+        }
+    }
+
+    std::vector<quint64> result;
+    auto const row = cellIndex(coordinate.latitude() + 90.0);
+    for(auto r = row-1; r <= row+1; r++)
+    {
+        if (r < 0)
+        {
+            continue;
+        }
+        for(auto c = firstColumn; c <= lastColumn; c++)
+        {
+            result.push_back(cellKey(r, ((c % m_columns) + m_columns) % m_columns));
+        }
+    }
+    return result;
+}
+
+
+//
+// Functions
+//
+
+QList<QGeoCoordinate> Navigation::Geodesy::destinations(const QGeoCoordinate& origin, double distanceInM, const std::vector<double>& azimuthsInDEG)
+{
+    QList<QGeoCoordinate> result;
+    result.reserve(static_cast<qsizetype>(azimuthsInDEG.size()));
+
+    Point const start(origin);
+    auto const angle = distanceInM/earthRadiusInM;
+    auto const sinAngle = std::sin(angle);
+    auto const cosAngle = std::cos(angle);
+    for(auto azimuth : azimuthsInDEG)
+    {
+        azimuth *= degreesToRadians;
+        auto const sinLatitude = start.sinLatitude*cosAngle + start.cosLatitude*sinAngle*std::cos(azimuth);
+        auto const latitude = std::asin(qBound(-1.0, sinLatitude, 1.0));
+        auto longitude = start.longitude + std::atan2(std::sin(azimuth)*sinAngle*start.cosLatitude, cosAngle - start.sinLatitude*sinLatitude);
+        longitude = std::remainder(longitude, 2.0*M_PI);
+        result.append(QGeoCoordinate(latitude*radiansToDegrees, longitude*radiansToDegrees, origin.altitude()));
+    }
+    return result;
+}
+
+
+double Navigation::Geodesy::distance(const Point& from, const Point& to)
+{
+    return distanceFromSquaredChord(squaredChord(from, to));
+}
+
+
+double Navigation::Geodesy::fastDistance(const QGeoCoordinate& first, const QGeoCoordinate& second)
+{
+    auto const meanLatitude = (first.latitude() + second.latitude())/2.0*degreesToRadians;
+    auto const deltaLatitude = (second.latitude() - first.latitude())*degreesToRadians;
+    auto const deltaLongitude = std::remainder((second.longitude() - first.longitude())*degreesToRadians, 2.0*M_PI);
+    auto const x = deltaLongitude*std::cos(meanLatitude);
+    return earthRadiusInM*std::sqrt(x*x + deltaLatitude*deltaLatitude);
+}
+
+
+bool Navigation::Geodesy::isCloserThan(const QGeoCoordinate& first, const QGeoCoordinate& second, double distanceInM)
+{
+    if (!first.isValid() || !second.isValid())
+    {
+        return false;
+    }
+
+    // The great-circle distance is never smaller than the difference in
+    // latitude. This decides most pairs that are far apart.
+    if (qAbs(second.latitude() - first.latitude())*degreesToRadians*earthRadiusInM >= distanceInM*(1.0 + fastDistanceMaxRelativeError))
+    {
+        return false;
+    }
+
+    // Within the range of validity, fastDistance() decides all pairs except
+    // those whose distance is very close to distanceInM
+    if ((qAbs(first.latitude()) <= fastDistanceMaxLatitudeInDEG) && (qAbs(second.latitude()) <= fastDistanceMaxLatitudeInDEG))
+    {
+        auto const approximateDistance = fastDistance(first, second);
+        if (approximateDistance <= fastDistanceMaxRangeInM)
+        {
+            if (approximateDistance < distanceInM*(1.0 - fastDistanceMaxRelativeError))
+            {
+                return true;
+            }
+            if (approximateDistance > distanceInM*(1.0 + fastDistanceMaxRelativeError))
+            {
+                return false;
+            }
+        }
+    }
+
+    return first.distanceTo(second) < distanceInM;
+}
+
+
+bool Navigation::Geodesy::isWithin(const Point& first, const Point& second, double distanceInM)
+{
+    return squaredChord(first, second) <= squaredChordForDistance(distanceInM);
+}
+
+
+double Navigation::Geodesy::squaredChord(const Point& first, const Point& second)
+{
+    auto const dx = first.x - second.x;
+    auto const dy = first.y - second.y;
+    auto const dz = first.z - second.z;
+    return dx*dx + dy*dy + dz*dz;
+}
+
+
+double Navigation::Geodesy::squaredChordForDistance(double distanceInM)
+{
+    auto const chord = 2.0*std::sin(qMin(distanceInM/earthRadiusInM, M_PI)/2.0);
+    return chord*chord;
+}
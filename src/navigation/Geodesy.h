@@ -0,0 +1,369 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <QGeoCoordinate>
+#include <QHash>
+#include <vector>
+
+
+namespace Navigation::Geodesy {
+
+/*! \brief Radius of the earth
+ *
+ *  This is the mean radius used by QGeoCoordinate, so that the results of the
+ *  methods in this namespace agree with QGeoCoordinate::distanceTo(),
+ *  QGeoCoordinate::azimuthTo() and QGeoCoordinate::atDistanceAndAzimuth().
+ */
+constexpr double earthRadiusInM = 6371007.2;
+
+/*! \brief Maximal latitude for which fastDistance() is accurate */
+constexpr double fastDistanceMaxLatitudeInDEG = 80.0;
+
+/*! \brief Maximal distance for which fastDistance() is accurate */
+constexpr double fastDistanceMaxRangeInM = 20000.0;
+
+/*! \brief Error bound of fastDistance()
+ *
+ *  If both points lie within fastDistanceMaxLatitudeInDEG of the equator and
+ *  fastDistance() returns at most fastDistanceMaxRangeInM, then the result
+ *  differs from the great-circle distance by at most this fraction of the
+ *  great-circle distance.  The true maximal error in this range is about
+ *  1.5e-5; the bound leaves a safety margin.
+ */
+constexpr double fastDistanceMaxRelativeError = 1.0e-4;
+
+
+/*! \brief Point on the earth, prepared for repeated computations
+ *
+ *  The constructor computes the trigonometric functions of latitude and
+ *  longitude once, together with the position of the point on the unit
+ *  sphere.  All further computations involving the point are cheap.
+ */
+struct Point
+{
+    /*! \brief Default constructor, constructs an invalid point */
+    Point() = default;
+
+    /*! \brief Construct point from coordinate
+     *
+     *  @param coordinate Coordinate. The altitude is ignored.
+     */
+    explicit Point(const QGeoCoordinate& coordinate);
+
+    /*! \brief Latitude in radians */
+    double latitude {qQNaN()};
+
+    /*! \brief Longitude in radians */
+    double longitude {qQNaN()};
+
+    /*! \brief Sine of latitude */
+    double sinLatitude {qQNaN()};
+
+    /*! \brief Cosine of latitude */
+    double cosLatitude {qQNaN()};
+
+    /*! \brief Sine of longitude */
+    double sinLongitude {qQNaN()};
+
+    /*! \brief Cosine of longitude */
+    double cosLongitude {qQNaN()};
+
+    /*! \brief Position on the unit sphere */
+    double x {qQNaN()};
+
+    /*! \brief Position on the unit sphere */
+    double y {qQNaN()};
+
+    /*! \brief Position on the unit sphere */
+    double z {qQNaN()};
+};
+
+
+/*! \brief Array of points
+ *
+ *  This class stores the positions of points on the unit sphere in separate,
+ *  contiguous arrays. The kernels below loop over these arrays without
+ *  branches or calls, so that the compiler can vectorize them for the target
+ *  instruction set (SSE2/AVX on x86, NEON on ARM).
+ */
+class PointArray
+{
+public:
+    /*! \brief Append point
+     *
+     *  @param coordinate Coordinate. The altitude is ignored.
+     */
+    void append(const QGeoCoordinate& coordinate);
+
+    /*! \brief Remove all points */
+    void clear();
+
+    /*! \brief Reserve memory
+     *
+     *  @param size Expected number of points
+     */
+    void reserve(qsizetype size);
+
+    /*! \brief Number of points
+     *
+     *  @returns Number of points
+     */
+    [[nodiscard]] qsizetype size() const
+    {
+        return static_cast<qsizetype>(m_x.size());
+    }
+
+    /*! \brief Squared chord lengths
+     *
+     *  Computes the squared length of the straight line through the unit
+     *  sphere from the origin to every point.  The squared chord length is a
+     *  monotone function of the distance. It is the cheapest quantity for
+     *  comparing and sorting distances and requires no trigonometric functions.
+     *
+     *  @param origin Origin
+     *
+     *  @param result Array of size() entries for the results
+     */
+    void squaredChords(const Point& origin, double* result) const;
+
+    /*! \brief Distances
+     *
+     *  @param origin Origin
+     *
+     *  @param resultInM Array of size() entries for the great-circle distances
+     *  from the origin to the points, in meters
+     */
+    void distances(const Point& origin, double* resultInM) const;
+
+    /*! \brief Azimuths
+     *
+     *  @param origin Origin
+     *
+     *  @param resultInDEG Array of size() entries for the initial bearings from
+     *  the origin to the points, in degrees in the range [0, 360)
+     */
+    void azimuths(const Point& origin, double* resultInDEG) const;
+
+    /*! \brief Nearest point
+     *
+     *  @param origin Origin
+     *
+     *  @returns Index of the point that is nearest to the origin, or -1 if the
+     *  array is empty. Points with invalid coordinates are never nearest,
+     *  unless all points are invalid.
+     */
+    [[nodiscard]] qsizetype nearest(const Point& origin) const;
+
+    /*! \brief Points, ordered by distance
+     *
+     *  @param origin Origin
+     *
+     *  @param count Maximal number of indices returned
+     *
+     *  @returns Indices of the count points nearest to the origin, nearest
+     *  point first. Points with invalid coordinates come last.
+     */
+    [[nodiscard]] std::vector<qsizetype> nearestIndices(const Point& origin, qsizetype count) const;
+
+private:
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    std::vector<double> m_z;
+};
+
+
+/*! \brief Grid index for proximity queries
+ *
+ *  This class sorts coordinates into the cells of a latitude/longitude grid
+ *  whose cells are at least as large as the search radius.  A query only
+ *  looks at the coordinates in the neighbouring cells, so that inserting and
+ *  querying take constant time on average, independently of the number of
+ *  coordinates stored.
+ */
+class ProximityGrid
+{
+public:
+    /*! \brief Construct an empty grid
+     *
+     *  @param radiusInM Search radius in meters
+     */
+    explicit ProximityGrid(double radiusInM);
+
+    /*! \brief Check if the grid contains a nearby coordinate
+     *
+     *  @param coordinate Coordinate
+     *
+     *  @returns True if the coordinate is valid and if the grid contains a
+     *  coordinate whose distance is less than the search radius, see
+     *  isCloserThan()
+     */
+    [[nodiscard]] bool containsNear(const QGeoCoordinate& coordinate) const;
+
+    /*! \brief Add coordinate to the grid
+     *
+     *  Coordinates are numbered in the order of insertion, starting with 0.
+     *
+     *  @param coordinate Coordinate. Invalid coordinates are not stored, but
+     *  count for the numbering.
+     */
+    void insert(const QGeoCoordinate& coordinate);
+
+    /*! \brief Closest coordinate
+     *
+     *  @param coordinate Coordinate
+     *
+     *  @returns Number of the closest coordinate in the grid whose distance is
+     *  at most the search radius, or -1 if there is no such coordinate. If
+     *  several coordinates are equally close, the one inserted first is
+     *  returned.
+     */
+    [[nodiscard]] qsizetype nearest(const QGeoCoordinate& coordinate) const;
+
+private:
+    // Coordinate, together with its number
+    struct Entry
+    {
+        QGeoCoordinate coordinate;
+        qsizetype index;
+    };
+
+    // Returns the row of a latitude, or the column of a longitude
+    [[nodiscard]] qint64 cellIndex(double degrees) const;
+
+    // Returns the keys of all cells that might contain coordinates within the
+    // search radius
+    [[nodiscard]] std::vector<quint64> neighbourhood(const QGeoCoordinate& coordinate) const;
+
+    // Search radius
+    double m_radiusInM;
+
+    // Size of the cells in degrees, for latitude and longitude alike. The
+    // number of columns is chosen so that the cells fill 360 degrees exactly.
+    qint64 m_columns;
+    double m_cellSizeInDEG;
+
+    // Coordinates, by cell key
+    QHash<quint64, QList<Entry>> m_cells;
+
+    // Number of coordinates inserted
+    qsizetype m_count {0};
+};
+
+
+/*! \brief Great-circle distance
+ *
+ *  @param from Point
+ *
+ *  @param to Point
+ *
+ *  @returns Distance in meters
+ */
+[[nodiscard]] double distance(const Point& from, const Point& to);
+
+/*! \brief Destination points
+ *
+ *  Computes the points at a given distance from the origin, in a number of
+ *  directions.  This is the batch version of
+ *  QGeoCoordinate::atDistanceAndAzimuth(), typically used to construct
+ *  circles and arcs.
+ *
+ *  @param origin Origin. The altitude of the origin is copied to the results.
+ *
+ *  @param distanceInM Distance in meters
+ *
+ *  @param azimuthsInDEG Directions, in degrees
+ *
+ *  @returns Destination points, one for every direction
+ */
+[[nodiscard]] QList<QGeoCoordinate> destinations(const QGeoCoordinate& origin, double distanceInM, const std::vector<double>& azimuthsInDEG);
+
+/*! \brief Approximate distance at short range
+ *
+ *  This method projects the points to the plane, using an equirectangular
+ *  projection at their mean latitude, and returns the euclidean distance in
+ *  the plane.  It requires a single trigonometric function and is therefore
+ *  much faster than QGeoCoordinate::distanceTo().  The error is bounded by
+ *  fastDistanceMaxRelativeError for points at short range, but the result is
+ *  meaningless for points that are far apart or close to the poles.
+ *
+ *  @param first Coordinate
+ *
+ *  @param second Coordinate
+ *
+ *  @returns Approximate distance in meters
+ */
+[[nodiscard]] double fastDistance(const QGeoCoordinate& first, const QGeoCoordinate& second);
+
+/*! \brief Check if two coordinates are closer than a given distance
+ *
+ *  The result is that of the comparison first.distanceTo(second) <
+ *  distanceInM.  Wherever the error bound allows, this method decides by
+ *  comparing latitudes or by calling fastDistance(). It falls back to
+ *  QGeoCoordinate::distanceTo() only for the few pairs where the
+ *  approximation is not good enough to decide.
+ *
+ *  @param first Coordinate
+ *
+ *  @param second Coordinate
+ *
+ *  @param distanceInM Distance in meters
+ *
+ *  @returns True if both coordinates are valid and closer than distanceInM
+ */
+[[nodiscard]] bool isCloserThan(const QGeoCoordinate& first, const QGeoCoordinate& second, double distanceInM);
+
+/*! \brief Check if two points are within a given distance
+ *
+ *  This method does not use trigonometric functions.
+ *
+ *  @param first Point
+ *
+ *  @param second Point
+ *
+ *  @param distanceInM Distance in meters
+ *
+ *  @returns True if the great-circle distance between the points is at most
+ *  distanceInM
+ */
+[[nodiscard]] bool isWithin(const Point& first, const Point& second, double distanceInM);
+
+/*! \brief Squared chord length
+ *
+ *  @param first Point
+ *
+ *  @param second Point
+ *
+ *  @returns Squared length of the straight line through the unit sphere
+ *  between the points, see PointArray::squaredChords()
+ */
+[[nodiscard]] double squaredChord(const Point& first, const Point& second);
+
+/*! \brief Squared chord length for a given distance
+ *
+ *  @param distanceInM Great-circle distance in meters
+ *
+ *  @returns Squared chord length that corresponds to the distance
+ */
+[[nodiscard]] double squaredChordForDistance(double distanceInM);
+
+} // namespace Navigation::Geodesy
@@ -23,19 +23,39 @@
 #include "GlobalObject.h"
 #include "GlobalSettings.h"
 #include "navigation/Navigator.h"
+#include <cmath>
 #include <utility>
 
 
+namespace {
+
+// Equality of doubles, where NaN equals NaN
+auto isSame(double first, double second) -> bool
+{
+    return (first == second) || (std::isnan(first) && std::isnan(second));
+}
+
+} // namespace
+
+
 //
 // Constructors and destructors
 //
 
 Navigation::Leg::Leg(GeoMaps::Waypoint  start, GeoMaps::Waypoint  end) :
-    m_start(std::move(start)), m_end(std::move(end))
+    m_start(std::move(start)), m_end(std::move(end)),
+    m_startPoint(m_start.coordinate()), m_endPoint(m_end.coordinate())
 {
     m_geoPath.addCoordinate(m_start.coordinate());
     m_geoPath.addCoordinate(m_end.coordinate());
     m_geoPath.setWidth( 2.0*nearThreshold.toM() );
+
+    if (isValid()) {
+        m_distance = Units::Distance::fromM( m_start.coordinate().distanceTo(m_end.coordinate()) );
+        if (m_distance >= minLegLength) {
+            m_TC = Units::Angle::fromDEG( m_start.coordinate().azimuthTo(m_end.coordinate()) );
+        }
+    }
 }
 
 
@@ -43,17 +63,6 @@ Navigation::Leg::Leg(GeoMaps::Waypoint  start, GeoMaps::Waypoint  end) :
 // Getter Methods
 //
 
-auto Navigation::Leg::distance() const -> Units::Distance
-{
-    // Paranoid safety checks
-    if (!isValid()) {
-        return {};
-    }
-
-    return Units::Distance::fromM( m_start.coordinate().distanceTo( m_end.coordinate() ));
-}
-
-
 auto Navigation::Leg::isValid() const -> bool
 {
     if (!m_start.coordinate().isValid()) {
@@ -66,53 +75,10 @@ auto Navigation::Leg::isValid() const -> bool
 }
 
 
-auto Navigation::Leg::TC() const -> Units::Angle
-{
-    // Paranoid safety checks
-    if (!isValid()) {
-        return {};
-    }
-    if( Units::Distance::fromM(m_start.coordinate().distanceTo(m_end.coordinate())) < minLegLength ) {
-        return {};
-    }
-
-    return Units::Angle::fromDEG( m_start.coordinate().azimuthTo(m_end.coordinate()) );
-}
-
-
 //
 // Methods
 //
 
-auto Navigation::Leg::Fuel(Weather::Wind wind, const Navigation::Aircraft& aircraft) const -> Units::Volume
-{
-    // This also checks for _aircraft and _wind to be non-nullptr
-    if (!hasDataForWindTriangle(wind, aircraft)) {
-        return {};
-    }
-
-    return aircraft.fuelConsumption()*ETE(wind, aircraft);
-}
-
-
-auto Navigation::Leg::GS(Weather::Wind wind, const Navigation::Aircraft& aircraft) const -> Units::Speed
-{
-    // This also checks for _aircraft and _wind to be non-nullptr
-    if (!hasDataForWindTriangle(wind, aircraft)) {
-        return {};
-    }
-
-    auto TASInKN = aircraft.cruiseSpeed().toKN();
-    auto WSInKN  = wind.speed().toKN();
-    auto WD      = wind.directionFrom();
-
-    // Law of cosine for wind triangle
-    auto GSInKT = qSqrt( TASInKN*TASInKN + WSInKN*WSInKN - 2.0*TASInKN*WSInKN*(WD-TH(wind, aircraft)).cos() );
-
-    return Units::Speed::fromKN(GSInKT);
-}
-
-
 auto Navigation::Leg::isFollowing(const Positioning::PositionInfo& positionInfo) const -> bool
 {
     if (!isNear(positionInfo)) {
@@ -142,32 +108,17 @@ auto Navigation::Leg::isNear(const Positioning::PositionInfo& positionInfo) cons
         return false;
     }
 
-    if (m_start.coordinate().distanceTo(positionInfo.coordinate()) < nearThreshold.toM()) {
+    Navigation::Geodesy::Point const position(positionInfo.coordinate());
+    if (Navigation::Geodesy::isWithin(m_startPoint, position, nearThreshold.toM())) {
         return true;
     }
-    if (m_end.coordinate().distanceTo(positionInfo.coordinate()) < nearThreshold.toM()) {
+    if (Navigation::Geodesy::isWithin(m_endPoint, position, nearThreshold.toM())) {
         return true;
     }
     return m_geoPath.contains(positionInfo.coordinate());
 }
 
 
-auto Navigation::Leg::WCA(Weather::Wind wind, const Navigation::Aircraft& aircraft) const -> Units::Angle
-{
-    // This also checks for _aircraft and _wind to be non-nullptr
-    if (!hasDataForWindTriangle(wind, aircraft)) {
-        return {};
-    }
-
-    Units::Speed const TAS = aircraft.cruiseSpeed();
-    Units::Speed const WS = wind.speed();
-    Units::Angle const WD = wind.directionFrom();
-
-    // Law of sine for wind triangle
-    return Units::Angle::asin(-(TC()-WD).sin() *(WS/TAS));
-}
-
-
 auto Navigation::Leg::description(Weather::Wind wind, const Navigation::Aircraft& aircraft) const -> QString
 {
     if (!isValid()) {
@@ -212,3 +163,43 @@ auto Navigation::Leg::hasDataForWindTriangle(Weather::Wind wind, const Navigatio
 
     return true;
 }
+
+
+auto Navigation::Leg::windTriangle(Weather::Wind wind, const Navigation::Aircraft& aircraft) const -> const WindTriangle&
+{
+    auto const TASInKN = aircraft.cruiseSpeed().toKN();
+    auto const fuelConsumptionInLPH = aircraft.fuelConsumption().toLPH();
+    auto const windDirectionInDEG = wind.directionFrom().toDEG();
+    auto const windSpeedInKN = wind.speed().toKN();
+    if (m_windTriangle.isSet &&
+            isSame(m_windTriangle.TASInKN, TASInKN) &&
+            isSame(m_windTriangle.fuelConsumptionInLPH, fuelConsumptionInLPH) &&
+            isSame(m_windTriangle.windDirectionInDEG, windDirectionInDEG) &&
+            isSame(m_windTriangle.windSpeedInKN, windSpeedInKN)) {
+        return m_windTriangle;
+    }
+
+    WindTriangle result;
+    result.TASInKN = TASInKN;
+    result.fuelConsumptionInLPH = fuelConsumptionInLPH;
+    result.windDirectionInDEG = windDirectionInDEG;
+    result.windSpeedInKN = windSpeedInKN;
+    result.isSet = true;
+
+    if (hasDataForWindTriangle(wind, aircraft)) {
+        auto const WD = wind.directionFrom();
+
+        // Law of sine for wind triangle
+        result.WCA = Units::Angle::asin(-(m_TC-WD).sin() *(wind.speed()/aircraft.cruiseSpeed()));
+
+        // Law of cosine for wind triangle
+        auto const TH = m_TC+result.WCA;
+        result.GS = Units::Speed::fromKN( qSqrt( TASInKN*TASInKN + windSpeedInKN*windSpeedInKN - 2.0*TASInKN*windSpeedInKN*(WD-TH).cos() ) );
+
+        result.ETE = m_distance/result.GS;
+        result.fuel = aircraft.fuelConsumption()*result.ETE;
+    }
+
+    m_windTriangle = result;
+    return m_windTriangle;
+}
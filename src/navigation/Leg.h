@@ -25,6 +25,7 @@
 
 #include "geomaps/Waypoint.h"
 #include "navigation/Aircraft.h"
+#include "navigation/Geodesy.h"
 #include "positioning/PositionInfo.h"
 #include "units/Angle.h"
 #include "units/Units.h"
@@ -32,7 +33,13 @@
 
 namespace Navigation {
 
-/*! \brief Leg in a flight route */
+/*! \brief Leg in a flight route
+ *
+ *  Distance and true course are computed once, when the leg is constructed.
+ *  The results of the wind triangle are memoized for the wind and aircraft
+ *  data of the last call, so that repeated calls with the same data are
+ *  cheap. The methods in this class are reentrant, but not thread safe.
+ */
 
 class Leg {
     Q_GADGET
@@ -93,7 +100,7 @@ public:
      *
      * @returns Property distance
      */
-    [[nodiscard]] auto distance() const -> Units::Distance;
+    [[nodiscard]] auto distance() const -> Units::Distance { return m_distance; }
 
     /*! \brief Getter function for property of the same name
      *
@@ -117,7 +124,7 @@ public:
      *
      * @returns Property TC
      */
-    [[nodiscard]] auto TC() const -> Units::Angle;
+    [[nodiscard]] auto TC() const -> Units::Angle { return m_TC; }
 
 
     //
@@ -144,7 +151,7 @@ public:
      */
     [[nodiscard]] Q_INVOKABLE Units::Timespan ETE(Weather::Wind wind, const Navigation::Aircraft& aircraft) const
     {
-        return distance()/GS(wind, aircraft);
+        return windTriangle(wind, aircraft).ETE;
     }
 
     /*! \brief Estimated fuel consumption on leg
@@ -155,7 +162,10 @@ public:
      *
      *  @returns Estimated fuel consumption on leg
      */
-    [[nodiscard]] Q_INVOKABLE Units::Volume Fuel(Weather::Wind wind, const Navigation::Aircraft& aircraft) const;
+    [[nodiscard]] Q_INVOKABLE Units::Volume Fuel(Weather::Wind wind, const Navigation::Aircraft& aircraft) const
+    {
+        return windTriangle(wind, aircraft).fuel;
+    }
 
     /*! \brief Estimated ground speed on leg
      *
@@ -165,7 +175,10 @@ public:
      *
      *  @returns Estimated ground speed on leg
      */
-    [[nodiscard]] Q_INVOKABLE Units::Speed GS(Weather::Wind wind, const Navigation::Aircraft& aircraft) const;
+    [[nodiscard]] Q_INVOKABLE Units::Speed GS(Weather::Wind wind, const Navigation::Aircraft& aircraft) const
+    {
+        return windTriangle(wind, aircraft).GS;
+    }
 
     /*! \brief Check if positionInfo is travelling on this leg
      *
@@ -211,7 +224,10 @@ public:
      *
      *  @returns Estimated WCA on leg
      */
-    [[nodiscard]] Q_INVOKABLE Units::Angle WCA(Weather::Wind wind, const Navigation::Aircraft& aircraft) const;
+    [[nodiscard]] Q_INVOKABLE Units::Angle WCA(Weather::Wind wind, const Navigation::Aircraft& aircraft) const
+    {
+        return windTriangle(wind, aircraft).WCA;
+    }
 
 
     //
@@ -222,15 +238,46 @@ public:
     static constexpr Units::Distance nearThreshold = Units::Distance::fromNM(3.0);
 
 private:
+    // Results of the wind triangle, together with the data that they were
+    // computed from
+    struct WindTriangle
+    {
+        double TASInKN {qQNaN()};
+        double fuelConsumptionInLPH {qQNaN()};
+        double windDirectionInDEG {qQNaN()};
+        double windSpeedInKN {qQNaN()};
+        bool isSet {false};
+
+        Units::Volume fuel;
+        Units::Timespan ETE;
+        Units::Speed GS;
+        Units::Angle WCA;
+    };
+
     // Necessary data for computation of wind triangle?
     [[nodiscard]] static auto hasDataForWindTriangle(Weather::Wind wind, const Navigation::Aircraft& aircraft) -> bool;
 
+    // Returns the wind triangle for the given data. The result is recomputed
+    // only if the data differs from that of the previous call.
+    [[nodiscard]] auto windTriangle(Weather::Wind wind, const Navigation::Aircraft& aircraft) const -> const WindTriangle&;
+
     // Minimum length of the leg in meters. If shorter, no courses are computed.
     static constexpr Units::Distance minLegLength = Units::Distance::fromM(100.0);
 
     GeoMaps::Waypoint m_start;
     GeoMaps::Waypoint m_end;
     QGeoPath m_geoPath;
+
+    // Start and end point, prepared for fast distance computations
+    Navigation::Geodesy::Point m_startPoint;
+    Navigation::Geodesy::Point m_endPoint;
+
+    // Geometry, computed in the constructor
+    Units::Distance m_distance;
+    Units::Angle m_TC;
+
+    // Memoized wind triangle
+    mutable WindTriangle m_windTriangle;
 };
 
 } // namespace Navigation
@@ -20,13 +20,17 @@
 
 #include <QQmlEngine>
 #include <QStandardPaths>
+#include <QtConcurrent>
 
 #include "GlobalObject.h"
 #include "GlobalSettings.h"
+#include "fileFormats/DataFileAbstract.h"
 #include "geomaps/GeoMapProvider.h"
 #include "navigation/Navigator.h"
 #include "positioning/PositionProvider.h"
 
+using namespace std::chrono_literals;
+
 
 //
 // Constructors and destructors
@@ -41,6 +45,13 @@ Navigation::Navigator::Navigator(QObject *parent) : GlobalObject(parent)
     m_wind.setSpeed(Units::Speed::fromKN(settings.value(QStringLiteral("Wind/windSpeedInKT"), qQNaN()).toDouble()));
     m_wind.setDirectionFrom( Units::Angle::fromDEG(settings.value(QStringLiteral("Wind/windDirectionInDEG"), qQNaN()).toDouble()) );
 
+    // Restore cruise altitude and winds aloft
+    m_cruiseAltitude = Units::Distance::fromFT(settings.value(QStringLiteral("Route/cruiseAltitudeInFT"), qQNaN()).toDouble());
+    auto windField = std::make_shared<Weather::WindField>();
+    if (QFile::exists(m_windFieldFileName) && windField->loadFromJSON(m_windFieldFileName).isEmpty()) {
+        m_windField = windField;
+    }
+
     // Restore aircraft
     QFile file(m_aircraftFileName);
     if (file.open(QIODevice::ReadOnly)) {
@@ -53,6 +64,18 @@ Navigation::Navigator::Navigator(QObject *parent) : GlobalObject(parent)
         m_aircraft.setDescentSpeed(descentSpeed);
         m_aircraft.setFuelConsumption(fuelConsumption);
     }
+
+    // Airspace crossings
+    m_airspaceCrossingsTimer.setInterval(200ms);
+    m_airspaceCrossingsTimer.setSingleShot(true);
+    connect(&m_airspaceCrossingsTimer, &QTimer::timeout, this, &Navigation::Navigator::startAirspaceCrossings);
+    connect(&m_airspaceCrossingsWatcher, &QFutureWatcher<AirspaceCrossingsResult>::finished, this, &Navigation::Navigator::onAirspaceCrossingsFinished);
+}
+
+
+Navigation::Navigator::~Navigator()
+{
+    m_airspaceCrossingsWatcher.waitForFinished();
 }
 
 
@@ -61,9 +84,20 @@ void Navigation::Navigator::deferredInitialization()
     connect(GlobalObject::positionProvider(), &Positioning::PositionProvider::positionInfoChanged, this, &Navigation::Navigator::updateAltitudeLimit);
     connect(GlobalObject::positionProvider(), &Positioning::PositionProvider::positionInfoChanged, this, &Navigation::Navigator::updateFlightStatus);
     connect(GlobalObject::positionProvider(), &Positioning::PositionProvider::positionInfoChanged, this, &Navigation::Navigator::updateRemainingRouteInfo);
-    connect(this, &Navigation::Navigator::aircraftChanged, this, [this](){ updateRemainingRouteInfo(); });
-    connect(this, &Navigation::Navigator::windChanged, this, [this](){ updateRemainingRouteInfo(); });
-    connect(flightRoute(), &Navigation::FlightRoute::waypointsChanged, this, [this](){ updateRemainingRouteInfo(); });
+    connect(this, &Navigation::Navigator::aircraftChanged, this, [this](){ m_routeProgress.invalidate(); m_verticalProfile.invalidate(); updateRemainingRouteInfo(); });
+    connect(this, &Navigation::Navigator::windChanged, this, [this](){ m_routeProgress.invalidate(); m_verticalProfile.invalidate(); updateRemainingRouteInfo(); });
+    connect(this, &Navigation::Navigator::cruiseAltitudeChanged, this, [this](){ m_verticalProfile.invalidate(); updateRemainingRouteInfo(); });
+    connect(this, &Navigation::Navigator::windFieldChanged, this, [this](){ m_verticalProfile.invalidate(); updateRemainingRouteInfo(); });
+    connect(flightRoute(), &Navigation::FlightRoute::waypointsChanged, this, [this](){ m_routeProgress.invalidate(); m_verticalProfile.setRoute(flightRoute()->legs()); updateRemainingRouteInfo(); });
+    m_verticalProfile.setRoute(flightRoute()->legs());
+
+    connect(flightRoute(), &Navigation::FlightRoute::waypointsChanged, &m_airspaceCrossingsTimer, qOverload<>(&QTimer::start));
+    connect(GlobalObject::geoMapProvider(), &GeoMaps::GeoMapProvider::airspacesChanged, this, [this]() {
+        m_airspaceIndex.reset();
+        m_airspacesVersion++;
+        m_airspaceCrossingsTimer.start();
+    });
+    m_airspaceCrossingsTimer.start();
 }
 
 
@@ -104,6 +138,22 @@ void Navigation::Navigator::setAircraft(const Navigation::Aircraft& newAircraft)
 }
 
 
+void Navigation::Navigator::setCruiseAltitude(Units::Distance newCruiseAltitude)
+{
+    if ((newCruiseAltitude == m_cruiseAltitude) || (!newCruiseAltitude.isFinite() && !m_cruiseAltitude.isFinite())) {
+        return;
+    }
+
+    // Save cruise altitude
+    QSettings settings;
+    settings.setValue(QStringLiteral("Route/cruiseAltitudeInFT"), newCruiseAltitude.toFeet());
+
+    // Set new cruise altitude
+    m_cruiseAltitude = newCruiseAltitude;
+    emit cruiseAltitudeChanged();
+}
+
+
 void Navigation::Navigator::setFlightStatus(FlightStatus newFlightStatus)
 {
     if (m_flightStatus == newFlightStatus) {
@@ -132,10 +182,106 @@ void Navigation::Navigator::setWind(Weather::Wind newWind)
 }
 
 
+//
+// Methods
+//
+
+auto Navigation::Navigator::computeAirspaceCrossings(std::shared_ptr<const AirspaceIndex> index, const QList<GeoMaps::Airspace>& airspaces, quint64 airspacesVersion, const QList<QGeoCoordinate>& path) -> AirspaceCrossingsResult
+{
+    if (index == nullptr) {
+        index = std::make_shared<const AirspaceIndex>(airspaces);
+    }
+
+    AirspaceCrossingsResult result;
+    result.crossings = index->crossings(path);
+    result.index = std::move(index);
+    result.airspacesVersion = airspacesVersion;
+    result.path = path;
+    return result;
+}
+
+
+void Navigation::Navigator::clearWindField()
+{
+    if (m_windField == nullptr) {
+        return;
+    }
+
+    QFile::remove(m_windFieldFileName);
+    m_windField = nullptr;
+    emit windFieldChanged();
+}
+
+
+auto Navigation::Navigator::loadWindField(const QString& fileName) -> QString
+{
+    auto file = FileFormats::DataFileAbstract::openFileURL(fileName);
+    if (!file->open(QIODevice::ReadOnly)) {
+        return tr("Unable to open the file '%1' for reading.").arg(fileName);
+    }
+    auto const data = file->readAll();
+
+    auto windField = std::make_shared<Weather::WindField>();
+    auto errorString = windField->loadFromJSON(data);
+    if (!errorString.isEmpty()) {
+        return errorString;
+    }
+
+    // Save a copy of the file
+    QFile copy(m_windFieldFileName);
+    if (copy.open(QIODevice::WriteOnly)) {
+        copy.write(data);
+    }
+
+    m_windField = windField;
+    emit windFieldChanged();
+    return {};
+}
+
+
 //
 // Slots
 //
 
+void Navigation::Navigator::onAirspaceCrossingsFinished()
+{
+    auto result = m_airspaceCrossingsWatcher.result();
+
+    // Discard results if the airspaces have changed in the meantime. If only
+    // the route has changed, keep the index and start over.
+    if (result.airspacesVersion != m_airspacesVersion) {
+        startAirspaceCrossings();
+        return;
+    }
+    m_airspaceIndex = result.index;
+    if (result.path != flightRoute()->geoPath()) {
+        startAirspaceCrossings();
+        return;
+    }
+
+    if (result.crossings != m_airspaceCrossings) {
+        m_airspaceCrossings = result.crossings;
+        emit airspaceCrossingsChanged();
+    }
+}
+
+
+void Navigation::Navigator::startAirspaceCrossings()
+{
+    m_airspaceCrossingsTimer.stop();
+    if (m_airspaceCrossingsWatcher.isRunning()) {
+        return;
+    }
+
+    // The list of airspaces is only needed if the index must be rebuilt
+    QList<GeoMaps::Airspace> airspaces;
+    if (m_airspaceIndex == nullptr) {
+        airspaces = GlobalObject::geoMapProvider()->allAirspaces();
+    }
+    m_airspaceCrossingsWatcher.setFuture(QtConcurrent::run(&Navigation::Navigator::computeAirspaceCrossings, m_airspaceIndex, airspaces, m_airspacesVersion, flightRoute()->geoPath()));
+}
+
+
 void Navigation::Navigator::updateAltitudeLimit()
 {  
     auto info = GlobalObject::positionProvider()->positionInfo();
@@ -235,7 +381,6 @@ void Navigation::Navigator::updateRemainingRouteInfo()
     //
     // Figure out what the current leg is
     //
-    auto legs = flightRoute()->legs();
 
     // If the flight route contains one waypoint only, then create an artificial leg from the current position
     // to the one waypoint of the route.
@@ -243,34 +388,16 @@ void Navigation::Navigator::updateRemainingRouteInfo()
     {
         auto start = Positioning::PositionProvider::lastValidCoordinate();
         auto end = flightRoute()->waypoints()[0];
-        legs += Leg(start, end);
-    }
-
-    // Check legs that we are following, and take the last one
-    qsizetype currentLeg = -1;
-    for(auto i=legs.size()-1; i>=0; i--)
-    {
-        if (legs[i].isFollowing(info))
-        {
-            currentLeg = i;
-            break;
-        }
+        m_routeProgress.setRoute({Leg(start, end)}, m_wind, m_aircraft);
     }
-
-    // If no current leg found, check legs that we are near to, and take the last one.
-    if (currentLeg < 0)
+    else if (!m_routeProgress.isValid())
     {
-        for(auto i=legs.size()-1; i>=0; i--)
-        {
-            if (legs[i].isNear(info))
-            {
-                currentLeg = i;
-                break;
-            }
-        }
+        m_routeProgress.setRoute(flightRoute()->legs(), m_wind, m_aircraft);
     }
+    const auto& legs = m_routeProgress.legs();
+    auto const currentLeg = m_routeProgress.update(info);
 
-    // If still no current leg found, then abort
+    // If no current leg found, then abort
     if (currentLeg < 0)
     {
         RemainingRouteInfo rrInfo;
@@ -315,11 +442,8 @@ void Navigation::Navigator::updateRemainingRouteInfo()
 
     if (currentLeg < legs.size()-1)
     {
-        for(auto i=currentLeg+1; i<legs.size(); i++)
-        {
-            dist += legs[i].distance();
-            ETE += legs[i].ETE(m_wind, m_aircraft);
-        }
+        dist += m_routeProgress.remainingDistance(currentLeg);
+        ETE += m_routeProgress.remainingETE(currentLeg);
 
         rri.finalWP = legs.last().endPoint();
         rri.finalWP_DIST = dist;
@@ -330,6 +454,29 @@ void Navigation::Navigator::updateRemainingRouteInfo()
         }
     }
 
+    // Vertical profile. The profile is computed only for routes with at
+    // least two waypoints, and only when outdated.
+    if (flightRoute()->size() > 1)
+    {
+        if (!m_verticalProfile.isValid())
+        {
+            m_verticalProfile.compute(m_aircraft, m_wind, m_windField, m_cruiseAltitude);
+        }
+        rri.maximumTerrainAhead = m_verticalProfile.maximumTerrainAhead(currentLeg);
+        if (m_flightStatus == Flight)
+        {
+            auto const distToTOD = m_verticalProfile.distanceToTopOfDescent(dist, info.trueAltitudeAMSL());
+            if (distToTOD.isFinite() && (distToTOD.toM() > 0.0))
+            {
+                rri.TOD_DIST = distToTOD;
+                if (info.groundSpeed().isFinite() && (info.groundSpeed() > Units::Speed::fromKN(10.0)))
+                {
+                    rri.TOD_ETE = distToTOD/info.groundSpeed();
+                }
+            }
+        }
+    }
+
     QStringList complaints;
     if (!m_aircraft.cruiseSpeed().isFinite())
     {
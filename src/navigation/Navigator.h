@@ -20,13 +20,20 @@
 
 #pragma once
 
+#include <QFutureWatcher>
 #include <QQmlEngine>
 #include <QStandardPaths>
+#include <QTimer>
+#include <memory>
 
 #include "FlightRoute.h"
 #include "GlobalObject.h"
+#include "navigation/AirspaceCrossing.h"
 #include "navigation/FlightRoute.h"
 #include "navigation/RemainingRouteInfo.h"
+#include "navigation/RouteProgressTracker.h"
+#include "navigation/VerticalProfile.h"
+#include "weather/WindField.h"
 
 
 namespace Navigation {
@@ -71,7 +78,7 @@ public:
     explicit Navigator() = delete;
 
     /*! \brief Standard destructor */
-    ~Navigator() override = default;
+    ~Navigator() override;
 
     // factory function for QML singleton
     static Navigation::Navigator* create(QQmlEngine* /*unused*/, QJSEngine* /*unused*/)
@@ -91,6 +98,24 @@ public:
      */
     Q_PROPERTY(Navigation::Aircraft aircraft READ aircraft WRITE setAircraft NOTIFY aircraftChanged)
 
+    /*! \brief Airspaces crossed by the current flight route
+     *
+     *  This property holds the passages of the legs of the flight route
+     *  through the lateral limits of the airspaces in the installed aviation
+     *  maps, ordered by leg and entry distance. It is computed in a background
+     *  thread whenever the flight route or the aviation data change, and
+     *  might therefore lag behind the flight route for a short moment.
+     */
+    Q_PROPERTY(QList<Navigation::AirspaceCrossing> airspaceCrossings READ airspaceCrossings NOTIFY airspaceCrossingsChanged)
+
+    /*! \brief Planned cruise altitude, MSL
+     *
+     *  This property is NaN if no cruise altitude has been set. It is used,
+     *  together with the climb and descent data of the aircraft, to compute
+     *  the vertical profile of the flight route.
+     */
+    Q_PROPERTY(Units::Distance cruiseAltitude READ cruiseAltitude WRITE setCruiseAltitude NOTIFY cruiseAltitudeChanged)
+
     /*! \brief Current flight route
      *
      *  This flight route returned here is owned by this class and must not be deleted.
@@ -111,6 +136,13 @@ public:
     /*! \brief Current wind */
     Q_PROPERTY(Weather::Wind wind READ wind WRITE setWind NOTIFY windChanged)
 
+    /*! \brief Indicates if winds aloft are known
+     *
+     *  This property is true if a wind field has been loaded with
+     *  loadWindField().
+     */
+    Q_PROPERTY(bool hasWindField READ hasWindField NOTIFY windFieldChanged)
+
 
     //
     // Getter Methods
@@ -122,6 +154,28 @@ public:
      */
     [[nodiscard]] auto aircraft() const -> Navigation::Aircraft { return m_aircraft; }
 
+    /*! \brief Getter function for the property with the same name
+     *
+     *  @returns Property airspaceCrossings
+     */
+    [[nodiscard]] auto airspaceCrossings() const -> QList<Navigation::AirspaceCrossing> { return m_airspaceCrossings; }
+
+    /*! \brief Spatial index of all airspaces
+     *
+     *  The index is built in a background thread, together with the airspace
+     *  crossings of the flight route.
+     *
+     *  @returns Index of the airspaces in the installed aviation maps, or
+     *  nullptr while the index is being built
+     */
+    [[nodiscard]] auto airspaceIndex() const -> std::shared_ptr<const Navigation::AirspaceIndex> { return m_airspaceIndex; }
+
+    /*! \brief Getter function for the property with the same name
+     *
+     *  @returns Property cruiseAltitude
+     */
+    [[nodiscard]] auto cruiseAltitude() const -> Units::Distance { return m_cruiseAltitude; }
+
     /*! \brief Getter function for the property with the same name
      *
      *  @returns Property flightRoute
@@ -134,6 +188,12 @@ public:
      */
     [[nodiscard]] auto flightStatus() const -> FlightStatus { return m_flightStatus; }
 
+    /*! \brief Getter function for the property with the same name
+     *
+     *  @returns Property hasWindField
+     */
+    [[nodiscard]] auto hasWindField() const -> bool { return m_windField != nullptr; }
+
     /*! \brief Getter function for the property with the same name
      *
      *  @returns Property remaining route info
@@ -146,6 +206,12 @@ public:
      */
     [[nodiscard]] auto wind() const -> Weather::Wind { return m_wind; }
 
+    /*! \brief Winds aloft
+     *
+     *  @returns Wind field loaded with loadWindField(), or nullptr
+     */
+    [[nodiscard]] auto windField() const -> std::shared_ptr<const Weather::WindField> { return m_windField; }
+
 
     //
     // Setter Methods
@@ -157,12 +223,39 @@ public:
      */
     void setAircraft(const Navigation::Aircraft& newAircraft);
 
+    /*! \brief Setter function for property of the same name
+     *
+     *  @param newCruiseAltitude Property cruiseAltitude
+     */
+    void setCruiseAltitude(Units::Distance newCruiseAltitude);
+
     /*! \brief Setter function for property of the same name
      *
      *  @param newWind Property wind
      */
     void setWind(Weather::Wind newWind);
 
+
+    //
+    // Methods
+    //
+
+    /*! \brief Forget winds aloft */
+    Q_INVOKABLE void clearWindField();
+
+    /*! \brief Load winds aloft
+     *
+     *  This method reads a wind field from a JSON file, see
+     *  Weather::WindField for the format. On success, the file is copied, so
+     *  that the wind field is restored on the next start.
+     *
+     *  @param fileName File name, file URL or Android content URL
+     *
+     *  @returns Empty string in case of success, human-readable, translated
+     *  error message otherwise
+     */
+    Q_INVOKABLE QString loadWindField(const QString& fileName);
+
 signals:
     /*! \brief Notifier signal */
     void aircraftChanged();
@@ -178,6 +271,12 @@ signals:
      */
     void airspaceAltitudeLimitAdjusted();
 
+    /*! \brief Notifier signal */
+    void airspaceCrossingsChanged();
+
+    /*! \brief Notifier signal */
+    void cruiseAltitudeChanged();
+
     /*! \brief Notifier signal */
     void flightStatusChanged();
 
@@ -187,7 +286,17 @@ signals:
     /*! \brief Notifier signal */
     void windChanged();
 
+    /*! \brief Notifier signal */
+    void windFieldChanged();
+
 private slots:
+    // Handles the result of an airspace crossing computation
+    void onAirspaceCrossingsFinished();
+
+    // Starts the computation of the airspace crossings in a background
+    // thread, unless a computation is already running
+    void startAirspaceCrossings();
+
     // Check if altitude limit for flight maps needs to be lifted. Connected to positioning source.
     void updateAltitudeLimit();
 
@@ -203,6 +312,19 @@ private slots:
 private:
     Q_DISABLE_COPY_MOVE(Navigator)
 
+    // Result of an airspace crossing computation
+    struct AirspaceCrossingsResult
+    {
+        std::shared_ptr<const AirspaceIndex> index;
+        quint64 airspacesVersion {0};
+        QList<QGeoCoordinate> path;
+        QList<AirspaceCrossing> crossings;
+    };
+
+    // Intersects the path with the airspaces. Builds a new index from
+    // airspaces if index is nullptr. This method runs in a background thread.
+    static auto computeAirspaceCrossings(std::shared_ptr<const AirspaceIndex> index, const QList<GeoMaps::Airspace>& airspaces, quint64 airspacesVersion, const QList<QGeoCoordinate>& path) -> AirspaceCrossingsResult;
+
     // Updater function for the property with the same name
     void setFlightStatus(FlightStatus newFlightStatus);
 
@@ -218,10 +340,35 @@ private:
 
     Weather::Wind m_wind {};
 
+    Units::Distance m_cruiseAltitude {};
+
+    std::shared_ptr<const Weather::WindField> m_windField;
+    const QString m_windFieldFileName {QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)+"/wind field.json"};
+
     QString m_aircraftFileName;
 
     // RemainingRouteInfo only use the setter method to write to m_remainingRouteInfo
     RemainingRouteInfo m_remainingRouteInfo;
+
+    // Current leg and totals for the remaining legs. Invalidated whenever
+    // route, wind or aircraft change.
+    RouteProgressTracker m_routeProgress;
+
+    // Vertical profile of the route. The route is set whenever the
+    // waypoints change; the profile is invalidated whenever aircraft, wind,
+    // winds aloft or cruise altitude change.
+    VerticalProfile m_verticalProfile;
+
+    // Airspace crossings of the route. The index is built in the background
+    // on first use, and dropped whenever the airspaces change. The version
+    // counts these changes, so that results computed from outdated data can
+    // be recognized. m_airspaceCrossingsTimer coalesces changes that arrive
+    // in quick succession.
+    QList<AirspaceCrossing> m_airspaceCrossings;
+    std::shared_ptr<const AirspaceIndex> m_airspaceIndex;
+    quint64 m_airspacesVersion {0};
+    QTimer m_airspaceCrossingsTimer;
+    QFutureWatcher<AirspaceCrossingsResult> m_airspaceCrossingsWatcher;
 };
 
 } // namespace Navigation
@@ -38,5 +38,10 @@ auto Navigation::operator==(const Navigation::RemainingRouteInfo& A, const Navig
             (A.finalWP == B.finalWP) &&
             (A.finalWP_DIST == B.finalWP_DIST) &&
             (A.finalWP_ETE == B.finalWP_ETE) &&
-            (A.finalWP_ETA == B.finalWP_ETA));
+            (A.finalWP_ETA == B.finalWP_ETA) &&
+
+            (A.TOD_DIST == B.TOD_DIST) &&
+            (A.TOD_ETE == B.TOD_ETE) &&
+
+            (A.maximumTerrainAhead == B.maximumTerrainAhead));
 }
@@ -107,6 +107,19 @@ public:
     /*! \brief ETA for flight to final waypoint in the route, in UTC and as a string */
     Q_PROPERTY(QString finalWP_ETAAsUTCString READ finalWP_ETAAsUTCString CONSTANT)
 
+    /*! \brief Distance to top of descent
+     *
+     *  This is NaN if the vertical profile is unknown, if the aircraft is not
+     *  flying, or if the top of descent has been passed.
+     */
+    Q_PROPERTY(Units::Distance TOD_DIST MEMBER TOD_DIST CONSTANT)
+
+    /*! \brief ETE for flight to top of descent */
+    Q_PROPERTY(Units::Timespan TOD_ETE MEMBER TOD_ETE CONSTANT)
+
+    /*! \brief Highest terrain along the remaining route, MSL */
+    Q_PROPERTY(Units::Distance maximumTerrainAhead MEMBER maximumTerrainAhead CONSTANT)
+
     /*! \brief Note
      *
      * This property contains an optional localized warning, if ETE cannot be computed because
@@ -158,6 +171,11 @@ private:
     Units::Distance finalWP_DIST{};
     Units::Timespan finalWP_ETE {};
     QDateTime finalWP_ETA;
+
+    Units::Distance TOD_DIST{};
+    Units::Timespan TOD_ETE {};
+
+    Units::Distance maximumTerrainAhead{};
 };
 
 /*! \brief Comparison */
@@ -0,0 +1,183 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "navigation/Geodesy.h"
+#include "navigation/RouteOptimizer.h"
+
+
+namespace {
+
+// Symmetric matrix of distances between points, in meters
+class DistanceMatrix
+{
+public:
+    explicit DistanceMatrix(const QList<QGeoCoordinate>& coordinates)
+        : m_size(static_cast<std::size_t>(coordinates.size())),
+          m_distances(m_size*m_size)
+    {
+        Navigation::Geodesy::PointArray points;
+        points.reserve(coordinates.size());
+        for(const auto& coordinate : coordinates)
+        {
+            points.append(coordinate);
+        }
+        for(std::size_t i=0; i<m_size; i++)
+        {
+            points.distances(Navigation::Geodesy::Point(coordinates[static_cast<qsizetype>(i)]), m_distances.data() + i*m_size);
+        }
+    }
+
+    [[nodiscard]] double operator()(qsizetype from, qsizetype to) const
+    {
+        return m_distances[static_cast<std::size_t>(from)*m_size + static_cast<std::size_t>(to)];
+    }
+
+private:
+    std::size_t m_size;
+    std::vector<double> m_distances;
+};
+
+
+// Applies the first 2-opt move that shortens the route. Returns true if a
+// move was applied.
+bool twoOpt(std::vector<qsizetype>& order, const DistanceMatrix& distance)
+{
+    auto const n = static_cast<qsizetype>(order.size());
+    for(qsizetype i=0; i<n-3; i++)
+    {
+        for(qsizetype j=i+2; j<n-1; j++)
+        {
+            // Replace legs (i, i+1) and (j, j+1) by (i, j) and (i+1, j+1)
+            auto const gain = distance(order[i], order[i+1]) + distance(order[j], order[j+1])
+                              - distance(order[i], order[j]) - distance(order[i+1], order[j+1]);
+            if (gain > Navigation::RouteOptimizer::minGainInM)
+            {
+                std::reverse(order.begin()+i+1, order.begin()+j+1);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+
+// Applies the first Or-opt move that shortens the route. Returns true if a
+// move was applied.
+bool orOpt(std::vector<qsizetype>& order, const DistanceMatrix& distance)
+{
+    auto const n = static_cast<qsizetype>(order.size());
+    for(qsizetype length=1; length<=Navigation::RouteOptimizer::maxSegmentLength; length++)
+    {
+        // Segment first, ..., last, between the fixed end points
+        for(qsizetype first=1; first+length<n; first++)
+        {
+            auto const last = first+length-1;
+            auto const prev = order[first-1];
+            auto const next = order[last+1];
+            auto const removeGain = distance(prev, order[first]) + distance(order[last], next) - distance(prev, next);
+
+            // Insert segment between position p and p+1, outside the segment
+            for(qsizetype p=0; p<n-1; p++)
+            {
+                if ((p >= first-1) && (p <= last))
+                {
+                    continue;
+                }
+                auto const a = order[p];
+                auto const b = order[p+1];
+                auto const forwardCost = distance(a, order[first]) + distance(order[last], b) - distance(a, b);
+                auto const reverseCost = distance(a, order[last]) + distance(order[first], b) - distance(a, b);
+                auto const reversed = reverseCost < forwardCost;
+                if (removeGain - qMin(forwardCost, reverseCost) <= Navigation::RouteOptimizer::minGainInM)
+                {
+                    continue;
+                }
+
+                std::vector<qsizetype> segment(order.begin()+first, order.begin()+last+1);
+                if (reversed)
+                {
+                    std::reverse(segment.begin(), segment.end());
+                }
+                order.erase(order.begin()+first, order.begin()+last+1);
+                auto const insertAt = (p < first) ? p+1 : p+1-length;
+                order.insert(order.begin()+insertAt, segment.begin(), segment.end());
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+
+qsizetype Navigation::RouteOptimizer::bestInsertion(const QList<Navigation::Leg>& legs, const QGeoCoordinate& coordinate)
+{
+    if (legs.isEmpty())
+    {
+        return -1;
+    }
+
+    // Distances from the point to all waypoints
+    Navigation::Geodesy::PointArray waypoints;
+    waypoints.reserve(legs.size()+1);
+    for(const auto& leg : legs)
+    {
+        waypoints.append(leg.startPoint().coordinate());
+    }
+    waypoints.append(legs.last().endPoint().coordinate());
+    std::vector<double> distances(static_cast<std::size_t>(waypoints.size()));
+    waypoints.distances(Navigation::Geodesy::Point(coordinate), distances.data());
+
+    qsizetype result = 0;
+    auto shortestDetour = qInf();
+    for(qsizetype i=0; i<legs.size(); i++)
+    {
+        auto const detour = distances[i] + distances[i+1] - legs[i].distance().toM();
+        if (detour < shortestDetour)
+        {
+            shortestDetour = detour;
+            result = i;
+        }
+    }
+    return result;
+}
+
+
+QList<qsizetype> Navigation::RouteOptimizer::optimizedOrder(const QList<QGeoCoordinate>& coordinates)
+{
+    std::vector<qsizetype> order(static_cast<std::size_t>(coordinates.size()));
+    std::iota(order.begin(), order.end(), 0);
+
+    if (coordinates.size() > 3)
+    {
+        DistanceMatrix const distance(coordinates);
+        while (twoOpt(order, distance) || orOpt(order, distance))
+        {
+        }
+    }
+
+    return {order.begin(), order.end()};
+}
@@ -0,0 +1,82 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <QGeoCoordinate>
+#include <QList>
+
+#include "navigation/Leg.h"
+
+
+namespace Navigation::RouteOptimizer {
+
+/*! \brief Best position for inserting a point into a route
+ *
+ *  The cost of inserting the point into a leg is the length of the detour,
+ *  d(start, point) + d(point, end) - d(start, end).  Leg lengths are cached in
+ *  the legs, so that this method computes only one distance per waypoint
+ *  instead of the total length of every candidate route.
+ *
+ *  @param legs Legs of the route
+ *
+ *  @param coordinate Point to be inserted
+ *
+ *  @returns Index of the leg whose detour is shortest, or -1 if there are no
+ *  legs. The point should be inserted between start and end point of this
+ *  leg.
+ */
+[[nodiscard]] qsizetype bestInsertion(const QList<Navigation::Leg>& legs, const QGeoCoordinate& coordinate);
+
+/*! \brief Order of waypoints that shortens a route
+ *
+ *  This method improves the order of the waypoints by local search, keeping
+ *  the first and last waypoint in place.  Two moves are applied until
+ *  neither shortens the route any more.
+ *
+ *  - 2-opt: reverse a section of the route.
+ *
+ *  - Or-opt: move a section of up to maxSegmentLength waypoints, possibly
+ *    reversed, to another place in the route.
+ *
+ *  The result is not necessarily the shortest route, but it is free of the
+ *  obvious detours and crossings. Distances are computed once and stored in a
+ *  matrix, so that the cost of each move is evaluated in constant time.
+ *
+ *  @param coordinates Coordinates of the waypoints. All coordinates must be
+ *  valid.
+ *
+ *  @returns Permutation of the indices of the coordinates. The first index is
+ *  always 0, the last index is always coordinates.size()-1.
+ */
+[[nodiscard]] QList<qsizetype> optimizedOrder(const QList<QGeoCoordinate>& coordinates);
+
+/*! \brief Maximal number of consecutive waypoints moved by Or-opt */
+constexpr qsizetype maxSegmentLength = 3;
+
+/*! \brief Minimal gain for a move, in meters
+ *
+ *  Moves that shorten the route by less are not applied. This guarantees
+ *  that the search terminates in the presence of rounding errors.
+ */
+constexpr double minGainInM = 1.0;
+
+} // namespace Navigation::RouteOptimizer
@@ -0,0 +1,370 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include <algorithm>
+#include <cmath>
+
+#include "navigation/RoutePerformance.h"
+#include "units/Units.h"
+
+
+namespace {
+
+// Ground speed for a given true airspeed, wind vector and true course, or a
+// non-positive value or NaN if the aircraft cannot make progress
+double groundSpeedInMPS(double TASInMPS, double windUInMPS, double windVInMPS, double sinTC, double cosTC)
+{
+    auto const alongTrack = windUInMPS*sinTC + windVInMPS*cosTC;
+    auto const crossTrack = windUInMPS*cosTC - windVInMPS*sinTC;
+    return std::sqrt(TASInMPS*TASInMPS - crossTrack*crossTrack) + alongTrack;
+}
+
+// Field elevation, if the waypoint is an airfield with known elevation
+double fieldElevationInM(const GeoMaps::Waypoint& waypoint)
+{
+    if (waypoint.type() != u"AD")
+    {
+        return qQNaN();
+    }
+    return waypoint.coordinate().altitude();
+}
+
+} // namespace
+
+
+//
+// Methods
+//
+
+QList<Navigation::RoutePerformance::LegPerformance> Navigation::RoutePerformance::compute(const Navigation::Aircraft& aircraft, Weather::Wind wind, Units::Distance cruiseAltitude)
+{
+    QList<LegPerformance> result(m_numLegs);
+    auto const numSteps = static_cast<qsizetype>(m_stepLengthInM.size());
+    if (numSteps == 0)
+    {
+        return result;
+    }
+
+    updateColumns();
+    m_windUInMPS = -wind.speed().toMPS()*wind.directionFrom().sin();
+    m_windVInMPS = -wind.speed().toMPS()*wind.directionFrom().cos();
+
+    //
+    // Vertical profile
+    //
+
+    auto const cruiseInM = cruiseAltitude.toM();
+    std::vector<double> altitudeInM(numSteps, cruiseInM);
+    std::vector<double> TASInMPS(numSteps, aircraft.cruiseSpeed().toMPS());
+    m_boundaryAltitudeInM.assign(numSteps+1, cruiseInM);
+    m_descentBoundaryAltitudeInM.assign(numSteps+1, qQNaN());
+    m_topOfClimbInM = qQNaN();
+    m_topOfDescentInM = qQNaN();
+    auto const hasProfile = cruiseAltitude.isFinite() &&
+                            aircraft.climbSpeed().isFinite() && aircraft.climbRate().isFinite() &&
+                            aircraft.descentSpeed().isFinite() && aircraft.descentRate().isFinite();
+    if (hasProfile)
+    {
+        // Altitude at the step boundaries, if the aircraft climbed from the
+        // departure airfield and never descended. Steps are taken one after
+        // the other, because the climb depends on the wind at the present
+        // altitude.
+        auto const climbTAS = aircraft.climbSpeed().toMPS();
+        std::vector<double> climbBoundaryAltitudeInM(numSteps+1, cruiseInM);
+        if (m_departureElevationInM < cruiseInM)
+        {
+            climbBoundaryAltitudeInM[0] = m_departureElevationInM;
+        }
+        for(qsizetype i=0; (i<numSteps) && (climbBoundaryAltitudeInM[i] < cruiseInM); i++)
+        {
+            auto const altitude = climbBoundaryAltitudeInM[i];
+            auto const local = sample(i, altitude);
+            auto GS = groundSpeedInMPS(climbTAS, local.windUInMPS, local.windVInMPS, m_stepSinTC[i], m_stepCosTC[i]);
+            if (!(GS > 0.0))
+            {
+                GS = climbTAS;
+            }
+            auto const gain = aircraft.climbRate().toMPS()*m_stepLengthInM[i]/GS;
+            if (altitude + gain >= cruiseInM)
+            {
+                m_topOfClimbInM = m_boundaryInM[i] + m_stepLengthInM[i]*(cruiseInM - altitude)/gain;
+            }
+            climbBoundaryAltitudeInM[i+1] = qMin(cruiseInM, altitude + gain);
+        }
+
+        // Same for the descent to the destination airfield, backwards from
+        // the destination. The descent path is continued above cruise
+        // altitude, so that descentDistance() can answer for any altitude.
+        auto const descentTAS = aircraft.descentSpeed().toMPS();
+        m_descentBoundaryAltitudeInM[numSteps] = m_destinationElevationInM;
+        for(auto i=numSteps-1; i>=0; i--)
+        {
+            auto const altitude = m_descentBoundaryAltitudeInM[i+1];
+            auto const local = sample(i, qMin(altitude, cruiseInM));
+            auto GS = groundSpeedInMPS(descentTAS, local.windUInMPS, local.windVInMPS, m_stepSinTC[i], m_stepCosTC[i]);
+            if (!(GS > 0.0))
+            {
+                GS = descentTAS;
+            }
+            auto const gain = aircraft.descentRate().toMPS()*m_stepLengthInM[i]/GS;
+            if ((altitude < cruiseInM) && (altitude + gain >= cruiseInM))
+            {
+                m_topOfDescentInM = m_boundaryInM[i+1] - m_stepLengthInM[i]*(cruiseInM - altitude)/gain;
+            }
+            m_descentBoundaryAltitudeInM[i] = altitude + gain;
+        }
+
+        // The profile follows the lower of the two paths. If they meet below
+        // cruise altitude, there is neither top of climb nor top of descent.
+        for(qsizetype k=0; k<=numSteps; k++)
+        {
+            auto const descent = std::isfinite(m_descentBoundaryAltitudeInM[k]) ? qMin(cruiseInM, m_descentBoundaryAltitudeInM[k]) : cruiseInM;
+            m_boundaryAltitudeInM[k] = qMin(climbBoundaryAltitudeInM[k], descent);
+        }
+        if (m_topOfClimbInM > m_topOfDescentInM)
+        {
+            m_topOfClimbInM = qQNaN();
+            m_topOfDescentInM = qQNaN();
+        }
+
+        for(qsizetype i=0; i<numSteps; i++)
+        {
+            altitudeInM[i] = 0.5*(m_boundaryAltitudeInM[i] + m_boundaryAltitudeInM[i+1]);
+            auto const climbing = climbBoundaryAltitudeInM[i] < cruiseInM;
+            auto const descending = m_descentBoundaryAltitudeInM[i+1] < cruiseInM;
+            if (descending && (!climbing || (m_boundaryAltitudeInM[i] >= m_boundaryAltitudeInM[i+1])))
+            {
+                TASInMPS[i] = descentTAS;
+            }
+            else if (climbing)
+            {
+                TASInMPS[i] = climbTAS;
+            }
+        }
+    }
+
+    //
+    // Wind triangle
+    //
+
+    std::vector<double> windUInMPS(numSteps);
+    std::vector<double> windVInMPS(numSteps);
+    std::vector<double> temperatureInDegC(numSteps);
+    for(qsizetype i=0; i<numSteps; i++)
+    {
+        auto const local = sample(i, altitudeInM[i]);
+        windUInMPS[i] = local.windUInMPS;
+        windVInMPS[i] = local.windVInMPS;
+        temperatureInDegC[i] = local.temperatureInDegC;
+    }
+
+    // This loop has no calls and no data-dependent control flow
+    std::vector<double> timeInS(numSteps);
+    for(qsizetype i=0; i<numSteps; i++)
+    {
+        auto const GS = groundSpeedInMPS(TASInMPS[i], windUInMPS[i], windVInMPS[i], m_stepSinTC[i], m_stepCosTC[i]);
+        timeInS[i] = (GS > 0.0) ? m_stepLengthInM[i]/GS : qQNaN();
+        timeInS[i] = (m_stepLengthInM[i] == 0.0) ? 0.0 : timeInS[i];
+    }
+
+    //
+    // Sum up by leg
+    //
+
+    std::vector<double> legTimeInS(m_numLegs, 0.0);
+    std::vector<double> legLengthInM(m_numLegs, 0.0);
+    std::vector<double> legTemperatureTimesTime(m_numLegs, 0.0);
+    for(qsizetype i=0; i<numSteps; i++)
+    {
+        auto const leg = m_stepLeg[i];
+        legTimeInS[leg] += timeInS[i];
+        legLengthInM[leg] += m_stepLengthInM[i];
+        legTemperatureTimesTime[leg] += temperatureInDegC[i]*timeInS[i];
+    }
+    for(qsizetype leg=0; leg<m_numLegs; leg++)
+    {
+        auto& legPerformance = result[leg];
+        legPerformance.altitudeAtStart = Units::Distance::fromM(m_boundaryAltitudeInM[m_legFirstStep[leg]]);
+        legPerformance.altitudeAtEnd = Units::Distance::fromM(m_boundaryAltitudeInM[m_legFirstStep[leg+1]]);
+        legPerformance.ETE = Units::Timespan::fromS(legTimeInS[leg]);
+        legPerformance.fuel = aircraft.fuelConsumption()*legPerformance.ETE;
+        if (legTimeInS[leg] > 0.0)
+        {
+            legPerformance.GS = Units::Speed::fromMPS(legLengthInM[leg]/legTimeInS[leg]);
+            legPerformance.OAT = Units::Temperature::fromDegreeCelsius(legTemperatureTimesTime[leg]/legTimeInS[leg]);
+        }
+    }
+    return result;
+}
+
+
+Units::Distance Navigation::RoutePerformance::descentDistance(Units::Distance altitude) const
+{
+    auto const altitudeInM = altitude.toM();
+    if (m_descentBoundaryAltitudeInM.empty() ||
+        !std::isfinite(altitudeInM) ||
+        !std::isfinite(m_descentBoundaryAltitudeInM.back()))
+    {
+        return {};
+    }
+    auto const totalInM = m_boundaryInM.back();
+    if (altitudeInM <= m_descentBoundaryAltitudeInM.back())
+    {
+        return Units::Distance::fromM(0.0);
+    }
+
+    // The descent path rises monotonically from the destination backwards.
+    // Find the last boundary at which it is still at or above the altitude.
+    auto const numSteps = static_cast<qsizetype>(m_descentBoundaryAltitudeInM.size()) - 1;
+    if (altitudeInM > m_descentBoundaryAltitudeInM.front())
+    {
+        // Above the path at the start of the route: extrapolate with the
+        // mean gradient of the path.
+        auto const gradient = (m_descentBoundaryAltitudeInM.front() - m_descentBoundaryAltitudeInM.back())/totalInM;
+        if (!(gradient > 0.0))
+        {
+            return {};
+        }
+        return Units::Distance::fromM((altitudeInM - m_descentBoundaryAltitudeInM.back())/gradient);
+    }
+    qsizetype low = 0;
+    qsizetype high = numSteps;
+    while (high - low > 1)
+    {
+        auto const mid = (low + high)/2;
+        if (m_descentBoundaryAltitudeInM[mid] >= altitudeInM)
+        {
+            low = mid;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    auto const upper = m_descentBoundaryAltitudeInM[low];
+    auto const lower = m_descentBoundaryAltitudeInM[high];
+    auto const fraction = (upper > lower) ? (altitudeInM - lower)/(upper - lower) : 0.0;
+    auto const alongInM = m_boundaryInM[high] - fraction*(m_boundaryInM[high] - m_boundaryInM[low]);
+    return Units::Distance::fromM(totalInM - alongInM);
+}
+
+
+bool Navigation::RoutePerformance::windFieldCoversRoute() const
+{
+    if (m_columns.empty())
+    {
+        return false;
+    }
+    return std::ranges::none_of(m_columns, [](const auto& column) { return column.empty(); });
+}
+
+
+void Navigation::RoutePerformance::setRoute(const QList<Navigation::Leg>& legs)
+{
+    m_stepLeg.clear();
+    m_stepCoordinate.clear();
+    m_stepLengthInM.clear();
+    m_stepSinTC.clear();
+    m_stepCosTC.clear();
+    m_boundaryInM.assign(1, 0.0);
+    m_legFirstStep.assign(1, 0);
+    m_boundaryAltitudeInM.clear();
+    m_descentBoundaryAltitudeInM.clear();
+    m_topOfClimbInM = qQNaN();
+    m_topOfDescentInM = qQNaN();
+    m_columns.clear();
+    m_numLegs = legs.size();
+    m_departureElevationInM = qQNaN();
+    m_destinationElevationInM = qQNaN();
+    if (legs.isEmpty())
+    {
+        return;
+    }
+    m_departureElevationInM = fieldElevationInM(legs.first().startPoint());
+    m_destinationElevationInM = fieldElevationInM(legs.last().endPoint());
+
+    for(qsizetype leg=0; leg<legs.size(); leg++)
+    {
+        auto const start = legs[leg].startPoint().coordinate();
+        auto const end = legs[leg].endPoint().coordinate();
+        auto const lengthInM = legs[leg].distance().toM();
+        auto const azimuth = start.azimuthTo(end);
+
+        // Cut the leg into steps of equal length
+        qsizetype numSteps = 1;
+        if (std::isfinite(lengthInM))
+        {
+            numSteps = qMax(numSteps, static_cast<qsizetype>(std::ceil(lengthInM/stepLengthInM)));
+        }
+        auto const stepInM = lengthInM/static_cast<double>(numSteps);
+        for(qsizetype step=0; step<numSteps; step++)
+        {
+            auto const midpoint = start.atDistanceAndAzimuth((static_cast<double>(step)+0.5)*stepInM, azimuth);
+            auto const course = (stepInM > 0.0) ? qDegreesToRadians(midpoint.azimuthTo(end)) : 0.0;
+            m_stepLeg.push_back(leg);
+            m_stepCoordinate.push_back(midpoint);
+            m_stepLengthInM.push_back(stepInM);
+            m_stepSinTC.push_back(std::sin(course));
+            m_stepCosTC.push_back(std::cos(course));
+            m_boundaryInM.push_back(m_boundaryInM.back() + (std::isfinite(stepInM) ? stepInM : 0.0));
+        }
+        m_legFirstStep.push_back(static_cast<qsizetype>(m_stepLengthInM.size()));
+    }
+}
+
+
+void Navigation::RoutePerformance::setWindField(std::shared_ptr<const Weather::WindField> windField)
+{
+    if (windField == m_windField)
+    {
+        return;
+    }
+    m_windField = std::move(windField);
+    m_columns.clear();
+}
+
+
+Weather::WindField::Sample Navigation::RoutePerformance::sample(qsizetype step, double altitudeInM) const
+{
+    if (!m_columns.empty() && std::isfinite(altitudeInM))
+    {
+        const auto& column = m_columns[step];
+        if (!column.empty())
+        {
+            return m_windField->interpolate(column, altitudeInM);
+        }
+    }
+    return {m_windUInMPS, m_windVInMPS, qQNaN()};
+}
+
+
+void Navigation::RoutePerformance::updateColumns()
+{
+    if (!m_columns.empty() || !m_windField || !m_windField->isValid())
+    {
+        return;
+    }
+    m_columns.reserve(m_stepCoordinate.size());
+    for(const auto& coordinate : m_stepCoordinate)
+    {
+        m_columns.push_back(m_windField->column(coordinate));
+    }
+}
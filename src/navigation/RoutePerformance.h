@@ -0,0 +1,235 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "navigation/Aircraft.h"
+#include "navigation/Leg.h"
+#include "units/Distance.h"
+#include "units/Temperature.h"
+#include "units/Timespan.h"
+#include "units/Volume.h"
+#include "weather/Wind.h"
+#include "weather/WindField.h"
+
+
+namespace Navigation {
+
+/*! \brief Flight performance along a route, with winds aloft
+ *
+ *  This class computes time and fuel for the legs of a flight route. Unlike
+ *  Leg::ETE() and Leg::Fuel(), which apply one wind and the cruise speed to
+ *  the whole leg, this class follows a vertical profile and looks up wind and
+ *  temperature along the way.
+ *
+ *  - The legs are cut into steps of at most stepLengthInM. Position, course
+ *    and length of every step are computed once, when the route is set.
+ *
+ *  - The aircraft climbs from the departure airfield to the cruise altitude
+ *    with climb speed and climb rate, and descends to the destination
+ *    airfield with descent speed and descent rate. If no cruise altitude is
+ *    set or if the aircraft data is incomplete, the whole route is flown at
+ *    cruise speed.
+ *
+ *  - If a wind field is set, the wind field is interpolated horizontally at
+ *    every step. These columns are cached until the route or the wind field
+ *    change, so that a change of aircraft, cruise altitude or wind only
+ *    requires vertical interpolation. Outside of the wind field, the
+ *    estimated wind is used.
+ *
+ *  - The vertical profile, including top of climb and top of descent, is
+ *    available after compute().
+ *
+ *  - The wind triangle is solved for all steps at once, in a loop over
+ *    contiguous arrays that the compiler can vectorize.
+ *
+ *  The methods in this class are reentrant, but not thread safe.
+ */
+
+class RoutePerformance
+{
+public:
+    /*! \brief Performance on one leg */
+    struct LegPerformance
+    {
+        /*! \brief Time en route */
+        Units::Timespan ETE;
+
+        /*! \brief Fuel consumption */
+        Units::Volume fuel;
+
+        /*! \brief Mean ground speed */
+        Units::Speed GS;
+
+        /*! \brief Mean outside air temperature, weighted by time */
+        Units::Temperature OAT;
+
+        /*! \brief Planned altitude at the start of the leg, MSL */
+        Units::Distance altitudeAtStart;
+
+        /*! \brief Planned altitude at the end of the leg, MSL */
+        Units::Distance altitudeAtEnd;
+    };
+
+    /*! \brief Standard constructor */
+    RoutePerformance() = default;
+
+
+    //
+    // Getter Methods
+    //
+
+    /*! \brief Top of climb
+     *
+     *  @returns Distance from the start of the route at which the aircraft
+     *  reaches cruise altitude, as computed by the last call to compute(). This
+     *  is NaN if the route does not start at an airfield, if the vertical
+     *  profile is unknown or if cruise altitude is never reached.
+     */
+    [[nodiscard]] Units::Distance topOfClimb() const
+    {
+        return Units::Distance::fromM(m_topOfClimbInM);
+    }
+
+    /*! \brief Top of descent
+     *
+     *  @returns Distance from the start of the route at which the aircraft
+     *  leaves cruise altitude, as computed by the last call to compute(). This
+     *  is NaN if the route does not end at an airfield, if the vertical
+     *  profile is unknown or if cruise altitude is never reached.
+     */
+    [[nodiscard]] Units::Distance topOfDescent() const
+    {
+        return Units::Distance::fromM(m_topOfDescentInM);
+    }
+
+    /*! \brief Coverage of the route by the wind field
+     *
+     *  @returns True if a wind field is set and has data at every step of the
+     *  route. If false, compute() falls back to the estimated wind where the
+     *  wind field has no data.
+     */
+    [[nodiscard]] bool windFieldCoversRoute() const;
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Compute performance
+     *
+     *  @param aircraft Aircraft in use
+     *
+     *  @param wind Estimated wind, used wherever the wind field has no data
+     *
+     *  @param cruiseAltitude Planned cruise altitude, MSL. This can be NaN.
+     *
+     *  @returns Performance for every leg of the route. Values are NaN if the
+     *  aircraft data or the wind is insufficient.
+     */
+    [[nodiscard]] QList<LegPerformance> compute(const Navigation::Aircraft& aircraft, Weather::Wind wind, Units::Distance cruiseAltitude);
+
+    /*! \brief Distance needed for the descent
+     *
+     *  This method looks up the descent path computed by the last call to
+     *  compute(). It takes logarithmic time in the length of the route.
+     *
+     *  @param altitude Altitude, MSL
+     *
+     *  @returns Distance before the destination at which a descent from the
+     *  given altitude needs to begin, or NaN if the descent path is unknown
+     */
+    [[nodiscard]] Units::Distance descentDistance(Units::Distance altitude) const;
+
+    /*! \brief Set route
+     *
+     *  The route is cut into steps. This takes time linear in the length of
+     *  the route. The column cache is cleared.
+     *
+     *  @param legs Legs of the route
+     */
+    void setRoute(const QList<Navigation::Leg>& legs);
+
+    /*! \brief Set wind field
+     *
+     *  The column cache is cleared if the wind field differs from the one
+     *  previously set.
+     *
+     *  @param windField Wind field, or nullptr
+     */
+    void setWindField(std::shared_ptr<const Weather::WindField> windField);
+
+
+    //
+    // Constants
+    //
+
+    /*! \brief Maximal length of a step */
+    static constexpr double stepLengthInM = 1852.0;
+
+private:
+    // Fills m_columns, unless already done
+    void updateColumns();
+
+    // Wind and temperature at a step
+    [[nodiscard]] Weather::WindField::Sample sample(qsizetype step, double altitudeInM) const;
+
+    // Geometry of the steps. Coordinates are the midpoints of the steps, sine
+    // and cosine are those of the true course at the midpoint.
+    std::vector<qsizetype> m_stepLeg;
+    std::vector<QGeoCoordinate> m_stepCoordinate;
+    std::vector<double> m_stepLengthInM;
+    std::vector<double> m_stepSinTC;
+    std::vector<double> m_stepCosTC;
+    qsizetype m_numLegs {0};
+
+    // Distance from the start of the route to the step boundaries, and index
+    // of the first step of every leg. Both have one more entry than there are
+    // steps or legs.
+    std::vector<double> m_boundaryInM;
+    std::vector<qsizetype> m_legFirstStep;
+
+    // Vertical profile at the step boundaries, and descent path to the
+    // destination at the step boundaries, continued above cruise altitude
+    std::vector<double> m_boundaryAltitudeInM;
+    std::vector<double> m_descentBoundaryAltitudeInM;
+    double m_topOfClimbInM {qQNaN()};
+    double m_topOfDescentInM {qQNaN()};
+
+    // Field elevations of departure and destination, or NaN if the route
+    // does not start or end at an airfield
+    double m_departureElevationInM {qQNaN()};
+    double m_destinationElevationInM {qQNaN()};
+
+    // Wind field and cached columns, one per step. The cache is empty if it
+    // needs to be filled.
+    std::shared_ptr<const Weather::WindField> m_windField;
+    std::vector<std::vector<Weather::WindField::Sample>> m_columns;
+
+    // Estimated wind, as components of the wind vector in m/s
+    double m_windUInMPS {qQNaN()};
+    double m_windVInMPS {qQNaN()};
+};
+
+} // namespace Navigation
@@ -0,0 +1,136 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include "navigation/RouteProgressTracker.h"
+
+
+//
+// Methods
+//
+
+void Navigation::RouteProgressTracker::invalidate()
+{
+    m_valid = false;
+    m_currentLeg = -1;
+}
+
+
+Units::Distance Navigation::RouteProgressTracker::remainingDistance(qsizetype index) const
+{
+    if ((index < 0) || (index >= m_legs.size()))
+    {
+        return {};
+    }
+    return m_remainingDistance[index];
+}
+
+
+Units::Timespan Navigation::RouteProgressTracker::remainingETE(qsizetype index) const
+{
+    if ((index < 0) || (index >= m_legs.size()))
+    {
+        return {};
+    }
+    return m_remainingETE[index];
+}
+
+
+Units::Volume Navigation::RouteProgressTracker::remainingFuel(qsizetype index) const
+{
+    if ((index < 0) || (index >= m_legs.size()))
+    {
+        return {};
+    }
+    return m_remainingFuel[index];
+}
+
+
+void Navigation::RouteProgressTracker::setRoute(const QList<Navigation::Leg>& legs, Weather::Wind wind, const Navigation::Aircraft& aircraft)
+{
+    if (legs.size() != m_legs.size())
+    {
+        m_currentLeg = -1;
+    }
+    m_legs = legs;
+
+    auto const count = static_cast<std::size_t>(m_legs.size());
+    m_remainingDistance.assign(count, Units::Distance::fromM(0.0));
+    m_remainingETE.assign(count, Units::Timespan::fromS(0.0));
+    m_remainingFuel.assign(count, Units::Volume::fromL(0.0));
+    for(auto i = m_legs.size()-2; i >= 0; i--)
+    {
+        const auto& next = m_legs[i+1];
+        m_remainingDistance[i] = m_remainingDistance[i+1];
+        m_remainingDistance[i] += next.distance();
+        m_remainingETE[i] = m_remainingETE[i+1];
+        m_remainingETE[i] += next.ETE(wind, aircraft);
+        m_remainingFuel[i] = m_remainingFuel[i+1];
+        m_remainingFuel[i] += next.Fuel(wind, aircraft);
+    }
+    m_valid = true;
+}
+
+
+qsizetype Navigation::RouteProgressTracker::update(const Positioning::PositionInfo& positionInfo)
+{
+    if (m_legs.isEmpty())
+    {
+        m_currentLeg = -1;
+        return -1;
+    }
+
+    // Test legs near the current leg first
+    if (m_currentLeg >= 0)
+    {
+        auto const first = qMax(static_cast<qsizetype>(0), m_currentLeg-1);
+        auto const last = qMin(m_legs.size()-1, m_currentLeg+searchWindow);
+        auto const leg = find(positionInfo, first, last);
+        if (leg >= 0)
+        {
+            m_currentLeg = leg;
+            return leg;
+        }
+    }
+
+    // Test all legs
+    m_currentLeg = find(positionInfo, 0, m_legs.size()-1);
+    return m_currentLeg;
+}
+
+
+qsizetype Navigation::RouteProgressTracker::find(const Positioning::PositionInfo& positionInfo, qsizetype first, qsizetype last) const
+{
+    for(auto i = last; i >= first; i--)
+    {
+        if (m_legs[i].isFollowing(positionInfo))
+        {
+            return i;
+        }
+    }
+    for(auto i = last; i >= first; i--)
+    {
+        if (m_legs[i].isNear(positionInfo))
+        {
+            return i;
+        }
+    }
+    return -1;
+}
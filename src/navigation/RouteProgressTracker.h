@@ -0,0 +1,175 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <vector>
+
+#include "navigation/Aircraft.h"
+#include "navigation/Leg.h"
+#include "positioning/PositionInfo.h"
+#include "units/Distance.h"
+#include "units/Timespan.h"
+#include "units/Volume.h"
+#include "weather/Wind.h"
+
+
+namespace Navigation {
+
+/*! \brief Progress of the own aircraft along a flight route
+ *
+ *  This class finds the leg of a flight route that the own aircraft is
+ *  currently flying, and provides the distance, time and fuel for the legs
+ *  that follow.  It is designed to be called on every position update, at
+ *  constant cost independent of the length of the route.
+ *
+ *  - The class remembers the current leg. On a position update, only the
+ *    legs in a small window around the current leg are tested.  All legs are
+ *    tested only if no current leg is known, or if the aircraft has left the
+ *    window.
+ *
+ *  - When the route is set, the class computes suffix sums of distance, ETE
+ *    and fuel, so that the totals for the remaining legs can be looked up.
+ *    Call invalidate() whenever the route, the wind or the aircraft changes.
+ */
+
+class RouteProgressTracker
+{
+public:
+    /*! \brief Standard constructor */
+    RouteProgressTracker() = default;
+
+
+    //
+    // Getter Methods
+    //
+
+    /*! \brief Check if route data is up to date
+     *
+     *  @returns False if invalidate() has been called since the last call to
+     *  setRoute()
+     */
+    [[nodiscard]] bool isValid() const
+    {
+        return m_valid;
+    }
+
+    /*! \brief Legs of the route
+     *
+     *  @returns Legs, as set with setRoute()
+     */
+    [[nodiscard]] const QList<Navigation::Leg>& legs() const
+    {
+        return m_legs;
+    }
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Mark route data as outdated
+     *
+     *  The current leg is forgotten.
+     */
+    void invalidate();
+
+    /*! \brief Distance of the legs after a given leg
+     *
+     *  @param index Index of a leg
+     *
+     *  @returns Sum of the distances of all legs with index larger than
+     *  index. This is zero for the last leg.
+     */
+    [[nodiscard]] Units::Distance remainingDistance(qsizetype index) const;
+
+    /*! \brief ETE of the legs after a given leg
+     *
+     *  @param index Index of a leg
+     *
+     *  @returns Sum of the ETEs of all legs with index larger than index. This
+     *  is NaN if the ETE of one of these legs is unknown.
+     */
+    [[nodiscard]] Units::Timespan remainingETE(qsizetype index) const;
+
+    /*! \brief Fuel consumption on the legs after a given leg
+     *
+     *  @param index Index of a leg
+     *
+     *  @returns Sum of the fuel consumption of all legs with index larger than
+     *  index. This is NaN if the consumption on one of these legs is unknown.
+     */
+    [[nodiscard]] Units::Volume remainingFuel(qsizetype index) const;
+
+    /*! \brief Set route and compute suffix sums
+     *
+     *  This method takes time linear in the number of legs. The current leg
+     *  is kept if the number of legs does not change.
+     *
+     *  @param legs Legs of the route
+     *
+     *  @param wind Estimated wind
+     *
+     *  @param aircraft Aircraft in use
+     */
+    void setRoute(const QList<Navigation::Leg>& legs, Weather::Wind wind, const Navigation::Aircraft& aircraft);
+
+    /*! \brief Find current leg
+     *
+     *  The current leg is the last leg that the position is following, see
+     *  Leg::isFollowing(). If there is no such leg, it is the last leg that
+     *  the position is near to, see Leg::isNear(). Legs in the window around
+     *  the previous current leg are preferred over all others.
+     *
+     *  @param positionInfo Position of the own aircraft
+     *
+     *  @returns Index of the current leg, or -1 if the position is off route
+     */
+    [[nodiscard]] qsizetype update(const Positioning::PositionInfo& positionInfo);
+
+
+    //
+    // Constants
+    //
+
+    /*! \brief Number of legs after the current leg that are tested on update */
+    static constexpr qsizetype searchWindow = 2;
+
+private:
+    // Returns the current leg among the legs first, ..., last, or -1
+    [[nodiscard]] qsizetype find(const Positioning::PositionInfo& positionInfo, qsizetype first, qsizetype last) const;
+
+    // Legs of the route
+    QList<Navigation::Leg> m_legs;
+
+    // Suffix sums. Entry i holds the total for the legs i+1, ..., n-1.
+    std::vector<Units::Distance> m_remainingDistance;
+    std::vector<Units::Timespan> m_remainingETE;
+    std::vector<Units::Volume> m_remainingFuel;
+
+    // Index of the current leg, or -1
+    qsizetype m_currentLeg {-1};
+
+    // False if the suffix sums are outdated
+    bool m_valid {false};
+};
+
+} // namespace Navigation
@@ -0,0 +1,152 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include <cmath>
+
+#include "GlobalObject.h"
+#include "geomaps/GeoMapProvider.h"
+#include "navigation/VerticalProfile.h"
+
+
+//
+// Methods
+//
+
+void Navigation::VerticalProfile::compute(const Navigation::Aircraft& aircraft, Weather::Wind wind, std::shared_ptr<const Weather::WindField> windField, Units::Distance cruiseAltitude)
+{
+    if (m_maximumTerrainAheadInM.empty())
+    {
+        sampleTerrain();
+    }
+
+    m_performance.setWindField(std::move(windField));
+    auto const performance = m_performance.compute(aircraft, wind, cruiseAltitude);
+
+    m_legProfiles.clear();
+    m_legProfiles.reserve(performance.size());
+    for(qsizetype i=0; i<performance.size(); i++)
+    {
+        LegProfile profile;
+        profile.altitudeAtStart = performance[i].altitudeAtStart;
+        profile.altitudeAtEnd = performance[i].altitudeAtEnd;
+        profile.maximumTerrain = Units::Distance::fromM(m_maximumTerrainInM[i]);
+        m_legProfiles.append(profile);
+    }
+    m_topOfClimb = pointAt(m_performance.topOfClimb());
+    m_topOfDescent = pointAt(m_performance.topOfDescent());
+    m_valid = true;
+}
+
+
+Units::Distance Navigation::VerticalProfile::distanceToTopOfDescent(Units::Distance distanceToDestination, Units::Distance altitude) const
+{
+    auto const descentDistance = m_performance.descentDistance(altitude);
+    if (!descentDistance.isFinite() || !distanceToDestination.isFinite())
+    {
+        return {};
+    }
+    return qMax(distanceToDestination - descentDistance, Units::Distance::fromM(0.0));
+}
+
+
+Units::Distance Navigation::VerticalProfile::maximumTerrainAhead(qsizetype leg) const
+{
+    if ((leg < 0) || (leg >= static_cast<qsizetype>(m_maximumTerrainAheadInM.size())))
+    {
+        return {};
+    }
+    return Units::Distance::fromM(m_maximumTerrainAheadInM[leg]);
+}
+
+
+QGeoCoordinate Navigation::VerticalProfile::pointAt(Units::Distance distanceFromStart) const
+{
+    if (!distanceFromStart.isFinite())
+    {
+        return {};
+    }
+
+    auto remainingInM = distanceFromStart.toM();
+    for(const auto& leg : m_legs)
+    {
+        auto const lengthInM = leg.distance().toM();
+        if (remainingInM <= lengthInM)
+        {
+            auto const start = leg.startPoint().coordinate();
+            return start.atDistanceAndAzimuth(remainingInM, start.azimuthTo(leg.endPoint().coordinate()));
+        }
+        remainingInM -= lengthInM;
+    }
+    return {};
+}
+
+
+void Navigation::VerticalProfile::sampleTerrain()
+{
+    auto* geoMapProvider = GlobalObject::geoMapProvider();
+
+    m_maximumTerrainInM.assign(m_legs.size(), qQNaN());
+    for(qsizetype i=0; i<m_legs.size(); i++)
+    {
+        auto const start = m_legs[i].startPoint().coordinate();
+        auto const end = m_legs[i].endPoint().coordinate();
+        auto const lengthInM = m_legs[i].distance().toM();
+        if (!std::isfinite(lengthInM))
+        {
+            continue;
+        }
+        auto const azimuth = start.azimuthTo(end);
+        auto const numSamples = static_cast<qsizetype>(std::ceil(lengthInM/terrainSampleDistanceInM));
+        for(qsizetype j=0; j<=numSamples; j++)
+        {
+            auto const coordinate = (j == numSamples) ? end : start.atDistanceAndAzimuth(static_cast<double>(j)*terrainSampleDistanceInM, azimuth);
+            auto const elevationInM = geoMapProvider->terrainElevationAMSL(coordinate).toM();
+            if (std::isfinite(elevationInM) && !(elevationInM <= m_maximumTerrainInM[i]))
+            {
+                m_maximumTerrainInM[i] = elevationInM;
+            }
+        }
+    }
+
+    // Suffix maxima
+    m_maximumTerrainAheadInM = m_maximumTerrainInM;
+    for(auto i=static_cast<qsizetype>(m_maximumTerrainAheadInM.size())-2; i>=0; i--)
+    {
+        auto const next = m_maximumTerrainAheadInM[i+1];
+        if (std::isfinite(next) && !(next <= m_maximumTerrainAheadInM[i]))
+        {
+            m_maximumTerrainAheadInM[i] = next;
+        }
+    }
+}
+
+
+void Navigation::VerticalProfile::setRoute(const QList<Navigation::Leg>& legs)
+{
+    m_legs = legs;
+    m_performance.setRoute(legs);
+    m_maximumTerrainAheadInM.clear();
+    m_maximumTerrainInM.clear();
+    m_legProfiles.clear();
+    m_topOfClimb = {};
+    m_topOfDescent = {};
+    m_valid = false;
+}
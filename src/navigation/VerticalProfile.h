@@ -0,0 +1,213 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "navigation/Aircraft.h"
+#include "navigation/Leg.h"
+#include "navigation/RoutePerformance.h"
+#include "units/Distance.h"
+#include "weather/Wind.h"
+#include "weather/WindField.h"
+
+
+namespace Navigation {
+
+/*! \brief Vertical profile of a flight route
+ *
+ *  This class combines the vertical profile computed by RoutePerformance with
+ *  the terrain along the route. It provides the top of climb, the top of
+ *  descent and a leg-by-leg profile, and it answers questions that come up
+ *  on every position update at a cost independent of the length of the
+ *  route.
+ *
+ *  - Terrain is sampled from the terrain maps once, the first time that the
+ *    profile is computed after the route has been set.
+ *
+ *  - The profile is computed once, when compute() is called. Call
+ *    invalidate() whenever aircraft, wind or cruise altitude change.
+ *
+ *  - distanceToTopOfDescent() takes logarithmic time and
+ *    maximumTerrainAhead() takes constant time.
+ *
+ *  The methods in this class are reentrant, but not thread safe.
+ */
+
+class VerticalProfile
+{
+public:
+    /*! \brief Vertical profile of one leg */
+    struct LegProfile
+    {
+        /*! \brief Planned altitude at the start of the leg, MSL */
+        Units::Distance altitudeAtStart;
+
+        /*! \brief Planned altitude at the end of the leg, MSL */
+        Units::Distance altitudeAtEnd;
+
+        /*! \brief Highest terrain along the leg, MSL */
+        Units::Distance maximumTerrain;
+    };
+
+    /*! \brief Standard constructor */
+    VerticalProfile() = default;
+
+
+    //
+    // Getter Methods
+    //
+
+    /*! \brief Check if the profile is up to date
+     *
+     *  @returns False if the route has been set or invalidate() has been
+     *  called since the last call to compute()
+     */
+    [[nodiscard]] bool isValid() const
+    {
+        return m_valid;
+    }
+
+    /*! \brief Leg-by-leg profile
+     *
+     *  @returns Profile for every leg, as computed by the last call to
+     *  compute()
+     */
+    [[nodiscard]] const QList<LegProfile>& legs() const
+    {
+        return m_legProfiles;
+    }
+
+    /*! \brief Top of climb
+     *
+     *  @returns Point where the aircraft reaches cruise altitude, or an
+     *  invalid coordinate, see RoutePerformance::topOfClimb()
+     */
+    [[nodiscard]] QGeoCoordinate topOfClimb() const
+    {
+        return m_topOfClimb;
+    }
+
+    /*! \brief Top of descent
+     *
+     *  @returns Point where the aircraft leaves cruise altitude, or an
+     *  invalid coordinate, see RoutePerformance::topOfDescent()
+     */
+    [[nodiscard]] QGeoCoordinate topOfDescent() const
+    {
+        return m_topOfDescent;
+    }
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Compute profile
+     *
+     *  @param aircraft Aircraft in use
+     *
+     *  @param wind Estimated wind
+     *
+     *  @param windField Winds aloft, or nullptr
+     *
+     *  @param cruiseAltitude Planned cruise altitude, MSL
+     */
+    void compute(const Navigation::Aircraft& aircraft, Weather::Wind wind, std::shared_ptr<const Weather::WindField> windField, Units::Distance cruiseAltitude);
+
+    /*! \brief Distance to the top of descent
+     *
+     *  This method computes where the descent to the destination needs to
+     *  begin, given the present altitude of the aircraft.
+     *
+     *  @param distanceToDestination Remaining distance to the destination
+     *
+     *  @param altitude Present altitude, MSL
+     *
+     *  @returns Distance to the point where the descent needs to begin. This is
+     *  zero if the descent should already have begun, and NaN if the descent
+     *  path is unknown.
+     */
+    [[nodiscard]] Units::Distance distanceToTopOfDescent(Units::Distance distanceToDestination, Units::Distance altitude) const;
+
+    /*! \brief Mark profile as outdated */
+    void invalidate()
+    {
+        m_valid = false;
+    }
+
+    /*! \brief Highest terrain ahead
+     *
+     *  @param leg Index of the current leg
+     *
+     *  @returns Highest terrain along the given leg and all legs that follow,
+     *  MSL, or NaN if the terrain is unknown
+     */
+    [[nodiscard]] Units::Distance maximumTerrainAhead(qsizetype leg) const;
+
+    /*! \brief Set route
+     *
+     *  This method only stores the legs. The expensive work is done by
+     *  compute().
+     *
+     *  @param legs Legs of the route
+     */
+    void setRoute(const QList<Navigation::Leg>& legs);
+
+
+    //
+    // Constants
+    //
+
+    /*! \brief Distance between terrain samples along a leg */
+    static constexpr double terrainSampleDistanceInM = 500.0;
+
+private:
+    // Samples terrain along the legs and fills m_maximumTerrainAheadInM
+    void sampleTerrain();
+
+    // Point at a given distance from the start of the route, or an invalid
+    // coordinate if the distance is NaN
+    [[nodiscard]] QGeoCoordinate pointAt(Units::Distance distanceFromStart) const;
+
+    // Legs of the route
+    QList<Navigation::Leg> m_legs;
+
+    // Performance engine, computes the vertical profile
+    RoutePerformance m_performance;
+
+    // Highest terrain on leg i and all following legs, or NaN if unknown.
+    // Empty if the terrain needs to be sampled.
+    std::vector<double> m_maximumTerrainAheadInM;
+    std::vector<double> m_maximumTerrainInM;
+
+    // Results
+    QList<LegProfile> m_legProfiles;
+    QGeoCoordinate m_topOfClimb;
+    QGeoCoordinate m_topOfDescent;
+
+    // False if the results are outdated
+    bool m_valid {false};
+};
+
+} // namespace Navigation
@@ -22,6 +22,7 @@
 #include <QJsonDocument>
 #include <QtGlobal>
 
+#include "navigation/Geodesy.h"
 #include "notam/NOTAMList.h"
 #include "notam/NOTAMProvider.h"
 
@@ -160,8 +161,20 @@ NOTAM::NOTAMList NOTAM::NOTAMList::restricted(const GeoMaps::Waypoint& waypoint)
 
     result.m_region = QGeoCircle(waypoint.coordinate(), radius);
 
-    foreach(auto notam, m_notams)
+    // Distances from the waypoint to all NOTAMs, computed in one batch
+    Navigation::Geodesy::PointArray points;
+    points.reserve(m_notams.size());
+    foreach(const auto& notam, m_notams)
+    {
+        points.append(notam.coordinate());
+    }
+    std::vector<double> squaredChords(m_notams.size());
+    points.squaredChords(Navigation::Geodesy::Point(waypoint.coordinate()), squaredChords.data());
+    auto const maxSquaredChord = Navigation::Geodesy::squaredChordForDistance(restrictionRadius.toM());
+
+    for(qsizetype i=0; i<m_notams.size(); i++)
     {
+        auto notam = m_notams[i];
         if (!notam.isValid())
         {
             continue;
@@ -170,7 +183,7 @@ NOTAM::NOTAMList NOTAM::NOTAMList::restricted(const GeoMaps::Waypoint& waypoint)
         {
             continue;
         }
-        if (notam.coordinate().distanceTo(waypoint.coordinate()) > restrictionRadius.toM())
+        if (squaredChords[i] > maxSquaredChord)
         {
             continue;
         }
@@ -31,6 +31,7 @@
 #include "notification/NotificationManager.h"
 #include "notification/Notification_DataUpdateAvailable.h"
 #include "platform/PlatformAdaptor_Abstract.h"
+#include "positioning/PositionProvider.h"
 #include "traffic/TrafficDataProvider.h"
 #include <chrono>
 
@@ -79,6 +80,10 @@ void Notifications::NotificationManager::deferredInitialization()
     mapsAndDataNotificationTimer.setSingleShot(true);
 
     onMapAndDataUpdateSizeChanged();
+
+    // Airspaces
+    connect(GlobalObject::positionProvider(), &Positioning::PositionProvider::positionInfoChanged,
+            this, &Notifications::NotificationManager::onPositionInfoChanged);
 }
 
 
@@ -330,6 +335,41 @@ void Notifications::NotificationManager::onMapAndDataUpdateSizeChanged()
     settings.setValue(QStringLiteral("lastGeoMapUpdateNotification"), QDateTime::currentDateTimeUtc());
 }
 
+void Notifications::NotificationManager::onPositionInfoChanged()
+{
+    auto const changed = m_airspaceMonitor.update(GlobalObject::positionProvider()->positionInfo(),
+                                                  GlobalObject::navigator()->airspaceIndex());
+    const auto& warning = m_airspaceMonitor.warning();
+
+    if (changed && !m_airspaceNotification.isNull())
+    {
+        m_airspaceNotification->deleteLater();
+    }
+    if (!warning.airspace.isValid())
+    {
+        return;
+    }
+
+    auto const minutes = qMax(1, qRound(warning.timeToEntry.toM()));
+    auto const bounds = u"%1 – %2"_qs.arg(warning.airspace.lowerBound(), warning.airspace.upperBound());
+    auto const text = tr("%1 %2, %3. Entry predicted in %n minute(s).", nullptr, minutes).arg(warning.airspace.CAT(), warning.airspace.name(), bounds);
+
+    if (changed)
+    {
+        m_airspaceNotification = new Notifications::Notification(tr("Airspace ahead"), Notifications::Notification::Warning_Navigation);
+        m_airspaceNotification->setText(text);
+        m_airspaceNotification->setReactionTime(warning.timeToEntry);
+        m_airspaceNotification->setSpokenText(tr("Airspace %1 ahead, %n minute(s).", nullptr, minutes).arg(warning.airspace.name()));
+        addNotification(m_airspaceNotification);
+        return;
+    }
+    if (!m_airspaceNotification.isNull())
+    {
+        m_airspaceNotification->setText(text);
+        m_airspaceNotification->setReactionTime(warning.timeToEntry);
+    }
+}
+
 void Notifications::NotificationManager::onTrafficReceiverRuntimeError()
 {
     auto error = GlobalObject::trafficDataProvider()->trafficReceiverRuntimeError();
@@ -27,6 +27,7 @@
 
 #include "GlobalObject.h"
 #include "Notification.h"
+#include "navigation/AirspaceMonitor.h"
 
 
 namespace Notifications {
@@ -215,6 +216,10 @@ private:
     // Called whenever map and data updates become (un)available
     void onMapAndDataUpdateSizeChanged();
 
+    // Called on every position update. Predicts airspace entries and raises,
+    // updates or withdraws the airspace notification.
+    void onPositionInfoChanged();
+
     // Called whenever the traffic receiver reports a runtime error, or clears
     // the error status.
     void onTrafficReceiverRuntimeError();
@@ -226,6 +231,12 @@ private:
     // When notifications for maps and data are temporarily not possible, then
     // use this timer to notify again.
     QTimer mapsAndDataNotificationTimer;
+
+    // Predicts airspace entries. m_airspaceNotification is the notification
+    // for the current warning; it becomes nullptr if the pilot dismisses the
+    // notification, and is not raised again for the same airspace.
+    Navigation::AirspaceMonitor m_airspaceMonitor;
+    QPointer<Notifications::Notification> m_airspaceNotification;
 };
 
 
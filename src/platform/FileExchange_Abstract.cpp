@@ -35,6 +35,7 @@
 #include "platform/FileExchange_Abstract.h"
 #include "traffic/TrafficDataProvider.h"
 #include "traffic/TrafficDataSource_File.h"
+#include "weather/WindField.h"
 
 
 Platform::FileExchange_Abstract::FileExchange_Abstract(QObject *parent)
@@ -106,6 +107,14 @@ void Platform::FileExchange_Abstract::processFileOpenRequest(const QString& path
         return;
     }
 
+    // Winds aloft
+    Weather::WindField windField;
+    if (windField.loadFromJSON(myPath).isEmpty())
+    {
+        emit openFileRequest(path, {}, WindField);
+        return;
+    }
+
     // FLARM Simulator file
     if (Traffic::TrafficDataSource_File::containsFLARMSimulationData(myPath))
     {
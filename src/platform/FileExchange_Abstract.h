@@ -57,7 +57,8 @@ public:
         VAC, /*< Visual Approach Chart */
         Image, /*< Image without georeferencing information */
         TripKit, /*< Trip Kit */
-        ZipFile /*< Zip File */
+        ZipFile, /*< Zip File */
+        WindField /*< Winds aloft in the JSON format of Weather::WindField */
       };
     Q_ENUM(FileFunction)
 
@@ -0,0 +1,329 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include <QObject>
+#include <cmath>
+
+#include "positioning/FlightLog.h"
+
+
+namespace {
+
+// Quantization
+constexpr double degreesToFixed = 1.0e7;
+constexpr double metersToFixed = 10.0;
+constexpr double speedToFixed = 100.0;
+constexpr double trackToFixed = 100.0;
+constexpr qint64 fullCircle = 36000;
+
+void writeVarint(QByteArray& data, quint64 value)
+{
+    while (value >= 0x80)
+    {
+        data.append(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    data.append(static_cast<char>(value));
+}
+
+void writeSigned(QByteArray& data, qint64 value)
+{
+    writeVarint(data, (static_cast<quint64>(value) << 1) ^ static_cast<quint64>(value >> 63));
+}
+
+// Reads a variable-length integer at position pos, and advances pos. Returns
+// false if the data ends before the integer does.
+bool readVarint(const QByteArray& data, qsizetype& pos, quint64& value)
+{
+    value = 0;
+    for(int shift = 0; shift < 64; shift += 7)
+    {
+        if (pos >= data.size())
+        {
+            return false;
+        }
+        auto const byte = static_cast<quint8>(data[pos++]);
+        value |= static_cast<quint64>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool readSigned(const QByteArray& data, qsizetype& pos, qint64& value)
+{
+    quint64 zigzag = 0;
+    if (!readVarint(data, pos, zigzag))
+    {
+        return false;
+    }
+    value = static_cast<qint64>(zigzag >> 1) ^ -static_cast<qint64>(zigzag & 1);
+    return true;
+}
+
+qint64 quantize(double value, double factor)
+{
+    return std::llround(value*factor);
+}
+
+} // namespace
+
+
+//
+// Methods
+//
+
+void Positioning::FlightLog::append(QByteArray& data, const Entry& entry)
+{
+    if (!m_headerWritten)
+    {
+        data.append(magic.data(), magic.size());
+        m_headerWritten = true;
+    }
+
+    // Find index of the aircraft. Define new traffic first.
+    qsizetype index = 0;
+    if (entry.kind == Entry::PressureAltitude)
+    {
+        index = 1;
+    }
+    if (entry.kind == Entry::Traffic)
+    {
+        auto it = m_trafficIndices.constFind(entry.ID);
+        if (it == m_trafficIndices.constEnd())
+        {
+            auto const ID = entry.ID.toUtf8();
+            data.append(static_cast<char>(definition));
+            writeVarint(data, ID.size());
+            data.append(ID);
+            it = m_trafficIndices.insert(entry.ID, m_trafficIndices.size());
+        }
+        index = 2 + it.value();
+    }
+    auto& reference = fields(index);
+
+    // Flags
+    quint8 flags = 0;
+    if (std::isfinite(entry.latitude) && std::isfinite(entry.longitude))
+    {
+        flags |= hasPosition;
+    }
+    if (std::isfinite(entry.altitudeInM))
+    {
+        flags |= hasAltitude;
+    }
+    if (std::isfinite(entry.groundSpeedInMPS))
+    {
+        flags |= hasGroundSpeed;
+    }
+    if (std::isfinite(entry.trackInDEG))
+    {
+        flags |= hasTrack;
+    }
+    if (std::isfinite(entry.verticalSpeedInMPS))
+    {
+        flags |= hasVerticalSpeed;
+    }
+
+    // Record
+    data.append(static_cast<char>(entry.kind));
+    data.append(static_cast<char>(flags));
+    writeSigned(data, entry.timestampInMS - m_lastTimestampInMS);
+    m_lastTimestampInMS = entry.timestampInMS;
+    if (entry.kind == Entry::Traffic)
+    {
+        writeVarint(data, index - 2);
+    }
+
+    auto writeField = [&data](qint64& reference, qint64 value) {
+        writeSigned(data, value - reference);
+        reference = value;
+    };
+    if ((flags & hasPosition) != 0)
+    {
+        writeField(reference.latitude, quantize(entry.latitude, degreesToFixed));
+        writeField(reference.longitude, quantize(entry.longitude, degreesToFixed));
+    }
+    if ((flags & hasAltitude) != 0)
+    {
+        writeField(reference.altitude, quantize(entry.altitudeInM, metersToFixed));
+    }
+    if ((flags & hasGroundSpeed) != 0)
+    {
+        writeField(reference.groundSpeed, quantize(entry.groundSpeedInMPS, speedToFixed));
+    }
+    if ((flags & hasTrack) != 0)
+    {
+        // Take the shorter way around the circle
+        auto const track = ((quantize(entry.trackInDEG, trackToFixed) % fullCircle) + fullCircle) % fullCircle;
+        auto delta = track - reference.track;
+        if (delta > fullCircle/2)
+        {
+            delta -= fullCircle;
+        }
+        if (delta <= -fullCircle/2)
+        {
+            delta += fullCircle;
+        }
+        writeSigned(data, delta);
+        reference.track = track;
+    }
+    if ((flags & hasVerticalSpeed) != 0)
+    {
+        writeField(reference.verticalSpeed, quantize(entry.verticalSpeedInMPS, speedToFixed));
+    }
+}
+
+
+auto Positioning::FlightLog::decode(const QByteArray& data, QList<Entry>& entries) -> QString
+{
+    if (!data.startsWith(QByteArrayView(magic.data(), magic.size())))
+    {
+        return QObject::tr("The file is not a flight log.", "FlightLog");
+    }
+
+    FlightLog state;
+    QStringList trafficIDs;
+    qsizetype pos = magic.size();
+    while (pos < data.size())
+    {
+        auto const kind = static_cast<quint8>(data[pos++]);
+
+        // Traffic definition
+        if (kind == definition)
+        {
+            quint64 length = 0;
+            if (!readVarint(data, pos, length) || (length > static_cast<quint64>(data.size() - pos)))
+            {
+                return {};
+            }
+            trafficIDs.append(QString::fromUtf8(data.mid(pos, static_cast<qsizetype>(length))));
+            pos += static_cast<qsizetype>(length);
+            continue;
+        }
+        if ((kind != Entry::Ownship) && (kind != Entry::PressureAltitude) && (kind != Entry::Traffic))
+        {
+            return QObject::tr("The flight log is corrupt.", "FlightLog");
+        }
+
+        // Record header
+        if (pos >= data.size())
+        {
+            return {};
+        }
+        auto const flags = static_cast<quint8>(data[pos++]);
+        Entry entry;
+        entry.kind = static_cast<Entry::Kind>(kind);
+        qint64 deltaT = 0;
+        if (!readSigned(data, pos, deltaT))
+        {
+            return {};
+        }
+        state.m_lastTimestampInMS += deltaT;
+        entry.timestampInMS = state.m_lastTimestampInMS;
+
+        qsizetype index = (kind == Entry::PressureAltitude) ? 1 : 0;
+        if (kind == Entry::Traffic)
+        {
+            quint64 trafficIndex = 0;
+            if (!readVarint(data, pos, trafficIndex))
+            {
+                return {};
+            }
+            if (trafficIndex >= static_cast<quint64>(trafficIDs.size()))
+            {
+                return QObject::tr("The flight log is corrupt.", "FlightLog");
+            }
+            entry.ID = trafficIDs[static_cast<qsizetype>(trafficIndex)];
+            index = 2 + static_cast<qsizetype>(trafficIndex);
+        }
+
+        // Fields. Changes to the reference only take effect once the record
+        // is complete.
+        auto reference = state.fields(index);
+        auto readField = [&data, &pos](qint64& reference) {
+            qint64 delta = 0;
+            if (!readSigned(data, pos, delta))
+            {
+                return false;
+            }
+            reference += delta;
+            return true;
+        };
+        if ((flags & hasPosition) != 0)
+        {
+            if (!readField(reference.latitude) || !readField(reference.longitude))
+            {
+                return {};
+            }
+            entry.latitude = static_cast<double>(reference.latitude)/degreesToFixed;
+            entry.longitude = static_cast<double>(reference.longitude)/degreesToFixed;
+        }
+        if ((flags & hasAltitude) != 0)
+        {
+            if (!readField(reference.altitude))
+            {
+                return {};
+            }
+            entry.altitudeInM = static_cast<double>(reference.altitude)/metersToFixed;
+        }
+        if ((flags & hasGroundSpeed) != 0)
+        {
+            if (!readField(reference.groundSpeed))
+            {
+                return {};
+            }
+            entry.groundSpeedInMPS = static_cast<double>(reference.groundSpeed)/speedToFixed;
+        }
+        if ((flags & hasTrack) != 0)
+        {
+            if (!readField(reference.track))
+            {
+                return {};
+            }
+            reference.track = ((reference.track % fullCircle) + fullCircle) % fullCircle;
+            entry.trackInDEG = static_cast<double>(reference.track)/trackToFixed;
+        }
+        if ((flags & hasVerticalSpeed) != 0)
+        {
+            if (!readField(reference.verticalSpeed))
+            {
+                return {};
+            }
+            entry.verticalSpeedInMPS = static_cast<double>(reference.verticalSpeed)/speedToFixed;
+        }
+        state.fields(index) = reference;
+        entries.append(entry);
+    }
+    return {};
+}
+
+
+auto Positioning::FlightLog::fields(qsizetype index) -> Fields&
+{
+    if (index >= static_cast<qsizetype>(m_fields.size()))
+    {
+        m_fields.resize(index+1);
+    }
+    return m_fields[index];
+}
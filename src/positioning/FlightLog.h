@@ -0,0 +1,171 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <array>
+#include <vector>
+
+
+namespace Positioning {
+
+/*! \brief Compact binary format for recorded flights
+ *
+ *  This class encodes and decodes the flight logs written by FlightRecorder.
+ *  A flight log starts with the eight bytes of FlightLog::magic, followed by a
+ *  sequence of records. Every record starts with a kind byte and a flag byte
+ *  that lists the fields present, followed by the time since the previous
+ *  record and by the fields. For traffic, the index of the traffic follows the
+ *  time; the first record of a traffic is preceded by a record of kind
+ *  Definition that holds the ID of the traffic.
+ *
+ *  Values are quantized in the same way as in Traffic::TrackHistory: position
+ *  in 1e-7 degrees, altitudes in decimeters, speeds in cm/s and track in
+ *  hundredths of a degree. Each value is stored as the difference to the
+ *  previous value of the same aircraft, zigzag-encoded and written as a
+ *  variable-length integer. At one position report per second, a record of
+ *  the own aircraft takes about 12 bytes.
+ *
+ *  Records are self-contained once their predecessors are known, so that a
+ *  log that was cut off in the middle of a record, for instance because the
+ *  app was killed, can be read up to the last complete record.
+ */
+
+class FlightLog
+{
+public:
+    /*! \brief Entry of a flight log */
+    struct Entry
+    {
+        /*! \brief Kind of entry */
+        enum Kind : quint8
+        {
+            Ownship = 1,          /*!< Position of the own aircraft */
+            PressureAltitude = 2, /*!< Pressure altitude of the own aircraft, in member altitudeInM */
+            Traffic = 3           /*!< Position of traffic */
+        };
+
+        /*! \brief Kind of entry */
+        Kind kind {Ownship};
+
+        /*! \brief Time, in milliseconds since the epoch */
+        qint64 timestampInMS {0};
+
+        /*! \brief Identifier of the traffic, empty for other kinds */
+        QString ID;
+
+        /*! \brief Latitude in degrees, or NaN */
+        double latitude {qQNaN()};
+
+        /*! \brief Longitude in degrees, or NaN */
+        double longitude {qQNaN()};
+
+        /*! \brief True altitude, or pressure altitude for kind PressureAltitude; NaN if unknown */
+        double altitudeInM {qQNaN()};
+
+        /*! \brief Ground speed, or NaN */
+        double groundSpeedInMPS {qQNaN()};
+
+        /*! \brief True track in degrees, or NaN */
+        double trackInDEG {qQNaN()};
+
+        /*! \brief Vertical speed, or NaN */
+        double verticalSpeedInMPS {qQNaN()};
+    };
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Encode entry
+     *
+     *  The first call appends the header to data. All entries of one log must
+     *  be encoded with the same instance, in the order in which they are
+     *  written.
+     *
+     *  @param data Byte array to which the encoded entry is appended
+     *
+     *  @param entry Entry
+     */
+    void append(QByteArray& data, const Entry& entry);
+
+    /*! \brief Decode flight log
+     *
+     *  @param data Flight log
+     *
+     *  @param entries List to which the entries are appended. If the log ends
+     *  with an incomplete record, the record is ignored.
+     *
+     *  @returns Empty string in case of success, human-readable, translated
+     *  error message otherwise
+     */
+    [[nodiscard]] static auto decode(const QByteArray& data, QList<Entry>& entries) -> QString;
+
+
+    //
+    // Constants
+    //
+
+    /*! \brief File header */
+    static constexpr std::array<char, 8> magic {'E', 'N', 'R', 'F', 'L', 'O', 'G', '1'};
+
+private:
+    // Record kind that defines the ID of a traffic
+    static constexpr quint8 definition = 4;
+
+    // Bits of the flag byte
+    enum Flag : quint8
+    {
+        hasPosition = 1,
+        hasAltitude = 2,
+        hasGroundSpeed = 4,
+        hasTrack = 8,
+        hasVerticalSpeed = 16
+    };
+
+    // Quantized values of one aircraft, used as reference for the next
+    // record of the same aircraft
+    struct Fields
+    {
+        qint64 latitude {0};
+        qint64 longitude {0};
+        qint64 altitude {0};
+        qint64 groundSpeed {0};
+        qint64 track {0};
+        qint64 verticalSpeed {0};
+    };
+
+    // Returns the reference fields of a record. Index 0 is the own aircraft,
+    // index 1 the pressure altitude, traffic follows.
+    Fields& fields(qsizetype index);
+
+    bool m_headerWritten {false};
+    qint64 m_lastTimestampInMS {0};
+    QHash<QString, qsizetype> m_trafficIndices;
+    std::vector<Fields> m_fields;
+};
+
+} // namespace Positioning
@@ -0,0 +1,519 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSettings>
+#include <QTimeZone>
+#include <QXmlStreamWriter>
+#include <QtConcurrent>
+#include <cmath>
+
+#if defined(Q_OS_WIN)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "positioning/FlightRecorder.h"
+#include "positioning/PositionProvider.h"
+#include "traffic/TrafficDataProvider.h"
+#include "traffic/TrafficFactor_WithPosition.h"
+
+using namespace std::chrono_literals;
+
+
+namespace {
+
+// Suffix of flight log files
+const QString logSuffix = QStringLiteral("flightlog");
+
+// Formats a latitude or longitude for IGC B records, as degrees, minutes and
+// thousandths of minutes, followed by the hemisphere
+QByteArray igcAngle(double angleInDEG, int degreeDigits, char positive, char negative)
+{
+    auto const thousandthsOfMinutes = std::llround(std::fabs(angleInDEG)*60000.0);
+    auto const degrees = thousandthsOfMinutes/60000;
+    auto const rest = thousandthsOfMinutes%60000;
+    return QByteArray::number(degrees).rightJustified(degreeDigits, '0')
+           + QByteArray::number(rest).rightJustified(5, '0')
+           + ((angleInDEG < 0) ? negative : positive);
+}
+
+// Formats an altitude for IGC B records, in meters with five characters
+QByteArray igcAltitude(double altitudeInM)
+{
+    if (!std::isfinite(altitudeInM))
+    {
+        return "00000";
+    }
+    auto const altitude = qBound(-9999LL, std::llround(altitudeInM), 99999LL);
+    if (altitude < 0)
+    {
+        return "-" + QByteArray::number(-altitude).rightJustified(4, '0');
+    }
+    return QByteArray::number(altitude).rightJustified(5, '0');
+}
+
+} // namespace
+
+
+Positioning::FlightRecorder::FlightRecorder(QObject* parent) : GlobalObject(parent)
+{
+    QSettings const settings;
+    m_enabled = settings.value(QStringLiteral("FlightRecorder/enabled"), false).toBool();
+
+    m_flushTimer.setInterval(flushIntervalInMS);
+    m_flushTimer.setSingleShot(true);
+    connect(&m_flushTimer, &QTimer::timeout, this, &Positioning::FlightRecorder::flush);
+    connect(&m_exportWatcher, &QFutureWatcher<QString>::finished, this, &Positioning::FlightRecorder::onExportFinished);
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &Positioning::FlightRecorder::closeLog);
+
+    QDir().mkpath(m_logDirectory);
+    updateLogFiles();
+}
+
+
+void Positioning::FlightRecorder::deferredInitialization()
+{
+    auto* positionProvider = GlobalObject::positionProvider();
+    connect(positionProvider, &Positioning::PositionProvider::positionInfoChanged, this, &Positioning::FlightRecorder::onPositionInfoChanged);
+    connect(positionProvider, &Positioning::PositionProvider::pressureAltitudeChanged, this, &Positioning::FlightRecorder::onPressureAltitudeChanged);
+    connect(positionProvider->replaySource(), &Positioning::PositionInfoSource_Replay::replayingChanged, this, &Positioning::FlightRecorder::replayingChanged);
+}
+
+
+Positioning::FlightRecorder::~FlightRecorder()
+{
+    closeLog();
+    m_exportWatcher.waitForFinished();
+}
+
+
+//
+// Getter Methods
+//
+
+bool Positioning::FlightRecorder::replaying() const
+{
+    auto* positionProvider = GlobalObject::positionProvider();
+    if (positionProvider == nullptr)
+    {
+        return false;
+    }
+    return positionProvider->replaySource()->isReplaying();
+}
+
+
+//
+// Setter Methods
+//
+
+void Positioning::FlightRecorder::setEnabled(bool newEnabled)
+{
+    if (newEnabled == m_enabled)
+    {
+        return;
+    }
+    m_enabled = newEnabled;
+    if (!m_enabled)
+    {
+        closeLog();
+    }
+    QSettings settings;
+    settings.setValue(QStringLiteral("FlightRecorder/enabled"), m_enabled);
+    emit enabledChanged();
+}
+
+
+//
+// Methods
+//
+
+void Positioning::FlightRecorder::append(const Positioning::FlightLog::Entry& entry)
+{
+    m_log.append(m_buffer, entry);
+    if (m_buffer.size() >= bufferSize)
+    {
+        flush();
+        return;
+    }
+    if (!m_flushTimer.isActive())
+    {
+        m_flushTimer.start();
+    }
+}
+
+
+void Positioning::FlightRecorder::closeLog()
+{
+    if (!m_file.isOpen())
+    {
+        return;
+    }
+    m_lastSync.invalidate();
+    flush();
+    m_file.close();
+
+    m_log = FlightLog();
+    m_buffer.clear();
+    m_trafficTimestamps.clear();
+    m_lastTimestampInMS = 0;
+}
+
+
+void Positioning::FlightRecorder::exportLog(const QString& logFile, const QString& targetFile)
+{
+    if (m_exportWatcher.isRunning())
+    {
+        emit exportFinished(tr("Another export is still running."));
+        return;
+    }
+
+    // Make sure that the exported data includes everything recorded so far
+    if (logFile == m_file.fileName())
+    {
+        flush();
+    }
+    m_exportWatcher.setFuture(QtConcurrent::run(&Positioning::FlightRecorder::exportFile, logFile, targetFile));
+}
+
+
+auto Positioning::FlightRecorder::exportFile(const QString& logFile, const QString& targetFile) -> QString
+{
+    QFile file(logFile);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return tr("Unable to read file '%1'.").arg(logFile);
+    }
+    QList<FlightLog::Entry> entries;
+    auto error = FlightLog::decode(file.readAll(), entries);
+    if (!error.isEmpty())
+    {
+        return error;
+    }
+
+    auto const data = (QFileInfo(targetFile).suffix().compare(u"igc"_qs, Qt::CaseInsensitive) == 0) ? toIGC(entries) : toGPX(entries);
+    QSaveFile target(targetFile);
+    if (!target.open(QIODevice::WriteOnly) || (target.write(data) != data.size()) || !target.commit())
+    {
+        return tr("Unable to write to file '%1'.").arg(targetFile);
+    }
+    return {};
+}
+
+
+void Positioning::FlightRecorder::flush()
+{
+    m_flushTimer.stop();
+    if (!m_file.isOpen())
+    {
+        return;
+    }
+    if (!m_buffer.isEmpty())
+    {
+        m_file.write(m_buffer);
+        m_buffer.clear();
+    }
+    if (!m_lastSync.isValid() || (m_lastSync.elapsed() >= syncIntervalInMS))
+    {
+        m_file.flush();
+#if defined(Q_OS_WIN)
+        _commit(m_file.handle());
+#else
+        fsync(m_file.handle());
+#endif
+        m_lastSync.start();
+    }
+}
+
+
+void Positioning::FlightRecorder::onExportFinished()
+{
+    emit exportFinished(m_exportWatcher.result());
+}
+
+
+void Positioning::FlightRecorder::onPositionInfoChanged()
+{
+    if (!m_enabled || replaying())
+    {
+        return;
+    }
+    auto const info = GlobalObject::positionProvider()->positionInfo();
+    if (!info.isValid())
+    {
+        return;
+    }
+    auto const timestampInMS = info.timestamp().toMSecsSinceEpoch();
+
+    // Start new log at the beginning, and after a long gap
+    if (m_file.isOpen() && (timestampInMS - m_lastTimestampInMS > maxGapInMS))
+    {
+        closeLog();
+    }
+    if (!m_file.isOpen())
+    {
+        m_file.setFileName(m_logDirectory + "/" + QDateTime::fromMSecsSinceEpoch(timestampInMS, QTimeZone::UTC).toString(u"yyyy-MM-dd HH-mm-ss"_qs) + "." + logSuffix);
+        if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append))
+        {
+            return;
+        }
+        m_lastSync.invalidate();
+        updateLogFiles();
+    }
+
+    // Own aircraft
+    FlightLog::Entry entry;
+    entry.kind = FlightLog::Entry::Ownship;
+    entry.timestampInMS = timestampInMS;
+    entry.latitude = info.coordinate().latitude();
+    entry.longitude = info.coordinate().longitude();
+    entry.altitudeInM = info.trueAltitudeAMSL().toM();
+    entry.groundSpeedInMPS = info.groundSpeed().toMPS();
+    entry.trackInDEG = info.trueTrack().toDEG();
+    entry.verticalSpeedInMPS = info.verticalSpeed().toMPS();
+    append(entry);
+    m_lastTimestampInMS = timestampInMS;
+
+    // Traffic whose position has changed since it was last written
+    for(auto* traffic : GlobalObject::trafficDataProvider()->trafficObjects())
+    {
+        if ((traffic == nullptr) || !traffic->valid())
+        {
+            continue;
+        }
+        auto const trafficInfo = traffic->positionInfo();
+        if (!trafficInfo.isValid())
+        {
+            continue;
+        }
+        auto const trafficTimestampInMS = trafficInfo.timestamp().toMSecsSinceEpoch();
+        auto const ID = traffic->ID();
+        if (m_trafficTimestamps.value(ID, -1) == trafficTimestampInMS)
+        {
+            continue;
+        }
+        m_trafficTimestamps.insert(ID, trafficTimestampInMS);
+
+        FlightLog::Entry trafficEntry;
+        trafficEntry.kind = FlightLog::Entry::Traffic;
+        trafficEntry.timestampInMS = trafficTimestampInMS;
+        trafficEntry.ID = ID;
+        trafficEntry.latitude = trafficInfo.coordinate().latitude();
+        trafficEntry.longitude = trafficInfo.coordinate().longitude();
+        trafficEntry.altitudeInM = trafficInfo.trueAltitudeAMSL().toM();
+        trafficEntry.groundSpeedInMPS = trafficInfo.groundSpeed().toMPS();
+        trafficEntry.trackInDEG = trafficInfo.trueTrack().toDEG();
+        trafficEntry.verticalSpeedInMPS = trafficInfo.verticalSpeed().toMPS();
+        append(trafficEntry);
+    }
+}
+
+
+void Positioning::FlightRecorder::onPressureAltitudeChanged()
+{
+    if (!m_file.isOpen() || replaying())
+    {
+        return;
+    }
+    auto const pressureAltitude = GlobalObject::positionProvider()->pressureAltitude();
+    if (!pressureAltitude.isFinite())
+    {
+        return;
+    }
+
+    FlightLog::Entry entry;
+    entry.kind = FlightLog::Entry::PressureAltitude;
+    entry.timestampInMS = QDateTime::currentMSecsSinceEpoch();
+    entry.altitudeInM = pressureAltitude.toM();
+    append(entry);
+}
+
+
+QString Positioning::FlightRecorder::startReplay(const QString& logFile, double speedFactor)
+{
+    QFile file(logFile);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return tr("Unable to read file '%1'.").arg(logFile);
+    }
+    QList<FlightLog::Entry> entries;
+    auto error = FlightLog::decode(file.readAll(), entries);
+    if (!error.isEmpty())
+    {
+        return error;
+    }
+
+    // Do not record the replay
+    closeLog();
+
+    auto* replaySource = GlobalObject::positionProvider()->replaySource();
+    replaySource->start(entries, speedFactor);
+    if (!replaySource->isReplaying())
+    {
+        return tr("The flight log does not contain any positions.");
+    }
+    return {};
+}
+
+
+void Positioning::FlightRecorder::stopReplay()
+{
+    GlobalObject::positionProvider()->replaySource()->stop();
+}
+
+
+auto Positioning::FlightRecorder::toGPX(const QList<Positioning::FlightLog::Entry>& entries) -> QByteArray
+{
+    // Group positions by aircraft. The own aircraft comes first.
+    QStringList IDs {QString()};
+    QHash<QString, QList<qsizetype>> indices;
+    for(qsizetype i=0; i<entries.size(); i++)
+    {
+        const auto& entry = entries[i];
+        if ((entry.kind == FlightLog::Entry::PressureAltitude) || !std::isfinite(entry.latitude) || !std::isfinite(entry.longitude))
+        {
+            continue;
+        }
+        if (!indices.contains(entry.ID))
+        {
+            IDs.append(entry.ID);
+        }
+        indices[entry.ID].append(i);
+    }
+
+    QByteArray result;
+    QXmlStreamWriter stream(&result);
+    stream.setAutoFormatting(true);
+    stream.writeStartDocument();
+
+    stream.writeStartElement(QStringLiteral("gpx"));
+    stream.writeAttribute(QStringLiteral("version"), QStringLiteral("1.1"));
+    stream.writeAttribute(QStringLiteral("creator"), QStringLiteral("Enroute Flight Navigation"));
+    stream.writeAttribute(QStringLiteral("xmlns"), QStringLiteral("http://www.topografix.com/GPX/1/1"));
+    stream.writeAttribute(QStringLiteral("xmlns:xsi"), QStringLiteral("http://www.w3.org/2001/XMLSchema-instance"));
+
+    for(const auto& ID : IDs)
+    {
+        if (!indices.contains(ID))
+        {
+            continue;
+        }
+        stream.writeStartElement(QStringLiteral("trk"));
+        stream.writeTextElement(QStringLiteral("name"), ID.isEmpty() ? tr("Own aircraft") : ID);
+        stream.writeStartElement(QStringLiteral("trkseg"));
+        for(auto i : indices.value(ID))
+        {
+            const auto& entry = entries[i];
+            stream.writeStartElement(QStringLiteral("trkpt"));
+            stream.writeAttribute(QStringLiteral("lat"), QString::number(entry.latitude, 'f', 7));
+            stream.writeAttribute(QStringLiteral("lon"), QString::number(entry.longitude, 'f', 7));
+            if (std::isfinite(entry.altitudeInM))
+            {
+                stream.writeTextElement(QStringLiteral("ele"), QString::number(entry.altitudeInM, 'f', 1));
+            }
+            stream.writeTextElement(QStringLiteral("time"), QDateTime::fromMSecsSinceEpoch(entry.timestampInMS, QTimeZone::UTC).toString(Qt::ISODateWithMs));
+            stream.writeEndElement(); // trkpt
+        }
+        stream.writeEndElement(); // trkseg
+        stream.writeEndElement(); // trk
+    }
+
+    stream.writeEndElement(); // gpx
+    stream.writeEndDocument();
+    return result;
+}
+
+
+auto Positioning::FlightRecorder::toIGC(const QList<Positioning::FlightLog::Entry>& entries) -> QByteArray
+{
+    // Header. The date is that of the first position.
+    QByteArray result = "AXXXEnroute Flight Navigation\r\n";
+    for(const auto& entry : entries)
+    {
+        if (entry.kind == FlightLog::Entry::Ownship)
+        {
+            auto const date = QDateTime::fromMSecsSinceEpoch(entry.timestampInMS, QTimeZone::UTC).date();
+            result += "HFDTEDATE:" + date.toString(u"ddMMyy"_qs).toLatin1() + "\r\n";
+            break;
+        }
+    }
+    result += "HFFTYFRTYPE:Enroute Flight Navigation\r\n";
+    result += "HFALGALTGPS:GEO\r\n";
+    result += "HFALPALTPRESSURE:ISA\r\n";
+
+    // One fix record per position of the own aircraft, with the most recent
+    // pressure altitude
+    auto pressureAltitudeInM = qQNaN();
+    for(const auto& entry : entries)
+    {
+        if (entry.kind == FlightLog::Entry::PressureAltitude)
+        {
+            pressureAltitudeInM = entry.altitudeInM;
+            continue;
+        }
+        if ((entry.kind != FlightLog::Entry::Ownship) || !std::isfinite(entry.latitude) || !std::isfinite(entry.longitude))
+        {
+            continue;
+        }
+        auto const time = QDateTime::fromMSecsSinceEpoch(entry.timestampInMS, QTimeZone::UTC).time();
+        result += "B" + time.toString(u"HHmmss"_qs).toLatin1()
+                  + igcAngle(entry.latitude, 2, 'N', 'S')
+                  + igcAngle(entry.longitude, 3, 'E', 'W')
+                  + (std::isfinite(entry.altitudeInM) ? 'A' : 'V')
+                  + igcAltitude(pressureAltitudeInM)
+                  + igcAltitude(entry.altitudeInM)
+                  + "\r\n";
+    }
+    return result;
+}
+
+
+void Positioning::FlightRecorder::updateLogFiles()
+{
+    QDir const directory(m_logDirectory);
+    auto files = directory.entryInfoList({"*." + logSuffix}, QDir::Files, QDir::Name | QDir::Reversed);
+
+    // Delete old logs, but never the one being written
+    while (files.size() > maxLogFiles)
+    {
+        auto const fileName = files.takeLast().absoluteFilePath();
+        if (fileName != m_file.fileName())
+        {
+            QFile::remove(fileName);
+        }
+    }
+
+    QStringList newLogFiles;
+    for(const auto& fileInfo : files)
+    {
+        newLogFiles.append(fileInfo.absoluteFilePath());
+    }
+    if (newLogFiles == m_logFiles)
+    {
+        return;
+    }
+    m_logFiles = newLogFiles;
+    emit logFilesChanged();
+}
@@ -0,0 +1,291 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QQmlEngine>
+#include <QStandardPaths>
+#include <QTimer>
+
+#include "GlobalObject.h"
+#include "positioning/FlightLog.h"
+
+
+namespace Positioning {
+
+/*! \brief Flight recorder
+ *
+ *  This class records every position report of the PositionProvider, together
+ *  with the pressure altitude and the traffic reported by the
+ *  TrafficDataProvider, in the compact binary format described in FlightLog.
+ *  A new flight log is started for every session, and whenever no position
+ *  has been received for maxGapInMS. Only the most recent maxLogFiles flight
+ *  logs are kept.
+ *
+ *  Encoded records are collected in a buffer that is written to the file when
+ *  it holds more than bufferSize bytes, or flushIntervalInMS after the last
+ *  write. Every syncIntervalInMS, the file is also synchronized to the
+ *  storage device, so that at most a few seconds of flight are lost if the app
+ *  is killed or the device loses power.
+ *
+ *  Flight logs can be exported to GPX or IGC files in a background thread, and
+ *  they can be replayed through the PositionProvider, see
+ *  PositionInfoSource_Replay. Nothing is recorded while a replay is running.
+ */
+
+class FlightRecorder : public GlobalObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_SINGLETON
+
+public:
+    //
+    // Constructors and destructors
+    //
+
+    /*! \brief Standard constructor
+     *
+     * @param parent The standard QObject parent pointer
+     */
+    explicit FlightRecorder(QObject* parent = nullptr);
+
+    // deferred initialization
+    void deferredInitialization() override;
+
+    // No default constructor, important for QML singleton
+    explicit FlightRecorder() = delete;
+
+    /*! \brief Standard destructor
+     *
+     *  The destructor closes the current flight log and waits for a running
+     *  export to finish.
+     */
+    ~FlightRecorder() override;
+
+    // factory function for QML singleton
+    static Positioning::FlightRecorder* create(QQmlEngine* /*unused*/, QJSEngine* /*unused*/)
+    {
+        return GlobalObject::flightRecorder();
+    }
+
+
+    //
+    // PROPERTIES
+    //
+
+    /*! \brief Recording enabled
+     *
+     *  This property is stored in QSettings and is false by default, so that
+     *  nothing is recorded unless the user asks for it. Disabling the recorder
+     *  closes the current flight log.
+     */
+    Q_PROPERTY(bool enabled READ enabled WRITE setEnabled NOTIFY enabledChanged)
+
+    /*! \brief Flight logs
+     *
+     *  This property holds the full paths of all flight logs, most recent log
+     *  first.
+     */
+    Q_PROPERTY(QStringList logFiles READ logFiles NOTIFY logFilesChanged)
+
+    /*! \brief Replay running
+     *
+     *  This property is true while a flight log is replayed.
+     */
+    Q_PROPERTY(bool replaying READ replaying NOTIFY replayingChanged)
+
+
+    //
+    // Getter Methods
+    //
+
+    /*! \brief Getter function for the property with the same name
+     *
+     *  @returns Property enabled
+     */
+    [[nodiscard]] bool enabled() const
+    {
+        return m_enabled;
+    }
+
+    /*! \brief Getter function for the property with the same name
+     *
+     *  @returns Property logFiles
+     */
+    [[nodiscard]] QStringList logFiles() const
+    {
+        return m_logFiles;
+    }
+
+    /*! \brief Getter function for the property with the same name
+     *
+     *  @returns Property replaying
+     */
+    [[nodiscard]] bool replaying() const;
+
+
+    //
+    // Setter Methods
+    //
+
+    /*! \brief Setter function for the property with the same name
+     *
+     *  @param newEnabled Property enabled
+     */
+    void setEnabled(bool newEnabled);
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Export flight log
+     *
+     *  This method returns immediately. The export runs in a background
+     *  thread, and the signal exportFinished() is emitted when it is done.
+     *
+     *  @param logFile Flight log
+     *
+     *  @param targetFile Name of the file to be written. The format is chosen
+     *  by the suffix: "igc" for IGC, GPX otherwise.
+     */
+    Q_INVOKABLE void exportLog(const QString& logFile, const QString& targetFile);
+
+    /*! \brief Replay flight log
+     *
+     *  Closes the current flight log and replays the position reports and
+     *  pressure altitudes of a recorded flight through the PositionProvider.
+     *  Traffic is not replayed.
+     *
+     *  @param logFile Flight log
+     *
+     *  @param speedFactor Factor by which the replay is faster than the
+     *  recorded flight
+     *
+     *  @returns Empty string in case of success, human-readable, translated
+     *  error message otherwise
+     */
+    Q_INVOKABLE QString startReplay(const QString& logFile, double speedFactor = 1.0);
+
+    /*! \brief Stop replay */
+    Q_INVOKABLE void stopReplay();
+
+
+    //
+    // Constants
+    //
+
+    /*! \brief Size of the write buffer */
+    static constexpr qsizetype bufferSize = 4096;
+
+    /*! \brief Maximal time between writes to the file */
+    static constexpr int flushIntervalInMS = 5000;
+
+    /*! \brief Maximal time between synchronizations of the file to the storage device */
+    static constexpr qint64 syncIntervalInMS = 30000;
+
+    /*! \brief Time without position after which a new flight log is started */
+    static constexpr qint64 maxGapInMS = 10*60*1000;
+
+    /*! \brief Maximal number of flight logs kept */
+    static constexpr qsizetype maxLogFiles = 100;
+
+signals:
+    /*! \brief Notifier signal */
+    void enabledChanged();
+
+    /*! \brief Emitted when an export has finished
+     *
+     *  @param errorMessage Empty string in case of success, human-readable,
+     *  translated error message otherwise
+     */
+    void exportFinished(const QString& errorMessage);
+
+    /*! \brief Notifier signal */
+    void logFilesChanged();
+
+    /*! \brief Notifier signal */
+    void replayingChanged();
+
+private slots:
+    // Closes the flight log, writing and synchronizing all buffered data
+    void closeLog();
+
+    // Writes the buffer to the file, and synchronizes the file to the storage
+    // device if syncIntervalInMS has passed since the last synchronization
+    void flush();
+
+    // Emits exportFinished() with the result of m_exportWatcher
+    void onExportFinished();
+
+    // Records the position of the own aircraft, together with all traffic
+    // whose position has changed
+    void onPositionInfoChanged();
+
+    // Records the pressure altitude
+    void onPressureAltitudeChanged();
+
+    // Updates m_logFiles and deletes old flight logs
+    void updateLogFiles();
+
+private:
+    Q_DISABLE_COPY_MOVE(FlightRecorder)
+
+    // Appends an entry to the buffer, and writes the buffer if it is full
+    void append(const Positioning::FlightLog::Entry& entry);
+
+    // Reads and converts a flight log. This method runs in a background thread.
+    static QString exportFile(const QString& logFile, const QString& targetFile);
+
+    // Converts the entries of a flight log
+    static QByteArray toGPX(const QList<Positioning::FlightLog::Entry>& entries);
+    static QByteArray toIGC(const QList<Positioning::FlightLog::Entry>& entries);
+
+    // Directory where flight logs are stored
+    QString m_logDirectory {QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/flight logs"};
+
+    // Property values
+    bool m_enabled {false};
+    QStringList m_logFiles;
+
+    // Current flight log. The file is closed if no log is being written.
+    QFile m_file;
+    Positioning::FlightLog m_log;
+    QByteArray m_buffer;
+    QTimer m_flushTimer;
+    QElapsedTimer m_lastSync;
+
+    // Timestamp of the last position of the own aircraft written
+    qint64 m_lastTimestampInMS {0};
+
+    // Timestamps of the last positions written, by traffic ID
+    QHash<QString, qint64> m_trafficTimestamps;
+
+    // Export running in the background
+    QFutureWatcher<QString> m_exportWatcher;
+};
+
+} // namespace Positioning
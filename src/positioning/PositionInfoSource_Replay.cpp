@@ -0,0 +1,142 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include <QGeoPositionInfo>
+#include <cmath>
+
+#include "positioning/PositionInfoSource_Replay.h"
+
+
+Positioning::PositionInfoSource_Replay::PositionInfoSource_Replay(QObject *parent)
+    : PositionInfoSource_Abstract(parent)
+{
+    setSourceName( tr("Flight replay") );
+    setStatusString( tr("Idle") );
+
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &Positioning::PositionInfoSource_Replay::playDueEntries);
+}
+
+
+void Positioning::PositionInfoSource_Replay::start(const QList<Positioning::FlightLog::Entry>& entries, double speedFactor)
+{
+    stop();
+
+    for(const auto& entry : entries)
+    {
+        if ((entry.kind == FlightLog::Entry::Ownship) || (entry.kind == FlightLog::Entry::PressureAltitude))
+        {
+            m_entries.append(entry);
+        }
+    }
+    if (m_entries.isEmpty())
+    {
+        return;
+    }
+
+    m_next = 0;
+    m_speedFactor = std::isfinite(speedFactor) ? qMax(speedFactor, minSpeedFactor) : 1.0;
+    m_elapsed.start();
+    setStatusString( tr("Replaying recorded flight") );
+    emit replayingChanged();
+    playDueEntries();
+}
+
+
+void Positioning::PositionInfoSource_Replay::stop()
+{
+    if (m_entries.isEmpty())
+    {
+        return;
+    }
+
+    m_timer.stop();
+    m_entries.clear();
+    m_next = 0;
+    setPositionInfo( {} );
+    setPressureAltitude( {} );
+    setStatusString( tr("Idle") );
+    emit replayingChanged();
+}
+
+
+void Positioning::PositionInfoSource_Replay::playDueEntries()
+{
+    if (m_entries.isEmpty())
+    {
+        return;
+    }
+
+    // Position in the recorded flight
+    auto const firstTimestampInMS = m_entries.constFirst().timestampInMS;
+    auto const nowInMS = firstTimestampInMS + qRound64(static_cast<double>(m_elapsed.elapsed())*m_speedFactor);
+
+    // Pass all entries that are due. If the replay has fallen behind, only the
+    // latest position is relevant, but all pressure altitudes are cheap enough
+    // to pass on.
+    qsizetype lastOwnship = -1;
+    while ((m_next < m_entries.size()) && (m_entries[m_next].timestampInMS <= nowInMS))
+    {
+        const auto& entry = m_entries[m_next];
+        if (entry.kind == FlightLog::Entry::Ownship)
+        {
+            lastOwnship = m_next;
+        }
+        else
+        {
+            setPressureAltitude( std::isfinite(entry.altitudeInM) ? Units::Distance::fromM(entry.altitudeInM) : Units::Distance() );
+        }
+        m_next++;
+    }
+    if (lastOwnship >= 0)
+    {
+        const auto& entry = m_entries[lastOwnship];
+        QGeoCoordinate coordinate(entry.latitude, entry.longitude);
+        if (std::isfinite(entry.altitudeInM))
+        {
+            coordinate.setAltitude(entry.altitudeInM);
+        }
+        QGeoPositionInfo info(coordinate, QDateTime::currentDateTimeUtc());
+        if (std::isfinite(entry.groundSpeedInMPS))
+        {
+            info.setAttribute(QGeoPositionInfo::GroundSpeed, entry.groundSpeedInMPS);
+        }
+        if (std::isfinite(entry.trackInDEG))
+        {
+            info.setAttribute(QGeoPositionInfo::Direction, entry.trackInDEG);
+        }
+        if (std::isfinite(entry.verticalSpeedInMPS))
+        {
+            info.setAttribute(QGeoPositionInfo::VerticalSpeed, entry.verticalSpeedInMPS);
+        }
+        setPositionInfo( Positioning::PositionInfo(info) );
+    }
+
+    // Schedule next call, or end the replay
+    if (m_next >= m_entries.size())
+    {
+        stop();
+        return;
+    }
+    auto const delayInMS = static_cast<double>(m_entries[m_next].timestampInMS - nowInMS)/m_speedFactor;
+    m_timer.start( qMax(0, static_cast<int>(std::ceil(delayInMS))) );
+}
@@ -0,0 +1,129 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <QElapsedTimer>
+
+#include "positioning/FlightLog.h"
+#include "positioning/PositionInfoSource_Abstract.h"
+
+
+namespace Positioning {
+
+/*! \brief Replay of a recorded flight
+ *
+ *  This class feeds the position reports and pressure altitudes of a recorded
+ *  flight back into the app, via the PositionInfoSource_Abstract interface that
+ *  it implements. The PositionProvider prefers this source to all other
+ *  sources while a replay is running, so that navigation features can be
+ *  tested and profiled on the ground.
+ *
+ *  The recorded time can be compressed by a speed factor. Timestamps are
+ *  replaced by the current time, so that the position reports pass the
+ *  validity checks of PositionInfo. Speeds are replayed as recorded and are
+ *  not scaled by the speed factor.
+ */
+
+class PositionInfoSource_Replay : public PositionInfoSource_Abstract
+{
+    Q_OBJECT
+
+public:
+    /*! \brief Standard constructor
+     *
+     * @param parent The standard QObject parent pointer
+     */
+    explicit PositionInfoSource_Replay(QObject *parent = nullptr);
+
+    // Default destructor
+    ~PositionInfoSource_Replay() override = default;
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Check if a replay is running
+     *
+     *  @returns True if a replay is running
+     */
+    [[nodiscard]] bool isReplaying() const
+    {
+        return !m_entries.isEmpty();
+    }
+
+    /*! \brief Start replay
+     *
+     *  A running replay is stopped. Entries other than Ownship and
+     *  PressureAltitude are ignored.
+     *
+     *  @param entries Entries of a flight log, in chronological order
+     *
+     *  @param speedFactor Factor by which the replay is faster than the
+     *  recorded flight. Values smaller than minSpeedFactor are replaced by
+     *  minSpeedFactor.
+     */
+    void start(const QList<Positioning::FlightLog::Entry>& entries, double speedFactor);
+
+    /*! \brief Stop replay
+     *
+     *  The position info and the pressure altitude are set to invalid values.
+     */
+    void stop();
+
+
+    //
+    // Constants
+    //
+
+    /*! \brief Minimal speed factor */
+    static constexpr double minSpeedFactor = 0.1;
+
+signals:
+    /*! \brief Emitted when a replay starts or ends */
+    void replayingChanged();
+
+private slots:
+    // Passes all entries that are due to the PositionInfoSource_Abstract
+    // interface and schedules the next call
+    void playDueEntries();
+
+private:
+    Q_DISABLE_COPY_MOVE(PositionInfoSource_Replay)
+
+    // Entries of the running replay, empty if no replay is running
+    QList<Positioning::FlightLog::Entry> m_entries;
+
+    // Index of the next entry to be replayed
+    qsizetype m_next {0};
+
+    // Speed factor of the running replay
+    double m_speedFactor {1.0};
+
+    // Time since the start of the replay
+    QElapsedTimer m_elapsed;
+
+    // Single-shot timer that triggers playDueEntries()
+    QTimer m_timer;
+};
+
+} // namespace Positioning
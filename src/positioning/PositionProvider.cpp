@@ -45,6 +45,10 @@ Positioning::PositionProvider::PositionProvider(QObject *parent) : PositionInfoS
     connect(&satelliteSource, &Positioning::PositionInfoSource_Satellite::positionInfoChanged, this, &PositionProvider::onPositionUpdated);
     connect(&satelliteSource, &Positioning::PositionInfoSource_Satellite::pressureAltitudeChanged, this, &PositionProvider::onPressureAltitudeUpdated);
 
+    // Wire up replay source
+    connect(&m_replaySource, &Positioning::PositionInfoSource_Replay::positionInfoChanged, this, &PositionProvider::onPositionUpdated);
+    connect(&m_replaySource, &Positioning::PositionInfoSource_Replay::pressureAltitudeChanged, this, &PositionProvider::onPressureAltitudeUpdated);
+
     // Binding for updateStatusString
     connect(this, &Positioning::PositionProvider::receivingPositionInfoChanged, this, &Positioning::PositionProvider::updateStatusString);
     connect(&satelliteSource, &Positioning::PositionInfoSource_Satellite::statusStringChanged, this, &Positioning::PositionProvider::updateStatusString);
@@ -91,7 +95,13 @@ void Positioning::PositionProvider::onPositionUpdated()
     QString source;
 
 
-    if (GlobalObject::globalSettings()->positioningByTrafficDataReceiver())
+    // Priority #0: Replay of a recorded flight
+    if (m_replaySource.isReplaying())
+    {
+        newInfo = m_replaySource.positionInfo();
+        source = m_replaySource.sourceName();
+    }
+    else if (GlobalObject::globalSettings()->positioningByTrafficDataReceiver())
     {
 
         // Priority #1: Traffic data provider
@@ -175,6 +185,12 @@ void Positioning::PositionProvider::onPressureAltitudeUpdated()
     // that has valid data for us.
     Units::Distance pAlt;
 
+    // Priority #0: Replay of a recorded flight
+    if (m_replaySource.isReplaying()) {
+        setPressureAltitude(m_replaySource.pressureAltitude());
+        return;
+    }
+
     // Priority #1: Traffic data provider
     auto* trafficDataProvider = GlobalObject::trafficDataProvider();
     if (trafficDataProvider != nullptr) {
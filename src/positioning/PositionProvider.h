@@ -25,6 +25,7 @@
 
 #include "GlobalObject.h"
 #include "positioning/PositionInfoSource_Abstract.h"
+#include "positioning/PositionInfoSource_Replay.h"
 #include "positioning/PositionInfoSource_Satellite.h"
 
 
@@ -43,6 +44,9 @@ namespace Positioning {
  *  Data from the standard operating system data source (typically: satnav or
  *  wifi) is only provided after startUpdates() has been called.
  *
+ *  While a recorded flight is replayed via replaySource(), the replayed data
+ *  takes precedence over all other sources.
+ *
  *  The methods in this class are reentrant, but not thread safe.
  */
 
@@ -144,6 +148,12 @@ public:
      */
     Q_INVOKABLE void startUpdates() { satelliteSource.startUpdates(); }
 
+    /*! \brief Source for replaying recorded flights
+     *
+     *  @returns Pointer to the replay source, owned by this PositionProvider
+     */
+    [[nodiscard]] Positioning::PositionInfoSource_Replay* replaySource() { return &m_replaySource; }
+
 signals:
     /*! \brief Notifier signal */
     void approximateLastValidCoordinateChanged();
@@ -191,6 +201,7 @@ private:
     static constexpr double EDTF_ele = 244;
 
     PositionInfoSource_Satellite satelliteSource;
+    PositionInfoSource_Replay m_replaySource;
 
     Q_OBJECT_BINDABLE_PROPERTY(PositionProvider, QGeoCoordinate, m_approximateLastValidCoordinate, &Positioning::PositionProvider::approximateLastValidCoordinateChanged)
     QProperty<QGeoCoordinate> m_lastValidCoordinate {QGeoCoordinate(EDTF_lat, EDTF_lon, EDTF_ele)};
@@ -95,6 +95,16 @@ Item {
                 importOpenAirDialog.open()
                 return
             }
+            if (fileFunction === FileExchange.WindField) {
+                var errorString = Navigator.loadWindField(fileName)
+                if (errorString !== "") {
+                    errLbl.text = errorString
+                    errorDialog.open()
+                    return
+                }
+                importManager.toast.doToast( qsTr("Winds aloft imported") )
+                return
+            }
             if (fileFunction === FileExchange.ZipFile) {
                 errLbl.text = qsTr("The file <strong>%1</strong> seems to contain an zip file without the data required in a tripkit.").arg(fileName)
                 errorDialog.open()
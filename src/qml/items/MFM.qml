@@ -361,10 +361,10 @@ Item {
         }
 
         MapItemView { // Labels for traffic opponents
-            model: TrafficDataProvider.trafficObjects
+            model: TrafficDataProvider.trafficModel
             delegate: Component {
                 TrafficLabel {
-                    trafficInfo: modelData
+                    trafficInfo: model
                 }
             }
         }
@@ -447,12 +447,24 @@ Item {
             }
         }
 
+        MapItemView { // Trails of traffic opponents
+            model: TrafficDataProvider.trafficTrails
+            delegate: Component {
+                MapPolyline {
+                    line.width: 2
+                    line.color: "gray"
+                    opacity: 0.7
+                    path: modelData.path
+                }
+            }
+        }
+
         MapItemView { // Traffic opponents
-            model: TrafficDataProvider.trafficObjects
+            model: TrafficDataProvider.trafficModel
             delegate: Component {
                 Traffic {
                     map: flightMap
-                    trafficInfo: modelData
+                    trafficInfo: model
                 }
             }
         }
@@ -202,6 +202,41 @@ Rectangle {
             font.pixelSize: dummyControl.font.pixelSize*1.3
         }
 
+        Label {
+            text: "TOD"
+            elide: Text.ElideRight
+            color: "white"
+            Layout.fillWidth: true
+            Layout.maximumWidth: implicitWidth
+            visible: (baseRect.rri.status === RemainingRouteInfo.OnRoute) && baseRect.rri.TOD_DIST.isFinite()
+            font.weight: Font.Bold
+            font.pixelSize: dummyControl.font.pixelSize*1.3
+        }
+        Item {
+            visible: baseRect.tcVisible && (baseRect.rri.status === RemainingRouteInfo.OnRoute) && baseRect.rri.TOD_DIST.isFinite()
+        }
+        Label {
+            text: Navigator.aircraft.horizontalDistanceToString(baseRect.rri.TOD_DIST)
+            color: "white"
+            Layout.alignment: Qt.AlignHCenter
+            Layout.minimumWidth: implicitWidth
+            visible: (baseRect.rri.status === RemainingRouteInfo.OnRoute) && baseRect.rri.TOD_DIST.isFinite()
+            font.weight: Font.Bold
+            font.pixelSize: dummyControl.font.pixelSize*1.3
+        }
+        Label {
+            text: "%1 h".arg(baseRect.rri.TOD_ETE.toHoursAndMinutes())
+            color: "white"
+            Layout.alignment: Qt.AlignHCenter
+            Layout.minimumWidth: implicitWidth
+            visible: (baseRect.rri.status === RemainingRouteInfo.OnRoute) && baseRect.rri.TOD_DIST.isFinite()
+            font.weight: Font.Bold
+            font.pixelSize: dummyControl.font.pixelSize*1.3
+        }
+        Item {
+            visible: (baseRect.rri.status === RemainingRouteInfo.OnRoute) && baseRect.rri.TOD_DIST.isFinite()
+        }
+
         Label {
             Layout.columnSpan: grid.columns
             Layout.fillWidth: true
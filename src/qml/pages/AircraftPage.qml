@@ -482,7 +482,7 @@ Page {
                 Layout.columnSpan: 2
                 Layout.fillWidth: true
                 Layout.alignment: Qt.AlignBaseline
-                KeyNavigation.tab: cruiseSpeed
+                KeyNavigation.tab: climbSpeed
                 visible: (Qt.platform.os !== "ios")
 
                 Component.onCompleted: {
@@ -505,6 +505,84 @@ Page {
                 font.bold: true
             }
 
+            Label {
+                text: qsTr("Climb")
+                Layout.alignment: Qt.AlignBaseline
+            }
+            MyTextField {
+                id: climbSpeed
+                Layout.fillWidth: true
+                Layout.alignment: Qt.AlignBaseline
+                Layout.minimumWidth: font.pixelSize*5
+                KeyNavigation.tab: cruiseSpeed
+
+                validator: DoubleValidator {
+                    bottom: {
+                        switch(Navigator.aircraft.horizontalDistanceUnit) {
+                        case Aircraft.NauticalMile:
+                            return Navigator.aircraft.minValidSpeed.toKN()
+                        case Aircraft.Kilometer:
+                            return Navigator.aircraft.minValidSpeed.toKMH()
+                        case Aircraft.StatuteMile :
+                            return Navigator.aircraft.minValidSpeed.toMPH()
+                        }
+                    }
+                    top: {
+                        switch(Navigator.aircraft.horizontalDistanceUnit) {
+                        case Aircraft.NauticalMile:
+                            return Navigator.aircraft.maxValidSpeed.toKN()
+                        case Aircraft.Kilometer:
+                            return Navigator.aircraft.maxValidSpeed.toKMH()
+                        case Aircraft.StatuteMile :
+                            return Navigator.aircraft.maxValidSpeed.toMPH()
+                        }
+                    }
+                    notation: DoubleValidator.StandardNotation
+                }
+                inputMethodHints: Qt.ImhDigitsOnly
+                onEditingFinished: {
+                    switch(Navigator.aircraft.horizontalDistanceUnit) {
+                    case Aircraft.NauticalMile:
+                        Navigator.aircraft.climbSpeed = aircraftPage.staticSpeed.fromKN(Number.fromLocaleString(Qt.locale(), text))
+                        return
+                    case Aircraft.Kilometer:
+                        Navigator.aircraft.climbSpeed = aircraftPage.staticSpeed.fromKMH(Number.fromLocaleString(Qt.locale(), text))
+                        return
+                    case Aircraft.StatuteMile :
+                        Navigator.aircraft.climbSpeed = aircraftPage.staticSpeed.fromMPH(Number.fromLocaleString(Qt.locale(), text))
+                        return
+                    }
+                }
+                color: (acceptableInput ? colorGlean.color : "red")
+                text: {
+                    if (!Navigator.aircraft.climbSpeed.isFinite()) {
+                        return ""
+                    }
+                    switch(Navigator.aircraft.horizontalDistanceUnit) {
+                    case Aircraft.NauticalMile:
+                        return Math.round(Navigator.aircraft.climbSpeed.toKN()).toString()
+                    case Aircraft.Kilometer:
+                        return Math.round(Navigator.aircraft.climbSpeed.toKMH()).toString()
+                    case Aircraft.StatuteMile :
+                        return Math.round(Navigator.aircraft.climbSpeed.toMPH()).toString()
+                    }
+
+                }
+            }
+            Label {
+                Layout.alignment: Qt.AlignBaseline
+                text: {
+                    switch(Navigator.aircraft.horizontalDistanceUnit) {
+                    case Aircraft.NauticalMile:
+                        return "kn";
+                    case Aircraft.Kilometer:
+                        return "km/h";
+                    case Aircraft.StatuteMile :
+                        return "mph";
+                    }
+                }
+            }
+
             Label {
                 id: colorGlean
                 text: qsTr("Cruise")
@@ -671,7 +749,7 @@ Page {
                 Layout.fillWidth: true
                 Layout.alignment: Qt.AlignBaseline
                 Layout.minimumWidth: font.pixelSize*5
-                KeyNavigation.tab: fuelConsumption
+                KeyNavigation.tab: climbRate
 
                 validator: DoubleValidator {
                     bottom: {
@@ -739,6 +817,114 @@ Page {
                 }
             }
 
+            Label { Layout.fillHeight: true }
+            Label {
+                text: qsTr("Vertical Speed")
+                Layout.columnSpan: 3
+                font.pixelSize: acftTab.font.pixelSize*1.2
+                font.bold: true
+            }
+
+            Label {
+                text: qsTr("Climb")
+                Layout.alignment: Qt.AlignBaseline
+            }
+            MyTextField {
+                id: climbRate
+                Layout.fillWidth: true
+                Layout.alignment: Qt.AlignBaseline
+                Layout.minimumWidth: font.pixelSize*5
+                KeyNavigation.tab: descentRate
+
+                validator: DoubleValidator {
+                    bottom: {
+                        if (Navigator.aircraft.verticalDistanceUnit === Aircraft.Meters) {
+                            return Navigator.aircraft.minValidVerticalSpeed.toMPS()
+                        }
+                        return Navigator.aircraft.minValidVerticalSpeed.toFPM()
+                    }
+                    top: {
+                        if (Navigator.aircraft.verticalDistanceUnit === Aircraft.Meters) {
+                            return Navigator.aircraft.maxValidVerticalSpeed.toMPS()
+                        }
+                        return Navigator.aircraft.maxValidVerticalSpeed.toFPM()
+                    }
+                    notation: DoubleValidator.StandardNotation
+                }
+                inputMethodHints: Qt.ImhFormattedNumbersOnly
+                onEditingFinished: {
+                    if (Navigator.aircraft.verticalDistanceUnit === Aircraft.Meters) {
+                        Navigator.aircraft.climbRate = aircraftPage.staticSpeed.fromMPS(Number.fromLocaleString(Qt.locale(), text))
+                        return
+                    }
+                    Navigator.aircraft.climbRate = aircraftPage.staticSpeed.fromFPM(Number.fromLocaleString(Qt.locale(), text))
+                }
+                color: (acceptableInput ? colorGlean.color : "red")
+                text: {
+                    if (!Navigator.aircraft.climbRate.isFinite()) {
+                        return ""
+                    }
+                    if (Navigator.aircraft.verticalDistanceUnit === Aircraft.Meters) {
+                        return Navigator.aircraft.climbRate.toMPS().toLocaleString(Qt.locale(), 'f', 1)
+                    }
+                    return Math.round(Navigator.aircraft.climbRate.toFPM()).toString()
+                }
+            }
+            Label {
+                Layout.alignment: Qt.AlignBaseline
+                text: (Navigator.aircraft.verticalDistanceUnit === Aircraft.Meters) ? "m/s" : "ft/min"
+            }
+
+            Label {
+                text: qsTr("Descent")
+                Layout.alignment: Qt.AlignBaseline
+            }
+            MyTextField {
+                id: descentRate
+                Layout.fillWidth: true
+                Layout.alignment: Qt.AlignBaseline
+                Layout.minimumWidth: font.pixelSize*5
+                KeyNavigation.tab: fuelConsumption
+
+                validator: DoubleValidator {
+                    bottom: {
+                        if (Navigator.aircraft.verticalDistanceUnit === Aircraft.Meters) {
+                            return Navigator.aircraft.minValidVerticalSpeed.toMPS()
+                        }
+                        return Navigator.aircraft.minValidVerticalSpeed.toFPM()
+                    }
+                    top: {
+                        if (Navigator.aircraft.verticalDistanceUnit === Aircraft.Meters) {
+                            return Navigator.aircraft.maxValidVerticalSpeed.toMPS()
+                        }
+                        return Navigator.aircraft.maxValidVerticalSpeed.toFPM()
+                    }
+                    notation: DoubleValidator.StandardNotation
+                }
+                inputMethodHints: Qt.ImhFormattedNumbersOnly
+                onEditingFinished: {
+                    if (Navigator.aircraft.verticalDistanceUnit === Aircraft.Meters) {
+                        Navigator.aircraft.descentRate = aircraftPage.staticSpeed.fromMPS(Number.fromLocaleString(Qt.locale(), text))
+                        return
+                    }
+                    Navigator.aircraft.descentRate = aircraftPage.staticSpeed.fromFPM(Number.fromLocaleString(Qt.locale(), text))
+                }
+                color: (acceptableInput ? colorGlean.color : "red")
+                text: {
+                    if (!Navigator.aircraft.descentRate.isFinite()) {
+                        return ""
+                    }
+                    if (Navigator.aircraft.verticalDistanceUnit === Aircraft.Meters) {
+                        return Navigator.aircraft.descentRate.toMPS().toLocaleString(Qt.locale(), 'f', 1)
+                    }
+                    return Math.round(Navigator.aircraft.descentRate.toFPM()).toString()
+                }
+            }
+            Label {
+                Layout.alignment: Qt.AlignBaseline
+                text: (Navigator.aircraft.verticalDistanceUnit === Aircraft.Meters) ? "m/s" : "ft/min"
+            }
+
             Label { Layout.fillHeight: true }
             Label {
                 text: qsTr("Fuel Consumption")
@@ -37,6 +37,7 @@ Page {
     property bool isAndroid: Qt.platform.os === "android"
     property bool isAndroidOrIos: isAndroid || isIos
     property angle staticAngle
+    property distance staticDistance
     property speed staticSpeed
 
     Component {
@@ -150,6 +151,7 @@ Page {
             id: grid
 
             property leg leg: ({});
+            property int index: -1
 
             Layout.fillWidth: true
 
@@ -168,6 +170,31 @@ Page {
                 }
             }
 
+            Label {
+                Layout.fillWidth: true
+                Layout.leftMargin: font.pixelSize*3
+                Layout.rightMargin: font.pixelSize
+
+                visible: text !== ""
+                wrapMode: Text.WordWrap
+
+                text: {
+                    var lines = []
+                    var crossings = Navigator.airspaceCrossings
+                    for (var i=0; i<crossings.length; i++) {
+                        var crossing = crossings[i]
+                        if (crossing.leg !== grid.index)
+                            continue
+                        var airspace = crossing.airspace
+                        var bounds = (Navigator.aircraft.verticalDistanceUnit === Aircraft.Meters)
+                                ? airspace.lowerBoundMetric + " – " + airspace.upperBoundMetric
+                                : airspace.lowerBound + " – " + airspace.upperBound
+                        lines.push(airspace.CAT + " " + airspace.name + ", " + bounds)
+                    }
+                    return lines.join("<br>")
+                }
+            }
+
         }
     }
 
@@ -415,6 +442,18 @@ Page {
                     }
                 }
 
+                MenuItem {
+                    text: qsTr("Optimize")
+                    enabled: (Navigator.flightRoute.size > 3) && (sv.currentIndex === 0)
+
+                    onTriggered: {
+                        PlatformAdaptor.vibrateBrief()
+                        highlighted = false
+                        Navigator.flightRoute.optimize()
+                        toast.doToast(qsTr("Flight route optimized"))
+                    }
+                }
+
             }
         }
     }
@@ -497,7 +536,7 @@ Page {
                             var legs = Navigator.flightRoute.legs
                             var j
                             for (j=0; j<legs.length; j++) {
-                                legComponent.createObject(co, {leg: legs[j]});
+                                legComponent.createObject(co, {leg: legs[j], index: j});
                                 waypointComponent.createObject(co, {waypoint: legs[j].endPoint, index: j+1});
                             }
                         }
@@ -649,6 +688,66 @@ Page {
                     Layout.alignment: Qt.AlignBaseline
                 }
 
+                Label {
+                    Layout.fillHeight: true
+                    Layout.columnSpan: 3
+                }
+                Label {
+                    text: qsTr("Vertical Profile")
+                    Layout.columnSpan: 3
+                    font.pixelSize: windTab.font.pixelSize*1.2
+                    font.bold: true
+                }
+
+                Label {
+                    text: qsTr("Cruise Altitude")
+                    Layout.alignment: Qt.AlignBaseline
+                }
+                MyTextField {
+                    id: cruiseAltitude
+                    Layout.fillWidth: true
+                    Layout.alignment: Qt.AlignBaseline
+                    Layout.minimumWidth: font.pixelSize*5
+                    validator: IntValidator {
+                        bottom: 0
+                        top: (Navigator.aircraft.verticalDistanceUnit === Aircraft.Meters) ? 6000 : 20000
+                    }
+                    inputMethodHints: Qt.ImhDigitsOnly
+                    onEditingFinished: {
+                        if (text === "") {
+                            Navigator.cruiseAltitude = flightRoutePage.staticDistance.fromM(NaN)
+                        } else if (Navigator.aircraft.verticalDistanceUnit === Aircraft.Meters) {
+                            Navigator.cruiseAltitude = flightRoutePage.staticDistance.fromM(Number.fromLocaleString(Qt.locale(), text))
+                        } else {
+                            Navigator.cruiseAltitude = flightRoutePage.staticDistance.fromFT(Number.fromLocaleString(Qt.locale(), text))
+                        }
+                        focus = false
+                    }
+                    color: (acceptableInput ? colorGlean.color : "red")
+                    text: {
+                        if (!Navigator.cruiseAltitude.isFinite()) {
+                            return ""
+                        }
+                        if (Navigator.aircraft.verticalDistanceUnit === Aircraft.Meters) {
+                            return Math.round( Navigator.cruiseAltitude.toM() )
+                        }
+                        return Math.round( Navigator.cruiseAltitude.toFeet() )
+                    }
+                }
+                Label {
+                    text: (Navigator.aircraft.verticalDistanceUnit === Aircraft.Meters) ? "m" : "ft"
+                    Layout.alignment: Qt.AlignBaseline
+                }
+
+                Label {
+                    Layout.fillWidth: true
+                    Layout.columnSpan: 3
+                    text: Navigator.hasWindField
+                          ? qsTr("Winds aloft have been loaded. The estimated wind is used only where the winds aloft have no data.")
+                          : qsTr("The estimated wind is used at all altitudes.")
+                    wrapMode: Text.WordWrap
+                }
+
             }
 
         }
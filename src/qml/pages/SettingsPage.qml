@@ -332,6 +332,98 @@ Page {
                 }
             }
 
+            WordWrappingSwitchDelegate {
+                id: trafficDataThread
+                text: qsTr("Read Traffic Data in Background")
+                icon.source: "/icons/material/ic_wifi.svg"
+                Layout.fillWidth: true
+                Component.onCompleted: {
+                    trafficDataThread.checked = GlobalSettings.trafficDataThread
+                }
+                onToggled: {
+                    PlatformAdaptor.vibrateBrief()
+                    GlobalSettings.trafficDataThread = trafficDataThread.checked
+                }
+            }
+            ToolButton {
+                icon.source: "/icons/material/ic_info_outline.svg"
+                onClicked: {
+                    PlatformAdaptor.vibrateBrief()
+                    helpDialog.title = qsTr("Read Traffic Data in Background")
+                    helpDialog.text = "<p>" + qsTr("If this item is checked, network connections to traffic data receivers are read on a dedicated background thread. Traffic warnings will then not be delayed if the display is slow to update. The setting takes effect when the app next connects to a traffic data receiver.") + "</p>"
+                    helpDialog.open()
+                }
+            }
+
+            WordWrappingSwitchDelegate {
+                id: trafficDataFusion
+                text: qsTr("Combine Traffic Data Sources")
+                icon.source: "/icons/material/ic_wifi.svg"
+                Layout.fillWidth: true
+                Component.onCompleted: {
+                    trafficDataFusion.checked = GlobalSettings.trafficDataFusion
+                }
+                onToggled: {
+                    PlatformAdaptor.vibrateBrief()
+                    GlobalSettings.trafficDataFusion = trafficDataFusion.checked
+                }
+            }
+            ToolButton {
+                icon.source: "/icons/material/ic_info_outline.svg"
+                onClicked: {
+                    PlatformAdaptor.vibrateBrief()
+                    helpDialog.title = qsTr("Combine Traffic Data Sources")
+                    helpDialog.text = "<p>" + qsTr("By default, the app shows traffic from one traffic data receiver only, even if several receivers are connected. If this item is checked, traffic from all connected receivers is shown, for instance from a FLARM device and an ADS-B receiver. Aircraft that are reported by several receivers are shown only once.") + "</p>"
+                    helpDialog.open()
+                }
+            }
+
+            WordWrappingSwitchDelegate {
+                id: trafficDataBroadcast
+                text: qsTr("Share Traffic Data")
+                icon.source: "/icons/material/ic_wifi.svg"
+                Layout.fillWidth: true
+                Component.onCompleted: {
+                    trafficDataBroadcast.checked = GlobalSettings.trafficDataBroadcast
+                }
+                onToggled: {
+                    PlatformAdaptor.vibrateBrief()
+                    GlobalSettings.trafficDataBroadcast = trafficDataBroadcast.checked
+                }
+            }
+            ToolButton {
+                icon.source: "/icons/material/ic_info_outline.svg"
+                onClicked: {
+                    PlatformAdaptor.vibrateBrief()
+                    helpDialog.title = qsTr("Share Traffic Data")
+                    helpDialog.text = "<p>" + qsTr("If this item is checked, the app broadcasts the position of your aircraft and the traffic it receives to the local network, in GDL90 format on UDP port 4000. Other apps on the cockpit network can then display the same traffic.") + "</p>"
+                    helpDialog.open()
+                }
+            }
+
+            WordWrappingSwitchDelegate {
+                id: flightRecorder
+                text: qsTr("Record Flights")
+                icon.source: "/icons/material/ic_airplanemode_active.svg"
+                Layout.fillWidth: true
+                Component.onCompleted: {
+                    flightRecorder.checked = FlightRecorder.enabled
+                }
+                onToggled: {
+                    PlatformAdaptor.vibrateBrief()
+                    FlightRecorder.enabled = flightRecorder.checked
+                }
+            }
+            ToolButton {
+                icon.source: "/icons/material/ic_info_outline.svg"
+                onClicked: {
+                    PlatformAdaptor.vibrateBrief()
+                    helpDialog.title = qsTr("Record Flights")
+                    helpDialog.text = "<p>" + qsTr("If this item is checked, the app records your position, your altitude and the traffic reported by your traffic data receiver. The flight logs are kept on this device only.") + "</p>"
+                    helpDialog.open()
+                }
+            }
+
             WordWrappingSwitchDelegate {
                 id: ignoreSSL
                 text: qsTr("Ignore Network Security Errors")
@@ -0,0 +1,340 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+#include "traffic/ConflictDetector.h"
+
+
+namespace {
+
+// Mean earth radius in meters
+constexpr double earthRadiusInM = 6371000.0;
+
+// Track state is forgotten after this period without report
+constexpr qint64 trackStateLifetimeInMS = 30000;
+
+// Splits the ground speed into east and north components, in meters per
+// second. Unknown values yield zero speed.
+void velocity(const Positioning::PositionInfo& positionInfo, double& vx, double& vy)
+{
+    vx = 0.0;
+    vy = 0.0;
+    auto const groundSpeed = positionInfo.groundSpeed();
+    auto const trueTrack = positionInfo.trueTrack();
+    if (!groundSpeed.isFinite() || !trueTrack.isFinite())
+    {
+        return;
+    }
+    vx = groundSpeed.toMPS()*std::sin(trueTrack.toRAD());
+    vy = groundSpeed.toMPS()*std::cos(trueTrack.toRAD());
+}
+
+// Vertical speed in meters per second. Unknown values yield zero speed.
+double verticalSpeed(const Positioning::PositionInfo& positionInfo)
+{
+    auto const vSpeed = positionInfo.verticalSpeed();
+    return vSpeed.isFinite() ? vSpeed.toMPS() : 0.0;
+}
+
+} // namespace
+
+
+//
+// Methods
+//
+
+qsizetype Traffic::ConflictDetector::addTarget(const QString& ID, const Positioning::PositionInfo& positionInfo, Units::Distance vDist)
+{
+    auto const coordinate = positionInfo.coordinate();
+    bool const valid = m_ownshipCoordinate.isValid() && coordinate.isValid();
+
+    // Position in the local coordinate system. Over the short distances
+    // relevant here, an equirectangular projection is accurate enough.
+    double x = 0.0;
+    double y = 0.0;
+    if (valid)
+    {
+        auto dLon = coordinate.longitude() - m_ownshipCoordinate.longitude();
+        if (dLon > 180.0)
+        {
+            dLon -= 360.0;
+        }
+        if (dLon < -180.0)
+        {
+            dLon += 360.0;
+        }
+        auto const dLat = coordinate.latitude() - m_ownshipCoordinate.latitude();
+        auto const degToM = earthRadiusInM*std::numbers::pi/180.0;
+        x = dLon*degToM*std::cos(m_ownshipCoordinate.latitude()*std::numbers::pi/180.0);
+        y = dLat*degToM;
+    }
+
+    double vx = 0.0;
+    double vy = 0.0;
+    velocity(positionInfo, vx, vy);
+
+    m_x.push_back(x);
+    m_y.push_back(y);
+    m_vx.push_back(vx);
+    m_vy.push_back(vy);
+    m_turnRate.push_back(updateTurnRate(m_trackStates[ID], positionInfo));
+    m_dz.push_back(vDist.isFinite() ? vDist.toM() : std::numeric_limits<double>::quiet_NaN());
+    m_dvz.push_back(verticalSpeed(positionInfo) - m_ownshipVZ);
+    m_valid.push_back(valid ? 1 : 0);
+    return size()-1;
+}
+
+
+int Traffic::ConflictDetector::alarmLevel(qsizetype index) const
+{
+    if ((index < 0) || (index >= static_cast<qsizetype>(m_alarmLevel.size())))
+    {
+        return 0;
+    }
+    return m_alarmLevel[index];
+}
+
+
+void Traffic::ConflictDetector::clearTargets()
+{
+    m_x.clear();
+    m_y.clear();
+    m_vx.clear();
+    m_vy.clear();
+    m_turnRate.clear();
+    m_dz.clear();
+    m_dvz.clear();
+    m_valid.clear();
+    m_timeToCPA.clear();
+    m_distanceAtCPA.clear();
+    m_alarmLevel.clear();
+}
+
+
+void Traffic::ConflictDetector::compute()
+{
+    auto const numTargets = m_x.size();
+    m_timeToCPA.assign(numTargets, std::numeric_limits<double>::quiet_NaN());
+    m_distanceAtCPA.assign(numTargets, std::numeric_limits<double>::quiet_NaN());
+    m_alarmLevel.assign(numTargets, 0);
+    if (!m_ownshipCoordinate.isValid() || (numTargets == 0))
+    {
+        return;
+    }
+
+    // Working copies of the traffic state, which are advanced in time
+    std::vector<double> x(m_x);
+    std::vector<double> y(m_y);
+    std::vector<double> vx(m_vx);
+    std::vector<double> vy(m_vy);
+
+    // Rotation of the velocity vectors per time step
+    std::vector<double> cosTurn(numTargets);
+    std::vector<double> sinTurn(numTargets);
+    for(size_t i=0; i<numTargets; i++)
+    {
+        cosTurn[i] = std::cos(m_turnRate[i]*timeStepInS);
+        sinTurn[i] = std::sin(m_turnRate[i]*timeStepInS);
+    }
+
+    // Ownship state
+    double ownX = 0.0;
+    double ownY = 0.0;
+    double ownVX = m_ownshipVX;
+    double ownVY = m_ownshipVY;
+    auto const ownCosTurn = std::cos(m_ownshipTurnRate*timeStepInS);
+    auto const ownSinTurn = std::sin(m_ownshipTurnRate*timeStepInS);
+
+    // Minimal squared distance and time of minimal distance, per traffic
+    std::vector<double> minDistSquared(numTargets, std::numeric_limits<double>::infinity());
+    std::vector<double> timeOfMin(numTargets, 0.0);
+
+    // Time stepping. The inner loops over the traffic are free of branches.
+    // Velocities are rotated by the turn angle of one time step, positions are
+    // advanced with the mean velocity of the step.
+    auto const numSteps = static_cast<int>(lookaheadInS/timeStepInS);
+    for(int step=0; step<=numSteps; step++)
+    {
+        auto const t = step*timeStepInS;
+
+        for(size_t i=0; i<numTargets; i++)
+        {
+            auto const dx = x[i]-ownX;
+            auto const dy = y[i]-ownY;
+            auto const distSquared = dx*dx + dy*dy;
+            auto const closer = distSquared < minDistSquared[i];
+            minDistSquared[i] = closer ? distSquared : minDistSquared[i];
+            timeOfMin[i] = closer ? t : timeOfMin[i];
+        }
+
+        for(size_t i=0; i<numTargets; i++)
+        {
+            auto const newVX = cosTurn[i]*vx[i] + sinTurn[i]*vy[i];
+            auto const newVY = cosTurn[i]*vy[i] - sinTurn[i]*vx[i];
+            x[i] += 0.5*timeStepInS*(vx[i]+newVX);
+            y[i] += 0.5*timeStepInS*(vy[i]+newVY);
+            vx[i] = newVX;
+            vy[i] = newVY;
+        }
+
+        auto const newOwnVX = ownCosTurn*ownVX + ownSinTurn*ownVY;
+        auto const newOwnVY = ownCosTurn*ownVY - ownSinTurn*ownVX;
+        ownX += 0.5*timeStepInS*(ownVX+newOwnVX);
+        ownY += 0.5*timeStepInS*(ownVY+newOwnVY);
+        ownVX = newOwnVX;
+        ownVY = newOwnVY;
+    }
+
+    // Evaluate
+    auto const hSep = horizontalSeparation.toM();
+    auto const vSep = verticalSeparation.toM();
+    for(size_t i=0; i<numTargets; i++)
+    {
+        if (m_valid[i] == 0)
+        {
+            continue;
+        }
+        auto const distance = std::sqrt(minDistSquared[i]);
+        auto const time = timeOfMin[i];
+        m_distanceAtCPA[i] = distance;
+        m_timeToCPA[i] = time;
+
+        // Traffic at the position of the own aircraft is the echo of the own
+        // transponder, as reported by ADS-B receivers
+        auto const hasVerticalData = std::isfinite(m_dz[i]);
+        auto const initialDistance = std::hypot(m_x[i], m_y[i]);
+        if ((initialDistance < echoDistance.toM()) && (!hasVerticalData || (std::abs(m_dz[i]) < echoDistance.toM())))
+        {
+            continue;
+        }
+
+        // Only closing traffic is in conflict. Traffic that is diverging
+        // already has its closest point of approach at time zero.
+        auto const rangeRate = m_x[i]*(m_vx[i]-m_ownshipVX) + m_y[i]*(m_vy[i]-m_ownshipVY);
+        if ((time <= 0.0) || (rangeRate >= 0.0))
+        {
+            continue;
+        }
+
+        if (distance >= hSep)
+        {
+            continue;
+        }
+        auto const dz = m_dz[i] + m_dvz[i]*time;
+        if (hasVerticalData && (std::abs(dz) >= vSep))
+        {
+            continue;
+        }
+
+        if (time <= 8.0)
+        {
+            m_alarmLevel[i] = 3;
+        }
+        else if (time <= 12.0)
+        {
+            m_alarmLevel[i] = 2;
+        }
+        else
+        {
+            m_alarmLevel[i] = 1;
+        }
+
+        // Without vertical data, the traffic might well be separated
+        if (!hasVerticalData)
+        {
+            m_alarmLevel[i] = std::min(m_alarmLevel[i], 1);
+        }
+    }
+}
+
+
+Units::Distance Traffic::ConflictDetector::distanceAtCPA(qsizetype index) const
+{
+    if ((index < 0) || (index >= static_cast<qsizetype>(m_distanceAtCPA.size())))
+    {
+        return {};
+    }
+    return Units::Distance::fromM(m_distanceAtCPA[index]);
+}
+
+
+void Traffic::ConflictDetector::setOwnship(const Positioning::PositionInfo& ownship)
+{
+    m_ownshipCoordinate = ownship.coordinate();
+    velocity(ownship, m_ownshipVX, m_ownshipVY);
+    m_ownshipVZ = verticalSpeed(ownship);
+    m_ownshipTurnRate = updateTurnRate(m_ownshipTrack, ownship);
+
+    // Forget traffic that has not been reported for a while
+    auto const now = ownship.timestamp().isValid() ? ownship.timestamp().toMSecsSinceEpoch() : QDateTime::currentMSecsSinceEpoch();
+    m_trackStates.removeIf([now](const QHash<QString, TrackState>::iterator it) {
+        return now - it.value().timestampInMS > trackStateLifetimeInMS;
+    });
+}
+
+
+Units::Timespan Traffic::ConflictDetector::timeToCPA(qsizetype index) const
+{
+    if ((index < 0) || (index >= static_cast<qsizetype>(m_timeToCPA.size())))
+    {
+        return {};
+    }
+    return Units::Timespan::fromS(m_timeToCPA[index]);
+}
+
+
+double Traffic::ConflictDetector::updateTurnRate(TrackState& state, const Positioning::PositionInfo& positionInfo)
+{
+    auto const trueTrack = positionInfo.trueTrack();
+    auto const timestamp = positionInfo.timestamp();
+    if (!trueTrack.isFinite() || !timestamp.isValid())
+    {
+        state = TrackState();
+        return 0.0;
+    }
+
+    auto const track = trueTrack.toRAD();
+    auto const timestampInMS = timestamp.toMSecsSinceEpoch();
+    auto const deltaT = static_cast<double>(timestampInMS - state.timestampInMS)/1000.0;
+
+    // Report does not contain new information
+    if (deltaT <= 0.0)
+    {
+        return state.turnRateInRadPerS;
+    }
+
+    // Estimate turn rate from the change of track. Reports that are too far
+    // apart do not give meaningful estimates.
+    double turnRate = 0.0;
+    if ((state.timestampInMS != 0) && (deltaT <= 5.0))
+    {
+        auto deltaTrack = std::remainder(track - state.trackInRad, 2.0*std::numbers::pi);
+        turnRate = std::clamp(deltaTrack/deltaT, -maxTurnRateInRadPerS, maxTurnRateInRadPerS);
+    }
+
+    state.trackInRad = track;
+    state.turnRateInRadPerS = turnRate;
+    state.timestampInMS = timestampInMS;
+    return turnRate;
+}
@@ -0,0 +1,224 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QHash>
+#include <vector>
+
+#include "positioning/PositionInfo.h"
+#include "units/Distance.h"
+#include "units/Timespan.h"
+
+
+namespace Traffic {
+
+/*! \brief Collision prediction for traffic
+ *
+ *  This class predicts conflicts between the own aircraft and traffic. Own
+ *  aircraft and traffic are extrapolated along their current track, either
+ *  linearly or, if the track has changed between two consecutive reports,
+ *  along a turn arc with constant turn rate.  For every traffic, the class
+ *  computes time and horizontal distance at the closest point of approach
+ *  (CPA) within a lookahead period, and assigns an alarm level with the
+ *  meaning used by FLARM.
+ *
+ *  Only traffic that is closing in, with a CPA in the future, can be in
+ *  conflict. Traffic without vertical distance is alarmed at most with level
+ *  1. Traffic at the position of the own aircraft is taken as the echo of the
+ *  own transponder and is never in conflict.
+ *
+ *  The data is held in flat arrays, one entry per traffic, and the time
+ *  stepping loops run over all traffic at once. The compiler can vectorize
+ *  these loops, so that a few hundred traffic factors can be handled at every
+ *  position update.
+ *
+ *  Typical use:
+ *
+ *  - call setOwnship() with the current position of the own aircraft,
+ *  - call clearTargets(), then addTarget() for every traffic,
+ *  - call compute(), then read the results using alarmLevel(), timeToCPA()
+ *    and distanceAtCPA().
+ */
+
+class ConflictDetector
+{
+public:
+    /*! \brief Standard constructor */
+    ConflictDetector() = default;
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Add a traffic
+     *
+     *  @param ID Identifier of the traffic. This is used to estimate the turn
+     *  rate from consecutive reports.
+     *
+     *  @param positionInfo Position, track, ground speed and vertical speed of
+     *  the traffic. Traffic without valid coordinate is never in conflict.
+     *
+     *  @param vDist Vertical distance from own aircraft to the traffic. If NaN,
+     *  only the horizontal distance is considered, and the alarm level is at
+     *  most 1.
+     *
+     *  @returns Index of the traffic, to be used with the result accessors
+     */
+    qsizetype addTarget(const QString& ID, const Positioning::PositionInfo& positionInfo, Units::Distance vDist);
+
+    /*! \brief Alarm level of a traffic
+     *
+     *  @param index Index, as returned by addTarget()
+     *
+     *  @returns Alarm level in the range 0, …, 3, with the meaning of
+     *  Traffic::Warning::alarmLevel(). Before compute() is called, 0 is
+     *  returned.
+     */
+    [[nodiscard]] int alarmLevel(qsizetype index) const;
+
+    /*! \brief Remove all traffic
+     *
+     *  Turn rate estimates are kept.
+     */
+    void clearTargets();
+
+    /*! \brief Predict conflicts for all traffic */
+    void compute();
+
+    /*! \brief Horizontal distance at the closest point of approach
+     *
+     *  @param index Index, as returned by addTarget()
+     *
+     *  @returns Distance, or NaN if unknown
+     */
+    [[nodiscard]] Units::Distance distanceAtCPA(qsizetype index) const;
+
+    /*! \brief Set position of own aircraft
+     *
+     *  @param ownship Position, track, ground speed and vertical speed of the
+     *  own aircraft. If the coordinate is invalid, no conflicts are predicted.
+     */
+    void setOwnship(const Positioning::PositionInfo& ownship);
+
+    /*! \brief Number of traffic
+     *
+     *  @returns Number of traffic added since the last call to clearTargets()
+     */
+    [[nodiscard]] qsizetype size() const
+    {
+        return static_cast<qsizetype>(m_x.size());
+    }
+
+    /*! \brief Time to the closest point of approach
+     *
+     *  @param index Index, as returned by addTarget()
+     *
+     *  @returns Time, or NaN if unknown
+     */
+    [[nodiscard]] Units::Timespan timeToCPA(qsizetype index) const;
+
+
+    //
+    // Constants
+    //
+
+    /*! \brief Minimal horizontal separation
+     *
+     *  Traffic whose horizontal distance at CPA is less than this number is in
+     *  conflict, unless it is vertically separated.
+     */
+    static constexpr Units::Distance horizontalSeparation = Units::Distance::fromM(300.0);
+
+    /*! \brief Minimal vertical separation
+     *
+     *  Traffic whose vertical distance at CPA is less than this number is in
+     *  conflict, unless it is horizontally separated.
+     */
+    static constexpr Units::Distance verticalSeparation = Units::Distance::fromM(150.0);
+
+    /*! \brief Maximal distance of the echo of the own transponder
+     *
+     *  Traffic whose horizontal and vertical distance to the own aircraft are
+     *  both less than this number is taken as the own aircraft.
+     */
+    static constexpr Units::Distance echoDistance = Units::Distance::fromM(30.0);
+
+    /*! \brief Lookahead period in seconds
+     *
+     *  This matches the longest time to impact for which FLARM issues alarms.
+     */
+    static constexpr double lookaheadInS = 18.0;
+
+    /*! \brief Time step used for extrapolation, in seconds */
+    static constexpr double timeStepInS = 0.5;
+
+    /*! \brief Maximal turn rate, in radians per second
+     *
+     *  Estimated turn rates are clamped to this value. This avoids absurd
+     *  extrapolation when the track jumps, for instance after a reception gap.
+     */
+    static constexpr double maxTurnRateInRadPerS = 0.35;
+
+private:
+    // Track and turn rate of a traffic, as estimated from consecutive reports
+    struct TrackState
+    {
+        double trackInRad {0.0};
+        double turnRateInRadPerS {0.0};
+        qint64 timestampInMS {0};
+    };
+
+    // Updates the track state with a new report and returns the turn rate in
+    // radians per second. Reports without track yield a turn rate of zero.
+    static double updateTurnRate(TrackState& state, const Positioning::PositionInfo& positionInfo);
+
+    // Ownship state. Position is the origin of the local coordinate system
+    // (x east, y north, in meters).
+    QGeoCoordinate m_ownshipCoordinate;
+    double m_ownshipVX {0.0};
+    double m_ownshipVY {0.0};
+    double m_ownshipVZ {0.0};
+    double m_ownshipTurnRate {0.0};
+    TrackState m_ownshipTrack;
+
+    // Turn rate estimates, by traffic ID
+    QHash<QString, TrackState> m_trackStates;
+
+    // Traffic state, one entry per traffic. Position in the local coordinate
+    // system, vertical distance and vertical speed relative to the ownship.
+    // Traffic without valid coordinate is marked in m_valid.
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    std::vector<double> m_vx;
+    std::vector<double> m_vy;
+    std::vector<double> m_turnRate;
+    std::vector<double> m_dz;
+    std::vector<double> m_dvz;
+    std::vector<char> m_valid;
+
+    // Results, one entry per traffic
+    std::vector<double> m_timeToCPA;
+    std::vector<double> m_distanceAtCPA;
+    std::vector<int> m_alarmLevel;
+};
+
+} // namespace Traffic
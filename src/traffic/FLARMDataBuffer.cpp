@@ -0,0 +1,82 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include "traffic/FLARMDataBuffer.h"
+#include "traffic/TrafficDataSource_Abstract.h"
+
+
+namespace {
+
+// Checks if data is a sentence with valid checksum
+bool isNMEASentence(const QString& data)
+{
+    return !Traffic::TrafficDataSource_Abstract::getNMEAMessage(data).isEmpty();
+}
+
+bool isNMEASentence(const QByteArray& data)
+{
+    return !Traffic::TrafficDataSource_Abstract::getNMEAMessage(QString::fromLatin1(data)).isEmpty();
+}
+
+} // namespace
+
+
+template<typename T>
+void Traffic::FLARMDataBuffer<T>::append(const T& data, const std::function<void(const T&)>& processSentence)
+{
+    m_buffer += data;
+
+    // Abort if the buffer is small that it cannot possibly contain a single valid NMEA sentence.
+    if (m_buffer.length() < 5)
+    {
+        return;
+    }
+
+    // Search for the first '$' that is *not* at the beginning of the string. If a '$' is found, interpret
+    // the beginning of the string as a NMEA sentence and shorten the buffer.
+    auto idx = m_buffer.indexOf('$', 1);
+    while (idx != -1)
+    {
+        T const potentialSentence = m_buffer.first(idx);
+        m_buffer.remove(0, idx);
+        processSentence(potentialSentence);
+        idx = m_buffer.indexOf('$', 1);
+    }
+
+    // m_buffer is a string that might be a full or incomplete NMEA sentence.
+    // If it is a full sentence, then consume it. Otherwise, ignore it.
+    if (isNMEASentence(m_buffer))
+    {
+        T const sentence = m_buffer;
+        m_buffer.clear();
+        processSentence(sentence);
+    }
+
+    // Discard garbage
+    if (m_buffer.length() > maxSize)
+    {
+        m_buffer.clear();
+    }
+}
+
+
+template class Traffic::FLARMDataBuffer<QByteArray>;
+template class Traffic::FLARMDataBuffer<QString>;
@@ -0,0 +1,80 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <functional>
+
+
+namespace Traffic {
+
+/*! \brief Splits a stream of FLARM/NMEA data into sentences
+ *
+ *  Data connections deliver FLARM/NMEA data in chunks that need not coincide
+ *  with sentences. This class collects the data and hands every sentence to a
+ *  callback as soon as it is complete. A sentence starts with '$' and ends
+ *  before the next '$'. Data at the end of the buffer is handed over only if
+ *  it already is a sentence with valid checksum. Buffered data that grows
+ *  beyond maxSize without containing a sentence is discarded, so that garbage
+ *  on the data connection cannot exhaust memory.
+ *
+ *  @tparam T QString or QByteArray
+ */
+template<typename T>
+class FLARMDataBuffer
+{
+public:
+    /*! \brief Append data
+     *
+     *  @param data FLARM/NMEA data
+     *
+     *  @param processSentence Callback, called once for every sentence that
+     *  is complete. The sentence might have an invalid checksum.
+     */
+    void append(const T& data, const std::function<void(const T&)>& processSentence);
+
+    /*! \brief Discard buffered data */
+    void clear()
+    {
+        m_buffer.clear();
+    }
+
+
+    //
+    // Constants
+    //
+
+    /*! \brief Maximal size of buffered data
+     *
+     *  Valid sentences are much shorter.
+     */
+    static constexpr qsizetype maxSize = 1024;
+
+private:
+    T m_buffer;
+};
+
+extern template class FLARMDataBuffer<QByteArray>;
+extern template class FLARMDataBuffer<QString>;
+
+} // namespace Traffic
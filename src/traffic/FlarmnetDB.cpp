@@ -1,5 +1,5 @@
 /***************************************************************************
- *   Copyright (C) 2021 by Stefan Kebekus                                  *
+ *   Copyright (C) 2021-2024 by Stefan Kebekus                             *
  *   stefan.kebekus@gmail.com                                              *
  *                                                                         *
  *   This program is free software; you can redistribute it and/or modify  *
@@ -20,21 +20,63 @@
 
 #include <QCoreApplication>
 #include <QTimer>
+#include <QtConcurrent>
+#include <algorithm>
+#include <limits>
 
 #include "GlobalObject.h"
 #include "dataManagement/DataManager.h"
 #include "traffic/FlarmnetDB.h"
 
+using namespace std::chrono_literals;
+
+
+namespace {
+
+// Layout of the database file: a header line, followed by lines of fixed size.
+// Each line holds the Flarm ID as six hex digits, followed by the registration.
+constexpr qint64 lineSize = 24;
+constexpr qint64 keySize = 6;
+constexpr qint64 valueOffset = 7;
+constexpr qint64 valueSize = 15;
+
+// Maximal number of unknown Flarm IDs that are remembered
+constexpr qsizetype maxUnknownIDs = 4096;
+
+} // namespace
+
 
 Traffic::FlarmnetDB::FlarmnetDB(QObject* parent) : QObject(parent)
 {
+    m_cache.setMaxCost(defaultCacheCapacity);
+
+    m_batchTimer.setInterval(100ms);
+    m_batchTimer.setSingleShot(true);
+    connect(&m_batchTimer, &QTimer::timeout, this, &Traffic::FlarmnetDB::startBatch);
+    connect(&m_batchWatcher, &QFutureWatcher<BatchResult>::finished, this, &Traffic::FlarmnetDB::onBatchFinished);
+
     QTimer::singleShot(0, this, &Traffic::FlarmnetDB::deferredInitialization);
 }
 
 
+Traffic::FlarmnetDB::~FlarmnetDB()
+{
+    m_batchWatcher.waitForFinished();
+}
+
+
 void Traffic::FlarmnetDB::clearCache()
 {
     m_cache.clear();
+    m_unknownIDs.clear();
+    openFile();
+}
+
+
+void Traffic::FlarmnetDB::closeFile()
+{
+    // Running batch lookups keep their own reference to the database
+    m_database.reset();
 }
 
 
@@ -71,11 +113,13 @@ void Traffic::FlarmnetDB::findFlarmnetDBDownloadable()
     }
 
     if (flarmnetDBDownloadable != nullptr) {
+        disconnect(flarmnetDBDownloadable, &DataManagement::Downloadable_SingleFile::aboutToChangeFile, this, &Traffic::FlarmnetDB::closeFile);
         disconnect(flarmnetDBDownloadable, &DataManagement::Downloadable_Abstract::fileContentChanged, this, &Traffic::FlarmnetDB::clearCache);
     }
 
     flarmnetDBDownloadable = newFlarmnetDBDownloadable;
     if (flarmnetDBDownloadable != nullptr) {
+        connect(flarmnetDBDownloadable, &DataManagement::Downloadable_SingleFile::aboutToChangeFile, this, &Traffic::FlarmnetDB::closeFile);
         connect(flarmnetDBDownloadable, &DataManagement::Downloadable_Abstract::fileContentChanged, this, &Traffic::FlarmnetDB::clearCache);
 
         // Create an empty file, if no file exists. We set the FileModificationTime
@@ -95,7 +139,7 @@ void Traffic::FlarmnetDB::findFlarmnetDBDownloadable()
 }
 
 
-auto Traffic::FlarmnetDB::getRegistration(const QString& key) -> QString
+auto Traffic::FlarmnetDB::getCachedRegistration(const QString& key) -> QString
 {
     if (key.contains(u"!"_qs)) {
         auto result = key.section('!', -1, -1);
@@ -108,65 +152,253 @@ auto Traffic::FlarmnetDB::getRegistration(const QString& key) -> QString
         return *cachedValue;
     }
 
-    auto result = getRegistrationFromFile(key);
-    m_cache.insert(key, new QString(result));
-    return result;
+    quint32 ID = 0;
+    if (!parseID(key, ID) || m_unknownIDs.contains(ID)) {
+        return {};
+    }
+
+    // Queue key for the next batch
+    if (!m_keysInFlight.contains(key)) {
+        m_queuedKeys.insert(key);
+        if (!m_batchTimer.isActive()) {
+            m_batchTimer.start();
+        }
+    }
+    return {};
 }
 
 
-auto Traffic::FlarmnetDB::getRegistrationFromFile(const QString& key) -> QString
+auto Traffic::FlarmnetDB::getRegistration(const QString& key) -> QString
 {
+    if (key.contains(u"!"_qs)) {
+        auto result = key.section('!', -1, -1);
+        return result;
+    }
 
-    // If not in the cache, try to find the values in the file.
-    if (flarmnetDBDownloadable == nullptr) {
-        return {};
+    // Check if key exists in the cache
+    auto* cachedValue = m_cache[key];
+    if (cachedValue != nullptr) {
+        return *cachedValue;
     }
 
-    QFile dataFile(flarmnetDBDownloadable->fileName());
-    if (!dataFile.open(QIODevice::ReadOnly)) {
-        dataFile.open(QIODevice::WriteOnly);
-        dataFile.write(tr("Placeholder file.").toLatin1());
-        dataFile.flush();
-        dataFile.setFileTime(QDateTime( QDate(2021, 8, 21), QTime(13, 0)), QFileDevice::FileModificationTime);
+    quint32 ID = 0;
+    if (!parseID(key, ID) || m_unknownIDs.contains(ID)) {
         return {};
     }
-    dataFile.readLine();
-
-    // Now to a binary search in the file
-    qint64 const lineSize = 24;
-    qint64 const firstEntry = dataFile.pos();
-    qint64 const numEntries = (dataFile.size() - firstEntry) / lineSize;
-
-    auto getKey = [firstEntry, lineSize](QFile& dataFile, qint64 entry) {
-        dataFile.seek(firstEntry + entry*lineSize);
-        return QString::fromLatin1(dataFile.readLine(7));
-    };
-    auto getVal = [firstEntry, lineSize](QFile& dataFile, qint64 entry) {
-        dataFile.seek(firstEntry + entry*lineSize + 7);
-        return QString::fromLatin1(dataFile.readLine(16)).simplified();
-    };
-
-    qint64 startIndex = 0;
-    qint64 endIndex   = numEntries-1;
-    do{
-        if (getKey(dataFile, startIndex) == key) {
-            auto value = getVal(dataFile, startIndex);
-            return value;
+    if (m_database == nullptr) {
+        return {};
+    }
+
+    auto result = m_database->registration(ID);
+    storeInCache(key, ID, result);
+    return result.value_or(QString());
+}
+
+
+auto Traffic::FlarmnetDB::lookupBatch(const std::shared_ptr<const Database>& database, const QStringList& keys) -> BatchResult
+{
+    BatchResult result;
+    result.database = database;
+
+    // Sort the IDs, so that the index is traversed in a single pass
+    QList<std::pair<quint32, QString>> IDs;
+    IDs.reserve(keys.size());
+    foreach(auto key, keys) {
+        quint32 ID = 0;
+        if (parseID(key, ID)) {
+            IDs.append({ID, key});
         }
-        if (getKey(dataFile, endIndex) == key) {
-            auto value = getVal(dataFile, endIndex);
-            return value;
+    }
+    std::sort(IDs.begin(), IDs.end());
+
+    auto it = database->index.cbegin();
+    foreach(const auto& ID, IDs) {
+        it = std::lower_bound(it, database->index.cend(), static_cast<quint64>(ID.first) << 32);
+        if ((it == database->index.cend()) || ((*it >> 32) != ID.first)) {
+            result.unknownIDs.append(ID.first);
+            continue;
         }
-        qint64 const midIndex = (startIndex + endIndex) / 2;
-        if (midIndex == startIndex) {
-            return {};
+        result.registrations.insert(ID.second, database->value(*it));
+    }
+    return result;
+}
+
+
+void Traffic::FlarmnetDB::onBatchFinished()
+{
+    auto result = m_batchWatcher.result();
+    m_keysInFlight.clear();
+
+    // Discard results if the database has changed in the meantime
+    if (result.database == m_database) {
+        QStringList resolvedKeys;
+        for(auto it = result.registrations.cbegin(); it != result.registrations.cend(); it++) {
+            m_cache.insert(it.key(), new QString(it.value()));
+            resolvedKeys << it.key();
+        }
+        foreach(auto ID, result.unknownIDs) {
+            storeInCache({}, ID, std::nullopt);
+        }
+        if (!resolvedKeys.isEmpty()) {
+            emit registrationsChanged(resolvedKeys);
+        }
+    }
+
+    if (!m_queuedKeys.isEmpty()) {
+        startBatch();
+    }
+}
+
+
+void Traffic::FlarmnetDB::openFile()
+{
+    closeFile();
+    if (flarmnetDBDownloadable == nullptr) {
+        return;
+    }
+
+    auto database = std::make_shared<Database>();
+    database->file.setFileName(flarmnetDBDownloadable->fileName());
+    if (!database->file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    // Map the file into memory. If that is not possible, read it.
+    database->dataSize = database->file.size();
+    database->data = reinterpret_cast<const char*>(database->file.map(0, database->dataSize));
+    if (database->data == nullptr) {
+        database->fileContent = database->file.readAll();
+        database->file.close();
+        database->data = database->fileContent.constData();
+        database->dataSize = database->fileContent.size();
+    }
+
+    // Offsets are stored in 32 bits
+    if (database->dataSize > std::numeric_limits<quint32>::max()) {
+        return;
+    }
+
+    // Skip header line
+    auto const header = QByteArray::fromRawData(database->data, database->dataSize);
+    auto const firstEntry = header.indexOf('\n') + 1;
+    if (firstEntry == 0) {
+        return;
+    }
+
+    // Build index
+    auto const numEntries = (database->dataSize - firstEntry) / lineSize;
+    database->index.reserve(numEntries);
+    for(qint64 entry = 0; entry < numEntries; entry++) {
+        auto const offset = firstEntry + entry*lineSize;
+        quint32 ID = 0;
+        if (!parseID(database->data + offset, keySize, ID)) {
+            continue;
         }
-        if (getKey(dataFile, midIndex) > key) {
-            endIndex = midIndex;
+        database->index.push_back((static_cast<quint64>(ID) << 32) | static_cast<quint64>(offset));
+    }
+    std::sort(database->index.begin(), database->index.end());
+    m_database = database;
+}
+
+
+bool Traffic::FlarmnetDB::parseID(const char* data, qsizetype size, quint32& ID)
+{
+    if (size != keySize) {
+        return false;
+    }
+    ID = 0;
+    for(qsizetype i = 0; i < size; i++) {
+        auto const character = data[i];
+        quint32 digit = 0;
+        if ((character >= '0') && (character <= '9')) {
+            digit = character - '0';
+        } else if ((character >= 'a') && (character <= 'f')) {
+            digit = character - 'a' + 10;
+        } else if ((character >= 'A') && (character <= 'F')) {
+            digit = character - 'A' + 10;
         } else {
-            startIndex = midIndex;
+            return false;
         }
-    }while(startIndex != endIndex);
+        ID = (ID << 4) | digit;
+    }
+    return true;
+}
 
-    return {};
+
+bool Traffic::FlarmnetDB::parseID(const QString& key, quint32& ID)
+{
+    auto const keyLatin1 = key.toLatin1();
+    return parseID(keyLatin1.constData(), keyLatin1.size(), ID);
+}
+
+
+void Traffic::FlarmnetDB::requestRegistrations(const QStringList& keys)
+{
+    foreach(auto key, keys) {
+        quint32 ID = 0;
+        if (!parseID(key, ID) || m_unknownIDs.contains(ID) || m_cache.contains(key) || m_keysInFlight.contains(key)) {
+            continue;
+        }
+        m_queuedKeys.insert(key);
+    }
+    startBatch();
+}
+
+
+void Traffic::FlarmnetDB::setCacheCapacity(qsizetype capacity)
+{
+    m_cache.setMaxCost(capacity);
+}
+
+
+void Traffic::FlarmnetDB::startBatch()
+{
+    m_batchTimer.stop();
+    if (m_queuedKeys.isEmpty() || m_batchWatcher.isRunning()) {
+        return;
+    }
+    if (m_database == nullptr) {
+        m_queuedKeys.clear();
+        return;
+    }
+
+    m_keysInFlight = m_queuedKeys;
+    m_queuedKeys.clear();
+    m_batchWatcher.setFuture(QtConcurrent::run(&Traffic::FlarmnetDB::lookupBatch, m_database, m_keysInFlight.values()));
+}
+
+
+void Traffic::FlarmnetDB::storeInCache(const QString& key, quint32 ID, const std::optional<QString>& registration)
+{
+    if (registration.has_value()) {
+        m_cache.insert(key, new QString(*registration));
+        return;
+    }
+    if (m_unknownIDs.size() >= maxUnknownIDs) {
+        m_unknownIDs.clear();
+    }
+    m_unknownIDs.insert(ID);
+}
+
+
+auto Traffic::FlarmnetDB::Database::registration(quint32 ID) const -> std::optional<QString>
+{
+    auto const it = std::lower_bound(index.cbegin(), index.cend(), static_cast<quint64>(ID) << 32);
+    if ((it == index.cend()) || ((*it >> 32) != ID)) {
+        return std::nullopt;
+    }
+    return value(*it);
+}
+
+
+auto Traffic::FlarmnetDB::Database::value(quint64 entry) const -> QString
+{
+    auto const offset = static_cast<qint64>(entry & 0xFFFFFFFFU) + valueOffset;
+    auto const size = qMin(valueSize, dataSize - offset);
+    auto bytes = QByteArray::fromRawData(data + offset, size);
+    auto const endOfLine = bytes.indexOf('\n');
+    if (endOfLine >= 0) {
+        bytes.truncate(endOfLine);
+    }
+    return QString::fromLatin1(bytes).simplified();
 }
@@ -21,7 +21,14 @@
 #pragma once
 
 #include <QCache>
+#include <QFile>
+#include <QFutureWatcher>
 #include <QObject>
+#include <QSet>
+#include <QTimer>
+#include <memory>
+#include <optional>
+#include <vector>
 
 #include "dataManagement/Downloadable_SingleFile.h"
 
@@ -33,6 +40,19 @@ namespace Traffic {
  *  This simple class provides access to a Flarmnet database, which is in
  *  essence a glorified QHash<QString, QString>, where keys are Flarm IDs and
  *  values are aircraft registration strings.
+ *
+ *  The database file is mapped into memory. Whenever the file changes, the
+ *  class builds a sorted index of the 24-bit Flarm IDs, so that lookups are
+ *  binary searches in memory that do not touch the file system. IDs that are
+ *  not contained in the database are remembered, so that they are not searched
+ *  again.
+ *
+ *  Besides the synchronous method getRegistration(), the class offers the
+ *  non-blocking methods getCachedRegistration() and requestRegistrations().
+ *  Keys that are not in the cache are collected and resolved in batches on a
+ *  worker thread. Results are stored in the cache, and registrationsChanged()
+ *  is emitted once a batch is resolved. The capacity of the cache can be
+ *  tuned with setCacheCapacity().
  */
 class FlarmnetDB : public QObject {
     Q_OBJECT
@@ -46,12 +66,30 @@ public:
      */
     FlarmnetDB(QObject* parent=nullptr);
 
-    ~FlarmnetDB() override = default;
+    ~FlarmnetDB() override;
 
     //
     // Methods
     //
 
+    /*! \brief Maximal number of registrations in the cache
+     *
+     *  @returns Capacity of the cache
+     */
+    [[nodiscard]] qsizetype cacheCapacity() const { return m_cache.maxCost(); }
+
+    /*! \brief Find registration for a given key, without blocking
+     *
+     *  If the registration is in the cache, it is returned. Otherwise, the key
+     *  is queued for the next batch lookup and an empty string is returned.
+     *
+     *  @param key FlarmID to look up
+     *
+     *  @returns Aircraft registration, or an empty string if the registration
+     *  is not known yet or if the database does not contain the key
+     */
+    Q_INVOKABLE QString getCachedRegistration(const QString& key);
+
     /*! \brief Find password for a given key
      *
      *  @param key FlarmID to look up
@@ -61,24 +99,126 @@ public:
      */
     Q_INVOKABLE QString getRegistration(const QString& key);
 
+    /*! \brief Look up registrations asynchronously
+     *
+     *  The keys that are not yet in the cache are resolved in one pass on a
+     *  worker thread. Once done, the results are stored in the cache and
+     *  registrationsChanged() is emitted.
+     *
+     *  @param keys FlarmIDs to look up
+     */
+    Q_INVOKABLE void requestRegistrations(const QStringList& keys);
+
+    /*! \brief Set maximal number of registrations in the cache
+     *
+     *  @param capacity New capacity of the cache
+     */
+    void setCacheCapacity(qsizetype capacity);
+
+
+    //
+    // Constants
+    //
+
+    /*! \brief Default capacity of the cache
+     *
+     *  This is large enough to hold the registrations of all traffic seen near
+     *  a busy airfield.
+     */
+    static constexpr qsizetype defaultCacheCapacity = 2000;
+
+signals:
+    /*! \brief Notifier signal
+     *
+     *  This signal is emitted whenever a batch lookup has been resolved and
+     *  new registrations are available from the cache.
+     *
+     *  @param keys FlarmIDs that have been resolved
+     */
+    void registrationsChanged(const QStringList& keys);
+
 private slots:
-    // The title says everything
+    // Clears the caches and rebuilds the index from the database file
     void clearCache();
 
+    // Unmaps the database file and clears the index. Called before the file
+    // is changed.
+    void closeFile();
+
     // The title says everything
     void deferredInitialization();
 
     // The title says everything
     void findFlarmnetDBDownloadable();
 
+    // Stores the results of a batch lookup in the cache and starts the next
+    // batch, if keys are queued
+    void onBatchFinished();
+
+    // Starts a batch lookup for the queued keys, unless one is running
+    void startBatch();
+
 private:
     Q_DISABLE_COPY_MOVE(FlarmnetDB)
 
-    auto getRegistrationFromFile(const QString& key) -> QString;
+    // Database file, mapped into memory, and its sorted index. Each entry of
+    // the index holds a Flarm ID in the upper 32 bits and the offset of the
+    // database entry in data in the lower 32 bits. If the file cannot be
+    // mapped, its content is read into fileContent instead. Batch lookups hold
+    // a shared pointer, so that the file stays mapped while they are running.
+    struct Database
+    {
+        QFile file;
+        const char* data {nullptr};
+        qint64 dataSize {0};
+        QByteArray fileContent;
+        std::vector<quint64> index;
+
+        // Returns the registration, or std::nullopt if the database does not
+        // contain the ID. Thread-safe.
+        [[nodiscard]] std::optional<QString> registration(quint32 ID) const;
+
+        // Reads the registration for an entry of the index. Thread-safe.
+        [[nodiscard]] QString value(quint64 entry) const;
+    };
+
+    // Result of a batch lookup
+    struct BatchResult
+    {
+        std::shared_ptr<const Database> database;
+        QHash<QString, QString> registrations;
+        QList<quint32> unknownIDs;
+    };
+
+    // Resolves keys in one pass over the database. Runs on a worker thread.
+    static BatchResult lookupBatch(const std::shared_ptr<const Database>& database, const QStringList& keys);
+
+    // Stores a result of a lookup in the caches
+    void storeInCache(const QString& key, quint32 ID, const std::optional<QString>& registration);
+
+    // Maps the database file into memory and builds the index
+    void openFile();
+
+    // Parses a Flarm ID, given as six hex digits. Returns false if the string
+    // is not a valid Flarm ID.
+    static bool parseID(const char* data, qsizetype size, quint32& ID);
+    static bool parseID(const QString& key, quint32& ID);
 
     QPointer<DataManagement::Downloadable_SingleFile> flarmnetDBDownloadable;
 
     QCache<QString, QString> m_cache;
+
+    // Flarm IDs that are known not to be contained in the database
+    QSet<quint32> m_unknownIDs;
+
+    std::shared_ptr<const Database> m_database;
+
+    // Batch lookups. Keys are queued in m_queuedKeys and resolved by the next
+    // batch. m_batchTimer coalesces requests that arrive in quick succession.
+    QSet<QString> m_queuedKeys;
+    QSet<QString> m_keysInFlight;
+    QTimer m_batchTimer;
+    QFutureWatcher<BatchResult> m_batchWatcher;
 };
 
 } // namespace Traffic
@@ -0,0 +1,412 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include <QDateTime>
+#include <QNetworkInterface>
+#include <atomic>
+#include <cmath>
+
+#include "positioning/Geoid.h"
+#include "traffic/GDL90Broadcaster.h"
+#include "traffic/TrafficDataSource_Abstract.h"
+#include "traffic/TrafficFusion.h"
+
+
+namespace {
+
+// Local port of the socket used by the enabled broadcaster, or 0
+std::atomic<quint16> ownLocalPort {0};
+
+// Rounds and clamps a value
+qint32 clamped(double value, qint32 min, qint32 max)
+{
+    if (!std::isfinite(value))
+    {
+        return min;
+    }
+    return static_cast<qint32>(qBound(static_cast<double>(min), std::round(value), static_cast<double>(max)));
+}
+
+// Navigation Accuracy Category for Position, as used in GDL90 reports
+quint8 NACp(Units::Distance positionErrorEstimate)
+{
+    if (!positionErrorEstimate.isFinite())
+    {
+        return 0;
+    }
+    auto const errorInM = positionErrorEstimate.toM();
+    if (errorInM < 3.0)
+    {
+        return 11;
+    }
+    if (errorInM < 10.0)
+    {
+        return 10;
+    }
+    if (errorInM < 30.0)
+    {
+        return 9;
+    }
+    constexpr std::array<double, 8> limitsInNM = {0.05, 0.1, 0.3, 0.5, 1.0, 2.0, 4.0, 10.0};
+    for(qsizetype i=0; i<static_cast<qsizetype>(limitsInNM.size()); i++)
+    {
+        if (positionErrorEstimate.toNM() < limitsInNM[i])
+        {
+            return static_cast<quint8>(8-i);
+        }
+    }
+    return 0;
+}
+
+// Emitter category, as used in GDL90 traffic reports
+quint8 emitterCategory(Traffic::TrafficFactor_Abstract::AircraftType type)
+{
+    switch(type)
+    {
+    case Traffic::TrafficFactor_Abstract::Aircraft:
+    case Traffic::TrafficFactor_Abstract::TowPlane:
+        return 1;
+    case Traffic::TrafficFactor_Abstract::Jet:
+        return 6;
+    case Traffic::TrafficFactor_Abstract::Copter:
+        return 7;
+    case Traffic::TrafficFactor_Abstract::Glider:
+        return 9;
+    case Traffic::TrafficFactor_Abstract::Airship:
+    case Traffic::TrafficFactor_Abstract::Balloon:
+        return 10;
+    case Traffic::TrafficFactor_Abstract::Skydiver:
+        return 11;
+    case Traffic::TrafficFactor_Abstract::HangGlider:
+    case Traffic::TrafficFactor_Abstract::Paraglider:
+        return 12;
+    case Traffic::TrafficFactor_Abstract::Drone:
+        return 14;
+    case Traffic::TrafficFactor_Abstract::StaticObstacle:
+        return 19;
+    default:
+        return 0;
+    }
+}
+
+} // namespace
+
+
+Traffic::GDL90Broadcaster::GDL90Broadcaster(QObject* parent)
+    : QObject(parent)
+{
+    m_heartbeatTimer.setInterval(minIntervalInMS[Heartbeat]);
+    connect(&m_heartbeatTimer, &QTimer::timeout, this, &Traffic::GDL90Broadcaster::sendHeartbeat);
+}
+
+
+//
+// Methods
+//
+
+bool Traffic::GDL90Broadcaster::acquire(MessageType type)
+{
+    if (!m_enabled)
+    {
+        return false;
+    }
+    auto const now = QDateTime::currentMSecsSinceEpoch();
+    if (now - m_lastSentInMS[type] < minIntervalInMS[type])
+    {
+        return false;
+    }
+    m_lastSentInMS[type] = now;
+    return true;
+}
+
+
+void Traffic::GDL90Broadcaster::appendFrame(qsizetype size)
+{
+    if (m_datagramSize + maxFrameSize > datagramCapacity)
+    {
+        flush();
+    }
+
+    // Checksum, as in TrafficDataSource_Abstract::decodeGDLMessage
+    quint16 crc = 0;
+    for(qsizetype i=0; i<size; i++)
+    {
+        crc = Crc16Table.at(crc >> 8U) ^ (crc << 8U) ^ m_message[i];
+    }
+
+    auto append = [this](quint8 byte)
+    {
+        if ((byte == 0x7d) || (byte == 0x7e))
+        {
+            m_datagram[m_datagramSize++] = 0x7d;
+            byte ^= 0x20;
+        }
+        m_datagram[m_datagramSize++] = static_cast<char>(byte);
+    };
+
+    m_datagram[m_datagramSize++] = 0x7e;
+    for(qsizetype i=0; i<size; i++)
+    {
+        append(m_message[i]);
+    }
+    append(crc & 0xFFU);
+    append(crc >> 8U);
+    m_datagram[m_datagramSize++] = 0x7e;
+}
+
+
+void Traffic::GDL90Broadcaster::encodeReport(quint8 messageID,
+                                             const Positioning::PositionInfo& positionInfo,
+                                             Units::Distance pressureAltitude,
+                                             const QString& ID,
+                                             int alarmLevel,
+                                             Traffic::TrafficFactor_Abstract::AircraftType type,
+                                             const QString& callSign)
+{
+    // Address. IDs reported via GDL90 consist of the address type and the
+    // 24-bit address. Other IDs that are not 24-bit addresses are hashed and
+    // reported as self-assigned addresses. The own aircraft has no ID.
+    quint8 addressType = 0;
+    quint32 address = 0;
+    if (!ID.isEmpty())
+    {
+        bool ok = false;
+        address = TrafficFusion::normalizedID(ID).toUInt(&ok, 16);
+        if (ok && (ID.length() == 7))
+        {
+            addressType = static_cast<quint8>(ID.left(1).toUInt(nullptr, 16));
+        }
+        if (!ok || (address > 0xFFFFFFU))
+        {
+            address = static_cast<quint32>(qHash(ID)) & 0xFFFFFFU;
+            addressType = 1;
+        }
+    }
+
+    auto const coordinate = positionInfo.coordinate();
+    auto const latitude = clamped(coordinate.latitude()*0x800000/180.0, -0x800000, 0x7FFFFF);
+    auto const longitude = clamped(coordinate.longitude()*0x800000/180.0, -0x800000, 0x7FFFFF);
+
+    auto altitude = 0xFFF;
+    if (pressureAltitude.isFinite())
+    {
+        altitude = clamped((pressureAltitude.toFeet()+1000.0)/25.0, 0, 0xFFE);
+    }
+
+    auto horizontalVelocity = 0xFFF;
+    auto const groundSpeed = positionInfo.groundSpeed();
+    if (groundSpeed.isFinite())
+    {
+        horizontalVelocity = clamped(groundSpeed.toKN(), 0, 0xFFE);
+    }
+
+    auto verticalVelocity = 0x800;
+    auto const verticalSpeed = positionInfo.verticalSpeed();
+    if (verticalSpeed.isFinite())
+    {
+        verticalVelocity = clamped(verticalSpeed.toFPM()/64.0, -510, 510) & 0xFFF;
+    }
+
+    quint8 misc = 0;
+    quint8 track = 0;
+    auto const trueTrack = positionInfo.trueTrack();
+    if (trueTrack.isFinite())
+    {
+        misc |= 0x01U;
+        track = static_cast<quint8>(clamped(trueTrack.toDEG()*256.0/360.0, -0x10000, 0x10000) & 0xFF);
+    }
+    if (!groundSpeed.isFinite() || (groundSpeed.toKN() >= 30.0))
+    {
+        misc |= 0x08U;
+    }
+
+    // The Navigation Integrity Category is approximated by the accuracy
+    // category
+    auto const accuracy = NACp(positionInfo.positionErrorEstimate());
+
+    m_message[0] = messageID;
+    m_message[1] = static_cast<quint8>(((alarmLevel > 0) ? 0x10U : 0x00U) | (addressType & 0x0FU));
+    m_message[2] = static_cast<quint8>(address >> 16);
+    m_message[3] = static_cast<quint8>(address >> 8);
+    m_message[4] = static_cast<quint8>(address);
+    m_message[5] = static_cast<quint8>(latitude >> 16);
+    m_message[6] = static_cast<quint8>(latitude >> 8);
+    m_message[7] = static_cast<quint8>(latitude);
+    m_message[8] = static_cast<quint8>(longitude >> 16);
+    m_message[9] = static_cast<quint8>(longitude >> 8);
+    m_message[10] = static_cast<quint8>(longitude);
+    m_message[11] = static_cast<quint8>(altitude >> 4);
+    m_message[12] = static_cast<quint8>(((altitude & 0x0F) << 4) | misc);
+    m_message[13] = static_cast<quint8>((accuracy << 4) | accuracy);
+    m_message[14] = static_cast<quint8>(horizontalVelocity >> 4);
+    m_message[15] = static_cast<quint8>(((horizontalVelocity & 0x0F) << 4) | (verticalVelocity >> 8));
+    m_message[16] = static_cast<quint8>(verticalVelocity);
+    m_message[17] = track;
+    m_message[18] = emitterCategory(type);
+    for(qsizetype i=0; i<8; i++)
+    {
+        auto character = (i < callSign.length()) ? callSign.at(i).toUpper().toLatin1() : ' ';
+        if (((character < '0') || (character > '9')) && ((character < 'A') || (character > 'Z')))
+        {
+            character = ' ';
+        }
+        m_message[19+i] = static_cast<quint8>(character);
+    }
+    m_message[27] = 0;
+}
+
+
+void Traffic::GDL90Broadcaster::flush()
+{
+    if (m_datagramSize == 0)
+    {
+        return;
+    }
+    sendDatagram(QByteArrayView(m_datagram.data(), m_datagramSize));
+    m_datagramSize = 0;
+}
+
+
+bool Traffic::GDL90Broadcaster::isOwnDatagram(const QNetworkDatagram& datagram)
+{
+    auto const localPort = ownLocalPort.load();
+    if ((localPort == 0) || (datagram.senderPort() != localPort))
+    {
+        return false;
+    }
+    // Checking the sender address is expensive, but happens only for
+    // datagrams from the right port.
+    return QNetworkInterface::allAddresses().contains(datagram.senderAddress());
+}
+
+
+void Traffic::GDL90Broadcaster::sendDatagram(QByteArrayView datagram)
+{
+    m_socket.writeDatagram(datagram.data(), datagram.size(), QHostAddress::Broadcast, port);
+}
+
+
+void Traffic::GDL90Broadcaster::sendHeartbeat()
+{
+    if (!acquire(Heartbeat))
+    {
+        return;
+    }
+
+    auto const now = QDateTime::currentDateTimeUtc();
+    auto const positionValid = now.toMSecsSinceEpoch() - m_lastOwnshipInMS < 3*minIntervalInMS[Heartbeat];
+    auto const secondsSinceMidnight = now.time().msecsSinceStartOfDay()/1000;
+
+    m_message[0] = 0;
+    m_message[1] = positionValid ? 0x81U : 0x01U;
+    m_message[2] = static_cast<quint8>(((secondsSinceMidnight & 0x10000) != 0 ? 0x80U : 0x00U) | (positionValid ? 0x01U : 0x00U));
+    m_message[3] = static_cast<quint8>(secondsSinceMidnight);
+    m_message[4] = static_cast<quint8>(secondsSinceMidnight >> 8);
+    m_message[5] = 0;
+    m_message[6] = 0;
+    appendFrame(7);
+    flush();
+}
+
+
+void Traffic::GDL90Broadcaster::sendOwnship(const Positioning::PositionInfo& positionInfo, Units::Distance pressureAltitude)
+{
+    if (!positionInfo.isValid() || !acquire(Ownship))
+    {
+        return;
+    }
+    m_lastOwnshipInMS = m_lastSentInMS[Ownship];
+
+    encodeReport(10, positionInfo, pressureAltitude, {}, 0, TrafficFactor_Abstract::unknown, {});
+    appendFrame(maxMessageSize);
+
+    // Geometric altitude is the height above the WGS-84 ellipsoid
+    auto altitude = positionInfo.trueAltitudeAMSL();
+    auto const geoidSeparation = Positioning::Geoid::separation(positionInfo.coordinate());
+    if (altitude.isFinite() && geoidSeparation.isFinite() && acquire(OwnshipGeometricAltitude))
+    {
+        altitude = altitude + geoidSeparation;
+        auto const altitudeIn5FT = clamped(altitude.toFeet()/5.0, -0x8000, 0x7FFF);
+        auto verticalFigureOfMerit = 0x7FFF;
+        auto const errorEstimate = positionInfo.trueAltitudeErrorEstimate();
+        if (errorEstimate.isFinite())
+        {
+            verticalFigureOfMerit = clamped(errorEstimate.toM(), 0, 0x7FFE);
+        }
+        m_message[0] = 11;
+        m_message[1] = static_cast<quint8>(altitudeIn5FT >> 8);
+        m_message[2] = static_cast<quint8>(altitudeIn5FT);
+        m_message[3] = static_cast<quint8>(verticalFigureOfMerit >> 8);
+        m_message[4] = static_cast<quint8>(verticalFigureOfMerit);
+        appendFrame(5);
+    }
+    flush();
+}
+
+
+void Traffic::GDL90Broadcaster::sendTraffic(const QList<Traffic::TrafficFactor_WithPosition*>& traffic, Units::Distance pressureAltitude)
+{
+    if (!acquire(TrafficReport))
+    {
+        return;
+    }
+
+    foreach(auto* factor, traffic)
+    {
+        if ((factor == nullptr) || !factor->valid())
+        {
+            continue;
+        }
+        Units::Distance trafficPressureAltitude {};
+        if (pressureAltitude.isFinite() && factor->vDist().isFinite())
+        {
+            trafficPressureAltitude = pressureAltitude + factor->vDist();
+        }
+        encodeReport(20, factor->positionInfo(), trafficPressureAltitude, factor->ID(), factor->alarmLevel(), factor->type(), factor->callSign());
+        appendFrame(maxMessageSize);
+    }
+    flush();
+}
+
+
+void Traffic::GDL90Broadcaster::setEnabled(bool enabled)
+{
+    if (enabled == m_enabled)
+    {
+        return;
+    }
+    m_enabled = enabled;
+
+    if (m_enabled)
+    {
+        m_socket.bind(QHostAddress::AnyIPv4, 0);
+        ownLocalPort = m_socket.localPort();
+        m_heartbeatTimer.start();
+    }
+    else
+    {
+        m_heartbeatTimer.stop();
+        ownLocalPort = 0;
+        m_socket.close();
+        m_datagramSize = 0;
+        m_lastSentInMS = {};
+    }
+}
@@ -0,0 +1,201 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <QByteArrayView>
+#include <QNetworkDatagram>
+#include <QTimer>
+#include <QUdpSocket>
+#include <array>
+
+#include "positioning/PositionInfo.h"
+#include "traffic/TrafficFactor_WithPosition.h"
+
+
+namespace Traffic {
+
+/*! \brief Re-broadcast of ownship and traffic data in GDL90 format
+ *
+ *  This class encodes the position of the own aircraft and the traffic
+ *  picture as GDL90 messages and broadcasts them via UDP to port 4000, so that
+ *  other EFB apps on the cockpit network can display the traffic that this
+ *  app receives.  The following messages are sent.
+ *
+ *  - Heartbeat (ID 0), once per second
+ *  - Ownship Report (ID 10) and Ownship Geometric Altitude (ID 11)
+ *  - Traffic Report (ID 20), one for every traffic
+ *
+ *  Every message type is rate-limited, see minIntervalInMS.  Messages are
+ *  encoded into buffers of fixed size that are allocated with the object, so
+ *  that sending does not allocate memory.
+ *
+ *  The broadcast datagrams are also received by the UDP traffic data sources
+ *  of this app. These sources use isOwnDatagram() to ignore them.
+ */
+
+class GDL90Broadcaster : public QObject
+{
+    Q_OBJECT
+
+public:
+    /*! \brief Standard constructor
+     *
+     *  The broadcaster is initially disabled.
+     *
+     *  @param parent The standard QObject parent pointer
+     */
+    explicit GDL90Broadcaster(QObject* parent = nullptr);
+
+    // Standard destructor
+    ~GDL90Broadcaster() override = default;
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Check if a datagram has been sent by this class
+     *
+     *  This method is thread-safe.
+     *
+     *  @param datagram Datagram received by a UDP socket
+     *
+     *  @returns True if the datagram was sent by a GDL90Broadcaster of this
+     *  process
+     */
+    [[nodiscard]] static bool isOwnDatagram(const QNetworkDatagram& datagram);
+
+    /*! \brief Enable or disable broadcasting
+     *
+     *  If disabled, all methods that send data do nothing.
+     *
+     *  @param enabled New state
+     */
+    void setEnabled(bool enabled);
+
+    /*! \brief Broadcast position of own aircraft
+     *
+     *  Sends an Ownship Report and, if the true altitude is known, an Ownship
+     *  Geometric Altitude message.  Calls that come in too quickly are ignored.
+     *
+     *  @param positionInfo Position of own aircraft
+     *
+     *  @param pressureAltitude Pressure altitude of own aircraft, might be NaN
+     */
+    void sendOwnship(const Positioning::PositionInfo& positionInfo, Units::Distance pressureAltitude);
+
+    /*! \brief Broadcast traffic
+     *
+     *  Sends one Traffic Report for every valid traffic.  Calls that come in
+     *  too quickly are ignored.
+     *
+     *  @param traffic List of traffic
+     *
+     *  @param pressureAltitude Pressure altitude of own aircraft.  The vertical
+     *  distances of the traffic are relative to this altitude.
+     */
+    void sendTraffic(const QList<Traffic::TrafficFactor_WithPosition*>& traffic, Units::Distance pressureAltitude);
+
+
+    //
+    // Constants
+    //
+
+    /*! \brief UDP port to which messages are sent */
+    static constexpr quint16 port = 4000;
+
+    /*! \brief Message types, for rate limiting */
+    enum MessageType
+    {
+        Heartbeat,
+        Ownship,
+        OwnshipGeometricAltitude,
+        TrafficReport,
+        MessageTypeCount
+    };
+
+    /*! \brief Minimal time between two messages of the same type
+     *
+     *  For traffic reports, this is the minimal time between two updates of
+     *  the traffic picture.
+     */
+    static constexpr std::array<qint64, MessageTypeCount> minIntervalInMS = {1000, 200, 1000, 1000};
+
+protected:
+    /*! \brief Send datagram
+     *
+     *  Broadcasts a datagram that holds one or more GDL90 frames to port.
+     *  Unit tests override this method in order to decode the frames.
+     *
+     *  @param datagram Datagram
+     */
+    virtual void sendDatagram(QByteArrayView datagram);
+
+private slots:
+    // Sends a heartbeat message
+    void sendHeartbeat();
+
+private:
+    Q_DISABLE_COPY_MOVE(GDL90Broadcaster)
+
+    // Returns true if a message of the given type may be sent now, and
+    // records the time
+    bool acquire(MessageType type);
+
+    // Writes an Ownship or Traffic Report to m_message
+    void encodeReport(quint8 messageID,
+                      const Positioning::PositionInfo& positionInfo,
+                      Units::Distance pressureAltitude,
+                      const QString& ID,
+                      int alarmLevel,
+                      Traffic::TrafficFactor_Abstract::AircraftType type,
+                      const QString& callSign);
+
+    // Adds the first size bytes of m_message to m_datagram, with checksum,
+    // flag bytes and escaping. If m_datagram is full, it is sent first.
+    void appendFrame(qsizetype size);
+
+    // Sends m_datagram
+    void flush();
+
+    // Sizes of the buffers. A report is 28 bytes long. A frame needs at most
+    // two flag bytes and twice the size of message and checksum.
+    static constexpr qsizetype maxMessageSize = 28;
+    static constexpr qsizetype maxFrameSize = 2 + 2*(maxMessageSize + 2);
+    static constexpr qsizetype datagramCapacity = 2048;
+
+    std::array<quint8, maxMessageSize> m_message {};
+    std::array<char, datagramCapacity> m_datagram {};
+    qsizetype m_datagramSize {0};
+
+    // Time at which the last message of each type was sent
+    std::array<qint64, MessageTypeCount> m_lastSentInMS {};
+
+    // Time at which a valid ownship position was last sent
+    qint64 m_lastOwnshipInMS {0};
+
+    bool m_enabled {false};
+    QTimer m_heartbeatTimer;
+    QUdpSocket m_socket;
+};
+
+} // namespace Traffic
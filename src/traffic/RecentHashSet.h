@@ -0,0 +1,175 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace Traffic {
+
+/*! \brief Set of the most recently inserted hash values
+ *
+ *  This class remembers the last Window hash values that have been inserted.
+ *  It is used to sort out datagrams that traffic data receivers send more than
+ *  once.  The values are kept in an open-addressing hash table with linear
+ *  probing, so that lookup and insertion take constant time.  A ring buffer
+ *  records the order of insertion. Once the window is full, every insertion
+ *  expires the oldest value.  No memory is allocated after construction.
+ *
+ *  @tparam Window Number of values that are remembered. Must be a power of
+ *  two.
+ */
+template<std::size_t Window>
+class RecentHashSet
+{
+    static_assert((Window >= 1) && ((Window & (Window-1)) == 0), "Window must be a power of two");
+
+public:
+    /*! \brief Insert a value
+     *
+     *  If the value is not contained in the set, it is inserted, and the oldest
+     *  value is expired if the window is full.
+     *
+     *  @param hash Value
+     *
+     *  @returns True if the value has been inserted, false if it was already
+     *  contained in the set.
+     */
+    bool insert(std::size_t hash)
+    {
+        if (find(hash) != notFound)
+        {
+            return false;
+        }
+
+        // Expire oldest value
+        if (m_fifoCount == Window)
+        {
+            erase(find(m_fifo[m_fifoNext]));
+            m_fifoCount--;
+        }
+        m_fifo[m_fifoNext] = hash;
+        m_fifoNext = (m_fifoNext + 1) & (Window - 1);
+        m_fifoCount++;
+
+        // Insert into table
+        auto slot = home(hash);
+        while (m_used[slot])
+        {
+            slot = (slot + 1) & tableMask;
+        }
+        m_slots[slot] = hash;
+        m_used[slot] = true;
+        return true;
+    }
+
+    /*! \brief Check if a value is contained in the set
+     *
+     *  @param hash Value
+     *
+     *  @returns True if the value is contained in the set
+     */
+    [[nodiscard]] bool contains(std::size_t hash) const
+    {
+        return find(hash) != notFound;
+    }
+
+private:
+    // The table has twice as many slots as the window, so the load factor never
+    // exceeds 1/2 and probe sequences stay short.
+    static constexpr std::size_t tableSize = 2*Window;
+    static constexpr std::size_t tableMask = tableSize - 1;
+    static constexpr std::size_t notFound = tableSize;
+
+    static constexpr int tableBits = std::countr_zero(tableSize);
+
+    // Home slot of a hash value (Fibonacci hashing). The low bits of a product
+    // depend only on the low bits of its factors, so the home slot is taken
+    // from the high bits of the product, which depend on all bits of the hash
+    // value. The product is computed in 64 bits, also on 32-bit platforms.
+    static std::size_t home(std::size_t hash)
+    {
+        return static_cast<std::size_t>((static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ULL) >> (64 - tableBits));
+    }
+
+    // Returns the slot containing hash, or notFound
+    [[nodiscard]] std::size_t find(std::size_t hash) const
+    {
+        auto slot = home(hash);
+        while (m_used[slot])
+        {
+            if (m_slots[slot] == hash)
+            {
+                return slot;
+            }
+            slot = (slot + 1) & tableMask;
+        }
+        return notFound;
+    }
+
+    // Removes the value in the given slot. Subsequent entries of the probe
+    // sequence are shifted back, so that no tombstones are needed.
+    void erase(std::size_t slot)
+    {
+        if (slot == notFound)
+        {
+            return;
+        }
+        m_used[slot] = false;
+        auto next = slot;
+        while (true)
+        {
+            next = (next + 1) & tableMask;
+            if (!m_used[next])
+            {
+                return;
+            }
+
+            // The entry at next can stay if its home slot lies cyclically in
+            // (slot, next]
+            auto const homeSlot = home(m_slots[next]);
+            auto const stays = (slot <= next) ? ((slot < homeSlot) && (homeSlot <= next))
+                                              : ((slot < homeSlot) || (homeSlot <= next));
+            if (stays)
+            {
+                continue;
+            }
+            m_slots[slot] = m_slots[next];
+            m_used[slot] = true;
+            m_used[next] = false;
+            slot = next;
+        }
+    }
+
+    std::array<std::size_t, tableSize> m_slots {};
+    std::array<bool, tableSize> m_used {};
+
+    // Values in order of insertion. m_fifoNext points to the oldest value once
+    // the window is full.
+    std::array<std::size_t, Window> m_fifo {};
+    std::size_t m_fifoNext {0};
+    std::size_t m_fifoCount {0};
+};
+
+} // namespace Traffic
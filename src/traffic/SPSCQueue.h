@@ -0,0 +1,118 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+
+namespace Traffic {
+
+/*! \brief Lock-free single-producer, single-consumer queue
+ *
+ *  This is a bounded ring buffer that can be used to hand items from exactly
+ *  one producer thread to exactly one consumer thread without locking.  The
+ *  method tryPush() must only be called from the producer thread, the method
+ *  tryPop() must only be called from the consumer thread.
+ *
+ *  One slot of the ring buffer is always kept empty, so that the queue holds
+ *  at most Capacity-1 items.
+ *
+ *  @tparam T Type of the items. Must be default-constructible and
+ *  move-assignable.
+ *
+ *  @tparam Capacity Size of the ring buffer. Must be a power of two.
+ */
+template<typename T, std::size_t Capacity>
+class SPSCQueue
+{
+    static_assert((Capacity >= 2) && ((Capacity & (Capacity-1)) == 0), "Capacity must be a power of two");
+
+public:
+    /*! \brief Append an item to the queue
+     *
+     *  This method must only be called from the producer thread.
+     *
+     *  @param item Item that will be moved into the queue
+     *
+     *  @returns True on success, false if the queue is full. In the latter
+     *  case, the item is not touched.
+     */
+    bool tryPush(T&& item)
+    {
+        auto const head = m_head.load(std::memory_order_relaxed);
+        auto const next = (head + 1) & (Capacity - 1);
+        if (next == m_tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        m_buffer[head] = std::move(item);
+        m_head.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /*! \brief Remove the oldest item from the queue
+     *
+     *  This method must only be called from the consumer thread.
+     *
+     *  @param item If the queue is not empty, the oldest item is moved here.
+     *
+     *  @returns True on success, false if the queue is empty.
+     */
+    bool tryPop(T& item)
+    {
+        auto const tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        item = std::move(m_buffer[tail]);
+        m_buffer[tail] = T();
+        m_tail.store((tail + 1) & (Capacity - 1), std::memory_order_release);
+        return true;
+    }
+
+    /*! \brief Check if the queue is empty
+     *
+     *  This method can be called from any thread. The result is a snapshot
+     *  that might be outdated by the time the method returns.
+     *
+     *  @returns True if the queue contains no items
+     */
+    [[nodiscard]] bool isEmpty() const
+    {
+        return m_tail.load(std::memory_order_acquire) == m_head.load(std::memory_order_acquire);
+    }
+
+private:
+    std::array<T, Capacity> m_buffer {};
+
+    // Index of the next slot to be written by the producer. Head and tail
+    // live on separate cache lines, in order to avoid false sharing between
+    // producer and consumer.
+    alignas(64) std::atomic<std::size_t> m_head {0};
+
+    // Index of the next slot to be read by the consumer
+    alignas(64) std::atomic<std::size_t> m_tail {0};
+};
+
+} // namespace Traffic
@@ -0,0 +1,195 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <QDateTime>
+#include <cmath>
+#include <limits>
+
+#include "traffic/TrackHistory.h"
+
+
+namespace {
+
+// Quantization
+constexpr double degreesToFixed = 1.0e7;
+constexpr double trackToFixed = 65536.0/360.0;
+
+// Rounds and clamps a value to the range of an integer type
+template<typename T>
+T quantize(double value)
+{
+    auto const rounded = std::round(value);
+    if (rounded <= static_cast<double>(std::numeric_limits<T>::min()))
+    {
+        return std::numeric_limits<T>::min();
+    }
+    if (rounded >= static_cast<double>(std::numeric_limits<T>::max()))
+    {
+        return std::numeric_limits<T>::max();
+    }
+    return static_cast<T>(rounded);
+}
+
+} // namespace
+
+
+Traffic::TrackHistory::TrackHistory()
+    : m_samples(maxTracks*samplesPerTrack)
+{
+}
+
+
+//
+// Methods
+//
+
+void Traffic::TrackHistory::append(const QString& ID, const Positioning::PositionInfo& positionInfo)
+{
+    auto const coordinate = positionInfo.coordinate();
+    if (!coordinate.isValid())
+    {
+        return;
+    }
+    auto const timestamp = positionInfo.timestamp();
+    auto const timestampInMS = timestamp.isValid() ? timestamp.toMSecsSinceEpoch() : QDateTime::currentMSecsSinceEpoch();
+
+    // Find slot. If the traffic is unknown, take the slot that has not been
+    // used for the longest time.
+    auto slot = find(ID);
+    if (slot < 0)
+    {
+        slot = 0;
+        for(qsizetype i=1; i<maxTracks; i++)
+        {
+            if (m_tracks[i].lastTimestampInMS < m_tracks[slot].lastTimestampInMS)
+            {
+                slot = i;
+            }
+        }
+        m_tracks[slot].ID = ID;
+        m_tracks[slot].count = 0;
+        m_tracks[slot].head = 0;
+        m_tracks[slot].lastTimestampInMS = 0;
+    }
+    auto& track = m_tracks[slot];
+
+    // Thin out samples
+    auto const deltaTInMS = timestampInMS - track.lastTimestampInMS;
+    if ((track.count > 0) && (deltaTInMS < minSampleIntervalInMS))
+    {
+        return;
+    }
+
+    // Quantize
+    Sample sample {};
+    sample.latitude = quantize<qint32>(coordinate.latitude()*degreesToFixed);
+    sample.longitude = quantize<qint32>(coordinate.longitude()*degreesToFixed);
+    if (std::isfinite(coordinate.altitude()))
+    {
+        sample.altitudeInM = quantize<qint16>(coordinate.altitude());
+        sample.flags |= hasAltitude;
+    }
+    auto const trueTrack = positionInfo.trueTrack();
+    if (trueTrack.isFinite())
+    {
+        sample.track = static_cast<quint16>(quantize<qint32>(trueTrack.toDEG()*trackToFixed) & 0xFFFF);
+        sample.flags |= hasTrack;
+    }
+    sample.deltaTInDeciS = (track.count > 0) ? quantize<quint16>(static_cast<double>(deltaTInMS)/100.0) : 0;
+
+    // Store
+    m_samples[slot*samplesPerTrack + track.head] = sample;
+    track.head = (track.head + 1) % samplesPerTrack;
+    track.count = qMin(track.count + 1, samplesPerTrack);
+    track.lastTimestampInMS = timestampInMS;
+}
+
+
+void Traffic::TrackHistory::clear()
+{
+    for(auto& track : m_tracks)
+    {
+        track = Track();
+    }
+}
+
+
+qsizetype Traffic::TrackHistory::find(const QString& ID) const
+{
+    for(qsizetype i=0; i<maxTracks; i++)
+    {
+        if ((m_tracks[i].count > 0) && (m_tracks[i].ID == ID))
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+
+QGeoPath Traffic::TrackHistory::path(qsizetype slot) const
+{
+    const auto& track = m_tracks[slot];
+    QList<QGeoCoordinate> coordinates;
+    coordinates.reserve(track.count);
+    auto const first = (track.head - track.count + samplesPerTrack) % samplesPerTrack;
+    for(qsizetype i=0; i<track.count; i++)
+    {
+        const auto& sample = m_samples[slot*samplesPerTrack + (first + i) % samplesPerTrack];
+        QGeoCoordinate coordinate(sample.latitude/degreesToFixed, sample.longitude/degreesToFixed);
+        if ((sample.flags & hasAltitude) != 0)
+        {
+            coordinate.setAltitude(sample.altitudeInM);
+        }
+        coordinates.append(coordinate);
+    }
+    return QGeoPath(coordinates);
+}
+
+
+QGeoPath Traffic::TrackHistory::trail(const QString& ID) const
+{
+    auto const slot = find(ID);
+    if (slot < 0)
+    {
+        return {};
+    }
+    if (QDateTime::currentMSecsSinceEpoch() - m_tracks[slot].lastTimestampInMS > trackLifetimeInMS)
+    {
+        return {};
+    }
+    return path(slot);
+}
+
+
+QList<QGeoPath> Traffic::TrackHistory::trails() const
+{
+    QList<QGeoPath> result;
+    auto const now = QDateTime::currentMSecsSinceEpoch();
+    for(qsizetype slot=0; slot<maxTracks; slot++)
+    {
+        if ((m_tracks[slot].count < 2) || (now - m_tracks[slot].lastTimestampInMS > trackLifetimeInMS))
+        {
+            continue;
+        }
+        result.append(path(slot));
+    }
+    return result;
+}
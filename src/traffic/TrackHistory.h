@@ -0,0 +1,144 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QGeoPath>
+#include <array>
+#include <vector>
+
+#include "positioning/PositionInfo.h"
+
+
+namespace Traffic {
+
+/*! \brief Recent positions of traffic
+ *
+ *  This class remembers the recent positions of traffic, so that trails can be
+ *  drawn on the moving map. For every traffic, samples are stored in a ring
+ *  buffer. Samples are quantized, so that one sample takes 16 bytes: latitude
+ *  and longitude in units of 1e-7 degrees, altitude in meters, track in units
+ *  of 360/65536 degrees and time since the previous sample in tenths of a
+ *  second.
+ *
+ *  The total memory is fixed: at most maxTracks traffic with at most
+ *  samplesPerTrack samples each. All memory is allocated in the constructor,
+ *  and append() does not allocate. If all slots are in use, the traffic that
+ *  has not been reported for the longest time is forgotten.
+ */
+
+class TrackHistory
+{
+public:
+    /*! \brief Standard constructor */
+    TrackHistory();
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Add a position to the trail of a traffic
+     *
+     *  Positions that are reported less than minSampleIntervalInMS after the
+     *  previous sample are ignored.
+     *
+     *  @param ID Identifier of the traffic
+     *
+     *  @param positionInfo Position of the traffic. Invalid positions are
+     *  ignored.
+     */
+    void append(const QString& ID, const Positioning::PositionInfo& positionInfo);
+
+    /*! \brief Forget all traffic */
+    void clear();
+
+    /*! \brief Trail of a traffic
+     *
+     *  @param ID Identifier of the traffic
+     *
+     *  @returns Path from the oldest to the most recent position, or an empty
+     *  path if the traffic is unknown or has not been reported for
+     *  trackLifetimeInMS
+     */
+    [[nodiscard]] QGeoPath trail(const QString& ID) const;
+
+    /*! \brief Trails of all traffic
+     *
+     *  @returns Paths of all traffic that have at least two positions and that
+     *  have been reported within trackLifetimeInMS
+     */
+    [[nodiscard]] QList<QGeoPath> trails() const;
+
+
+    //
+    // Constants
+    //
+
+    /*! \brief Maximal number of traffic */
+    static constexpr qsizetype maxTracks = 64;
+
+    /*! \brief Maximal number of samples per traffic */
+    static constexpr qsizetype samplesPerTrack = 64;
+
+    /*! \brief Minimal time between two samples */
+    static constexpr qint64 minSampleIntervalInMS = 1000;
+
+    /*! \brief Period after which a traffic without reports is forgotten */
+    static constexpr qint64 trackLifetimeInMS = 60000;
+
+private:
+    // Quantized position
+    struct Sample
+    {
+        qint32 latitude;
+        qint32 longitude;
+        qint16 altitudeInM;
+        quint16 track;
+        quint16 deltaTInDeciS;
+        quint16 flags;
+    };
+    static_assert(sizeof(Sample) == 16);
+
+    // Bits in Sample::flags
+    static constexpr quint16 hasAltitude = 1;
+    static constexpr quint16 hasTrack = 2;
+
+    // Ring buffer of one traffic. The samples live in m_samples, starting at
+    // index slot*samplesPerTrack.
+    struct Track
+    {
+        QString ID;
+        qint64 lastTimestampInMS {0};
+        qsizetype head {0};
+        qsizetype count {0};
+    };
+
+    // Returns the slot of a traffic, or -1
+    [[nodiscard]] qsizetype find(const QString& ID) const;
+
+    // Converts the samples of a slot to a path
+    [[nodiscard]] QGeoPath path(qsizetype slot) const;
+
+    std::array<Track, maxTracks> m_tracks;
+    std::vector<Sample> m_samples;
+};
+
+} // namespace Traffic
@@ -0,0 +1,156 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QtGlobal>
+#include <atomic>
+
+
+namespace Traffic {
+
+/*! \brief Counters for the data received from one traffic data source
+ *
+ *  The counters are updated on the hot path of the traffic data pipeline,
+ *  partly in the I/O thread of TrafficDataReader and partly in the thread of
+ *  the data source.  They are therefore implemented as relaxed atomics, which
+ *  are lock-free on all supported platforms.  Readers take a snapshot with
+ *  snapshot(); the counters of a snapshot are individually, but not mutually,
+ *  consistent.
+ */
+
+class TrafficDataMetrics
+{
+public:
+    /*! \brief Plain copy of the counters */
+    struct Snapshot
+    {
+        /*! \brief Number of bytes received from the link */
+        quint64 bytesReceived {0};
+
+        /*! \brief Number of FLARM/NMEA sentences and GDL90 frames with invalid checksum */
+        quint64 checksumErrors {0};
+
+        /*! \brief Number of valid frames that were dropped because the consumer could not keep up */
+        quint64 framesDropped {0};
+
+        /*! \brief Number of messages that were parsed */
+        quint64 messagesParsed {0};
+
+        /*! \brief Total time spent parsing messages, in nanoseconds */
+        quint64 parseTimeInNS {0};
+
+        /*! \brief Number of messages of unknown type */
+        quint64 unknownMessages {0};
+    };
+
+    /*! \brief Measures the time spent parsing one message
+     *
+     *  Construct an object of this class on the stack before parsing a message.
+     *  The message is counted, and the parse time recorded, when the object
+     *  goes out of scope.
+     */
+    class ParseTimer
+    {
+    public:
+        /*! \brief Start measuring
+         *
+         *  @param metrics Metrics that are updated on destruction
+         */
+        explicit ParseTimer(TrafficDataMetrics& metrics)
+            : m_metrics(metrics)
+        {
+            m_timer.start();
+        }
+
+        // Records the measurement
+        ~ParseTimer()
+        {
+            m_metrics.m_messagesParsed.fetch_add(1, std::memory_order_relaxed);
+            m_metrics.m_parseTimeInNS.fetch_add(static_cast<quint64>(m_timer.nsecsElapsed()), std::memory_order_relaxed);
+        }
+
+    private:
+        Q_DISABLE_COPY_MOVE(ParseTimer)
+
+        TrafficDataMetrics& m_metrics;
+        QElapsedTimer m_timer;
+    };
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Count received bytes
+     *
+     *  @param count Number of bytes
+     */
+    void addBytesReceived(qsizetype count)
+    {
+        m_bytesReceived.fetch_add(static_cast<quint64>(count), std::memory_order_relaxed);
+    }
+
+    /*! \brief Count a sentence or frame with invalid checksum */
+    void addChecksumError()
+    {
+        m_checksumErrors.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /*! \brief Count a frame that was dropped */
+    void addDroppedFrame()
+    {
+        m_framesDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /*! \brief Count a message of unknown type */
+    void addUnknownMessage()
+    {
+        m_unknownMessages.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /*! \brief Current values of the counters
+     *
+     *  @returns Snapshot of the counters
+     */
+    [[nodiscard]] Snapshot snapshot() const
+    {
+        Snapshot result;
+        result.bytesReceived = m_bytesReceived.load(std::memory_order_relaxed);
+        result.checksumErrors = m_checksumErrors.load(std::memory_order_relaxed);
+        result.framesDropped = m_framesDropped.load(std::memory_order_relaxed);
+        result.messagesParsed = m_messagesParsed.load(std::memory_order_relaxed);
+        result.parseTimeInNS = m_parseTimeInNS.load(std::memory_order_relaxed);
+        result.unknownMessages = m_unknownMessages.load(std::memory_order_relaxed);
+        return result;
+    }
+
+private:
+    std::atomic<quint64> m_bytesReceived {0};
+    std::atomic<quint64> m_checksumErrors {0};
+    std::atomic<quint64> m_framesDropped {0};
+    std::atomic<quint64> m_messagesParsed {0};
+    std::atomic<quint64> m_parseTimeInNS {0};
+    std::atomic<quint64> m_unknownMessages {0};
+};
+
+} // namespace Traffic
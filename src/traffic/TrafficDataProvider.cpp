@@ -20,8 +20,12 @@
 
 #include <QCoreApplication>
 #include <QFile>
+#include <QSettings>
 
+#include "GlobalSettings.h"
 #include "platform/PlatformAdaptor_Abstract.h"
+#include "positioning/PositionProvider.h"
+#include "traffic/FlarmnetDB.h"
 #include "traffic/TrafficDataProvider.h"
 
 #if __has_include(<QSerialPort>)
@@ -44,6 +48,13 @@ Traffic::TrafficDataProvider::TrafficDataProvider(QObject *parent) : Positioning
     }
     m_trafficObjectWithoutPosition = new Traffic::TrafficFactor_DistanceOnly(this);
     QQmlEngine::setObjectOwnership(m_trafficObjectWithoutPosition, QQmlEngine::CppOwnership);
+    m_trafficModel = new Traffic::TrafficObjectModel(m_trafficObjects, this);
+    QQmlEngine::setObjectOwnership(m_trafficModel, QQmlEngine::CppOwnership);
+
+    // Setup coalescing of incoming traffic factors
+    m_publishTimer.setInterval(Traffic::TrafficObjectModel::frameInterval);
+    m_publishTimer.setSingleShot(true);
+    connect(&m_publishTimer, &QTimer::timeout, this, &Traffic::TrafficDataProvider::publishTrafficFactors);
 
     setSourceName(tr("Traffic data receiver"));
 
@@ -52,6 +63,17 @@ Traffic::TrafficDataProvider::TrafficDataProvider(QObject *parent) : Positioning
     m_WarningTimer.setSingleShot(true);
     connect(&m_WarningTimer, &QTimer::timeout, this, &Traffic::TrafficDataProvider::resetWarning);
 
+    // Setup traffic data metrics
+    m_metricsTimer.setInterval(metricsInterval);
+    connect(&m_metricsTimer, &QTimer::timeout, this, &Traffic::TrafficDataProvider::updateTrafficDataMetrics);
+    m_metricsTimer.start();
+    m_metricsElapsedTimer.start();
+
+    // Setup traffic trails
+    m_trailsTimer.setInterval(trailsInterval);
+    connect(&m_trailsTimer, &QTimer::timeout, this, &Traffic::TrafficDataProvider::updateTrafficTrails);
+    m_trailsTimer.start();
+
     // Setup ForeFlight Broadcases
     foreFlightBroadcastTimer.setInterval(5s);
     connect(&foreFlightBroadcastTimer, &QTimer::timeout, this, &Traffic::TrafficDataProvider::foreFlightBroadcast);
@@ -81,6 +103,9 @@ Traffic::TrafficDataProvider::TrafficDataProvider(QObject *parent) : Positioning
     reconnectionTimer.setInterval(5min);
     reconnectionTimer.setSingleShot(false);
     reconnectionTimer.start();
+    m_probeTimer.setInterval(probeDelay);
+    m_probeTimer.setSingleShot(true);
+    connect(&m_probeTimer, &QTimer::timeout, this, &Traffic::TrafficDataProvider::connectAllDataSources);
 
     // Try to (re)connect whenever the network situation changes
     QTimer::singleShot(0, this, &Traffic::TrafficDataProvider::deferredInitialization);
@@ -104,6 +129,7 @@ void Traffic::TrafficDataProvider::addDataSource(Traffic::TrafficDataSource_Abst
     m_dataSources << source;
     connect(source, &Traffic::TrafficDataSource_Abstract::connectivityStatusChanged, this, &Traffic::TrafficDataProvider::updateStatusString);
     connect(source, &Traffic::TrafficDataSource_Abstract::errorStringChanged, this, &Traffic::TrafficDataProvider::updateStatusString);
+    connect(source, &Traffic::TrafficDataSource_Abstract::factorWithPosition, this, [this, source](const Traffic::TrafficFactor_WithPosition& factor) { onTrafficFactorWithPosition(source, factor); });
     connect(source, &Traffic::TrafficDataSource_Abstract::passwordRequest, this, &Traffic::TrafficDataProvider::passwordRequest);
     connect(source, &Traffic::TrafficDataSource_Abstract::passwordStorageRequest, this, &Traffic::TrafficDataProvider::passwordStorageRequest);
     connect(source, &Traffic::TrafficDataSource_Abstract::receivingHeartbeatChanged, this, &Traffic::TrafficDataProvider::updateStatusString);
@@ -202,6 +228,99 @@ QString Traffic::TrafficDataProvider::addDataSource_TCP(const QString& host, qui
     return {};
 }
 
+void Traffic::TrafficDataProvider::applyTrafficFactor(const PendingTrafficFactor& factor)
+{
+    // Copies the pending factor into target. The lifetime of target is
+    // (re)started. The alarm level computed by the conflict detector is kept
+    // only for traffic whose receiver does not predict conflicts itself.
+    auto copyInto = [this, &factor](Traffic::TrafficFactor_WithPosition* target)
+    {
+        m_trafficKeys.insert(target, factor.key);
+        m_receiverAlarmLevels.insert(target, factor.alarmLevel);
+        if (factor.predictConflicts)
+        {
+            m_computedAlarmLevels.insert(target, factor.computedAlarmLevel);
+        }
+        else
+        {
+            m_computedAlarmLevels.remove(target);
+        }
+        target->setPositionInfo(factor.positionInfo);
+        target->setAlarmLevel(qMax(factor.alarmLevel, m_computedAlarmLevels.value(target, 0)));
+        target->setCallSign(factor.callSign);
+        target->setHDist(factor.hDist);
+        target->setID(factor.ID);
+        target->setType(factor.type);
+        target->setVDist(factor.vDist);
+        target->startLiveTime();
+    };
+
+    // Check if traffic is too far away to be shown
+    bool farAway = false;
+    if (factor.vDist.isFinite() && (factor.vDist > maxVerticalDistance))
+    {
+        farAway = true;
+    }
+    if (factor.hDist.isFinite() && (factor.hDist > maxHorizontalDistance))
+    {
+        farAway = true;
+    }
+
+    // Remember position for the trail
+    if (!farAway)
+    {
+        m_trackHistory.append(factor.key, factor.positionInfo);
+    }
+
+
+    // Check if the traffic is one of the known factors. Targets are matched by
+    // track key, because the ID can change when traffic data from several
+    // sources is combined.
+    foreach(auto target, m_trafficObjects)
+    {
+        if (factor.key == m_trafficKeys.value(target))
+        {
+            // If traffic is too far away, delete the entry. Otherwise, replace the entry by the factor.
+            if (farAway)
+            {
+                target->setAnimate(false);
+                target->copyFrom(TrafficFactor_WithPosition());
+                m_trafficKeys.remove(target);
+                m_receiverAlarmLevels.remove(target);
+                m_computedAlarmLevels.remove(target);
+            }
+            else
+            {
+                target->setAnimate(true);
+                copyInto(target);
+            }
+            return;
+        }
+    }
+
+    // If traffic is too far away, ignore the factor.
+    if (farAway) {
+        return;
+    }
+
+    auto *lowestPriObject = m_trafficObjects.at(0);
+    foreach(auto target, m_trafficObjects)
+    {
+        if (lowestPriObject->hasHigherPriorityThan(*target))
+        {
+            lowestPriObject = target;
+        }
+    }
+
+    auto const hasHigherPriority = TrafficFactor_Abstract::hasHigherPriority(factor.valid, qMax(factor.alarmLevel, factor.computedAlarmLevel), factor.hDist,
+                                                                             lowestPriObject->valid(), lowestPriObject->alarmLevel(), lowestPriObject->hDist());
+    if (hasHigherPriority)
+    {
+        lowestPriObject->setAnimate(false);
+        copyInto(lowestPriObject);
+    }
+}
+
 void Traffic::TrafficDataProvider::clearDataSources()
 {
     if (m_dataSources.isEmpty())
@@ -220,8 +339,9 @@ void Traffic::TrafficDataProvider::clearDataSources()
     m_dataSources.clear();
 }
 
-void Traffic::TrafficDataProvider::connectToTrafficReceiver()
+void Traffic::TrafficDataProvider::connectAllDataSources()
 {
+    m_probeTimer.stop();
     foreach(auto dataSource, m_dataSources)
     {
         if (dataSource.isNull())
@@ -234,6 +354,22 @@ void Traffic::TrafficDataProvider::connectToTrafficReceiver()
     updateStatusString();
 }
 
+void Traffic::TrafficDataProvider::connectToTrafficReceiver()
+{
+    // Try the last good data source first, if there is one. When traffic data
+    // from all sources is combined, there is nothing to prefer.
+    auto* lastGood = lastGoodDataSource();
+    if (!m_trafficDataFusion && (lastGood != nullptr) && !receivingHeartbeat())
+    {
+        lastGood->connectToTrafficReceiver();
+        updateStatusString();
+        m_probeTimer.start();
+        return;
+    }
+
+    connectAllDataSources();
+}
+
 QList<Traffic::TrafficDataSource_Abstract*> Traffic::TrafficDataProvider::dataSources() const
 {
     QList<Traffic::TrafficDataSource_Abstract*> result;
@@ -254,10 +390,51 @@ QList<Traffic::TrafficDataSource_Abstract*> Traffic::TrafficDataProvider::dataSo
     return result;
 }
 
-void Traffic::TrafficDataProvider::deferredInitialization() const
+void Traffic::TrafficDataProvider::deferredInitialization()
 {
     // Try to (re)connect whenever the network situation changes
     connect(GlobalObject::platformAdaptor(), &Platform::PlatformAdaptor_Abstract::wifiConnected, this, &Traffic::TrafficDataProvider::connectToTrafficReceiver);
+
+    // Update collision prediction whenever the own position changes
+    connect(GlobalObject::positionProvider(), &Positioning::PositionProvider::positionInfoChanged, this, &Traffic::TrafficDataProvider::updateConflicts);
+
+    // Show registrations as soon as the FlarmnetDB has resolved them
+    connect(GlobalObject::flarmnetDB(), &Traffic::FlarmnetDB::registrationsChanged, this, &Traffic::TrafficDataProvider::onRegistrationsChanged);
+
+    // Combine traffic data from several sources, if so desired
+    connect(GlobalObject::globalSettings(), &GlobalSettings::trafficDataFusionChanged, this, &Traffic::TrafficDataProvider::updateTrafficDataFusion);
+    updateTrafficDataFusion();
+
+    // Re-broadcast ownship and traffic data to other apps, if so desired
+    connect(GlobalObject::positionProvider(), &Positioning::PositionProvider::positionInfoChanged, this, &Traffic::TrafficDataProvider::broadcastOwnship);
+    connect(GlobalObject::globalSettings(), &GlobalSettings::trafficDataBroadcastChanged, this, &Traffic::TrafficDataProvider::updateTrafficDataBroadcast);
+    updateTrafficDataBroadcast();
+}
+
+void Traffic::TrafficDataProvider::disconnectLowerPrioritySources()
+{
+    if (m_currentSource.isNull())
+    {
+        return;
+    }
+
+    bool doDisconnect = false;
+    foreach(auto source, m_dataSources)
+    {
+        if ( source.isNull() )
+        {
+            continue;
+        }
+        if (source == m_currentSource)
+        {
+            doDisconnect = true;
+            continue;
+        }
+        if (doDisconnect)
+        {
+            source->disconnectFromTrafficReceiver();
+        }
+    }
 }
 
 void Traffic::TrafficDataProvider::disconnectFromTrafficReceiver()
@@ -272,11 +449,45 @@ void Traffic::TrafficDataProvider::disconnectFromTrafficReceiver()
     }
 }
 
+void Traffic::TrafficDataProvider::broadcastOwnship()
+{
+    auto* positionProvider = GlobalObject::positionProvider();
+    m_gdl90Broadcaster.sendOwnship(positionProvider->positionInfo(), positionProvider->pressureAltitude());
+}
+
 void Traffic::TrafficDataProvider::foreFlightBroadcast()
 {
     foreFlightBroadcastSocket.writeDatagram(foreFlightBroadcastDatagram);
 }
 
+Traffic::TrafficDataSource_Abstract* Traffic::TrafficDataProvider::lastGoodDataSource() const
+{
+    auto SSID = GlobalObject::platformAdaptor()->currentSSID();
+    if (SSID.isEmpty())
+    {
+        return nullptr;
+    }
+    auto endpoint = QSettings().value(QStringLiteral("TrafficDataProvider/lastGoodEndpoints")).toMap().value(SSID).toString();
+    if (endpoint.isEmpty())
+    {
+        return nullptr;
+    }
+
+    foreach(auto dataSource, m_dataSources)
+    {
+        auto* tcpSource = qobject_cast<Traffic::TrafficDataSource_Tcp*>(dataSource);
+        if (tcpSource == nullptr)
+        {
+            continue;
+        }
+        if (endpoint == u"%1:%2"_qs.arg(tcpSource->host()).arg(tcpSource->port()))
+        {
+            return tcpSource;
+        }
+    }
+    return nullptr;
+}
+
 void Traffic::TrafficDataProvider::loadConnectionInfos()
 {
     QFile outFile(stdFileName);
@@ -293,6 +504,33 @@ void Traffic::TrafficDataProvider::loadConnectionInfos()
     }
 }
 
+void Traffic::TrafficDataProvider::onRegistrationsChanged(const QStringList& keys)
+{
+    auto* flarmnetDB = GlobalObject::flarmnetDB();
+    foreach(auto* target, m_trafficObjects)
+    {
+        if (target->callSign().isEmpty() && keys.contains(target->ID()))
+        {
+            target->setCallSign(flarmnetDB->getCachedRegistration(target->ID()));
+        }
+    }
+    if (!m_trafficObjectWithoutPosition.isNull()
+        && m_trafficObjectWithoutPosition->callSign().isEmpty()
+        && keys.contains(m_trafficObjectWithoutPosition->ID()))
+    {
+        m_trafficObjectWithoutPosition->setCallSign(flarmnetDB->getCachedRegistration(m_trafficObjectWithoutPosition->ID()));
+    }
+
+    // Pending factors would otherwise overwrite the call signs in the next frame
+    for(auto& factor : m_pendingTrafficFactors)
+    {
+        if (factor.callSign.isEmpty() && keys.contains(factor.ID))
+        {
+            factor.callSign = flarmnetDB->getCachedRegistration(factor.ID);
+        }
+    }
+}
+
 void Traffic::TrafficDataProvider::onSourceHeartbeatChanged()
 {
     // If we have a current source, if the current source has a heartbeat and if the current source is a TCP source, then we simply stick with it.
@@ -328,7 +566,6 @@ void Traffic::TrafficDataProvider::onSourceHeartbeatChanged()
         {
             disconnect(m_currentSource, &Traffic::TrafficDataSource_Abstract::pressureAltitudeUpdated, this, &Traffic::TrafficDataProvider::setPressureAltitude);
             disconnect(m_currentSource, &Traffic::TrafficDataSource_Abstract::factorWithoutPosition, this, &Traffic::TrafficDataProvider::onTrafficFactorWithoutPosition);
-            disconnect(m_currentSource, &Traffic::TrafficDataSource_Abstract::factorWithPosition, this, &Traffic::TrafficDataProvider::onTrafficFactorWithPosition);
             disconnect(m_currentSource, &Traffic::TrafficDataSource_Abstract::positionUpdated, this, &Traffic::TrafficDataProvider::setPositionInfo);
             disconnect(m_currentSource, &Traffic::TrafficDataSource_Abstract::warning, this, &Traffic::TrafficDataProvider::setWarning);
         }
@@ -339,30 +576,20 @@ void Traffic::TrafficDataProvider::onSourceHeartbeatChanged()
         if (!m_currentSource.isNull())
         {
             // If there is a new m_currentSource, then setup Qt connections and
-            // disconnect all sources of lower priority from the traffic receivers.
+            // disconnect all sources of lower priority from the traffic
+            // receivers, unless traffic data from all sources is combined.
             connect(m_currentSource, &Traffic::TrafficDataSource_Abstract::pressureAltitudeUpdated, this, &Traffic::TrafficDataProvider::setPressureAltitude);
             connect(m_currentSource, &Traffic::TrafficDataSource_Abstract::factorWithoutPosition, this, &Traffic::TrafficDataProvider::onTrafficFactorWithoutPosition);
-            connect(m_currentSource, &Traffic::TrafficDataSource_Abstract::factorWithPosition, this, &Traffic::TrafficDataProvider::onTrafficFactorWithPosition);
             connect(m_currentSource, &Traffic::TrafficDataSource_Abstract::positionUpdated, this, &Traffic::TrafficDataProvider::setPositionInfo);
             connect(m_currentSource, &Traffic::TrafficDataSource_Abstract::warning, this, &Traffic::TrafficDataProvider::setWarning);
+            saveLastGoodDataSource();
 
-            // Disconnect from traffic receiver
-            bool doDisconnect = false;
-            foreach(auto source, m_dataSources)
+            // When traffic data is combined, a pending probe still needs to
+            // connect the remaining sources.
+            if (!m_trafficDataFusion)
             {
-                if ( source.isNull() )
-                {
-                    continue;
-                }
-                if (source == m_currentSource)
-                {
-                    doDisconnect = true;
-                    continue;
-                }
-                if (doDisconnect)
-                {
-                    source->disconnectFromTrafficReceiver();
-                }
+                m_probeTimer.stop();
+                disconnectLowerPrioritySources();
             }
         }
         else
@@ -403,62 +630,49 @@ void Traffic::TrafficDataProvider::onTrafficFactorWithoutPosition(const Traffic:
 
 }
 
-void Traffic::TrafficDataProvider::onTrafficFactorWithPosition(const Traffic::TrafficFactor_WithPosition &factor)
+void Traffic::TrafficDataProvider::onTrafficFactorWithPosition(Traffic::TrafficDataSource_Abstract* source, const Traffic::TrafficFactor_WithPosition &factor)
 {
-
-    // Check if traffic is too far away to be shown
-    bool farAway = false;
-    if (factor.vDist().isFinite() && (factor.vDist() > maxVerticalDistance))
+    QString key = factor.ID();
+    if (source != m_currentSource)
     {
-        farAway = true;
-    }
-    if (factor.hDist().isFinite() && (factor.hDist() > maxHorizontalDistance))
-    {
-        farAway = true;
-    }
-
-
-    // Check if the traffic is one of the known factors.
-    foreach(auto target, m_trafficObjects)
-    {
-        if (factor.ID() == target->ID())
+        if (!m_trafficDataFusion || !source->receivingHeartbeat())
         {
-            // If traffic is too far away, delete the entry. Otherwise, replace the entry by the factor.
-            if (farAway)
-            {
-                target->setAnimate(false);
-                target->copyFrom(TrafficFactor_WithPosition());
-            }
-            else
-            {
-                target->setAnimate(true);
-                target->copyFrom(factor);
-                target->startLiveTime();
-            }
             return;
         }
     }
 
-    // If traffic is too far away, ignore the factor.
-    if (farAway) {
-        return;
-    }
-
-    auto *lowestPriObject = m_trafficObjects.at(0);
-    foreach(auto target, m_trafficObjects)
+    // If traffic data from several sources is combined, file the factor under
+    // the key of the correlated track. Factors are dropped if a preferred
+    // source reports the same traffic. The ID reported by the source is kept,
+    // so that registrations can still be looked up.
+    if (m_trafficDataFusion)
     {
-        if (lowestPriObject->hasHigherPriorityThan(*target))
+        key = m_trafficFusion.correlate(factor.ID(), factor.positionInfo(), factor.vDist(), static_cast<int>(m_dataSources.indexOf(source)));
+        if (key.isEmpty())
         {
-            lowestPriObject = target;
+            return;
         }
     }
-    if (factor.hasHigherPriorityThan(*lowestPriObject))
+
+    // Store a plain copy of the factor. If several factors with the same key
+    // arrive within one frame, only the last one is kept.
+    auto& pending = m_pendingTrafficFactors[key];
+    pending.alarmLevel = factor.alarmLevel();
+    pending.callSign = factor.callSign();
+    pending.computedAlarmLevel = 0;
+    pending.hDist = factor.hDist();
+    pending.ID = factor.ID();
+    pending.key = key;
+    pending.positionInfo = factor.positionInfo();
+    pending.predictConflicts = !source->receiverPredictsConflicts();
+    pending.type = factor.type();
+    pending.valid = factor.valid();
+    pending.vDist = factor.vDist();
+
+    if (!m_publishTimer.isActive())
     {
-        lowestPriObject->setAnimate(false);
-        lowestPriObject->copyFrom(factor);
-        lowestPriObject->startLiveTime();
+        m_publishTimer.start();
     }
-
 }
 
 void Traffic::TrafficDataProvider::onTrafficReceiverRuntimeError()
@@ -509,6 +723,46 @@ void Traffic::TrafficDataProvider::onTrafficReceiverSelfTestError()
     emit trafficReceiverSelfTestErrorChanged();
 }
 
+void Traffic::TrafficDataProvider::publishTrafficFactors()
+{
+    m_publishTimer.stop();
+    if (m_trafficDataFusion)
+    {
+        m_trafficFusion.expire();
+    }
+
+    // Predict conflicts for all incoming GDL90 and XGPS traffic at once. These
+    // formats do not come with alarm levels of their own. FLARM traffic is
+    // left alone, because FLARM devices predict conflicts themselves and
+    // deliberately suppress some alarms. The predicted alarm level raises,
+    // but never lowers, the alarm level reported by the traffic data receiver.
+    m_conflictDetector.setOwnship(GlobalObject::positionProvider()->positionInfo());
+    m_conflictDetector.clearTargets();
+    QList<PendingTrafficFactor*> predictedFactors;
+    for(auto& factor : m_pendingTrafficFactors)
+    {
+        if (factor.predictConflicts)
+        {
+            m_conflictDetector.addTarget(factor.key, factor.positionInfo, factor.vDist);
+            predictedFactors << &factor;
+        }
+    }
+    m_conflictDetector.compute();
+    for(qsizetype i=0; i<predictedFactors.size(); i++)
+    {
+        predictedFactors[i]->computedAlarmLevel = m_conflictDetector.alarmLevel(i);
+    }
+
+    foreach(const auto& factor, m_pendingTrafficFactors)
+    {
+        applyTrafficFactor(factor);
+    }
+    m_pendingTrafficFactors.clear();
+    updateWarning();
+    m_trafficModel->publish();
+    m_gdl90Broadcaster.sendTraffic(m_trafficObjects, pressureAltitude());
+}
+
 void Traffic::TrafficDataProvider::removeDataSource(Traffic::TrafficDataSource_Abstract* source)
 {
     if (source == nullptr)
@@ -572,6 +826,30 @@ void Traffic::TrafficDataProvider::setPassword(const QString& SSID, const QStrin
     }
 }
 
+void Traffic::TrafficDataProvider::saveLastGoodDataSource() const
+{
+    auto* tcpSource = qobject_cast<Traffic::TrafficDataSource_Tcp*>(m_currentSource);
+    if (tcpSource == nullptr)
+    {
+        return;
+    }
+    auto SSID = GlobalObject::platformAdaptor()->currentSSID();
+    if (SSID.isEmpty())
+    {
+        return;
+    }
+
+    QSettings settings;
+    auto endpoints = settings.value(QStringLiteral("TrafficDataProvider/lastGoodEndpoints")).toMap();
+    auto endpoint = u"%1:%2"_qs.arg(tcpSource->host()).arg(tcpSource->port());
+    if (endpoints.value(SSID).toString() == endpoint)
+    {
+        return;
+    }
+    endpoints.insert(SSID, endpoint);
+    settings.setValue(QStringLiteral("TrafficDataProvider/lastGoodEndpoints"), endpoints);
+}
+
 void Traffic::TrafficDataProvider::setReceivingHeartbeat(bool newReceivingHeartbeat)
 {
     if (m_receivingHeartbeat == newReceivingHeartbeat)
@@ -589,13 +867,39 @@ void Traffic::TrafficDataProvider::setWarning(const Traffic::Warning& warning)
         m_WarningTimer.start();
     }
 
-    if (m_Warning == warning)
+    m_receiverWarning = warning;
+    updateWarning();
+}
+
+void Traffic::TrafficDataProvider::updateConflicts()
+{
+    // Traffic objects whose receiver does not predict conflicts, see
+    // publishTrafficFactors()
+    QList<Traffic::TrafficFactor_WithPosition*> targets;
+    foreach(auto* target, m_trafficObjects)
     {
-        return;
+        if (target->valid() && m_computedAlarmLevels.contains(target))
+        {
+            targets << target;
+        }
     }
 
-    m_Warning = warning;
-    emit warningChanged(m_Warning);
+    m_conflictDetector.setOwnship(GlobalObject::positionProvider()->positionInfo());
+    m_conflictDetector.clearTargets();
+    foreach(auto* target, targets)
+    {
+        m_conflictDetector.addTarget(m_trafficKeys.value(target), target->positionInfo(), target->vDist());
+    }
+    m_conflictDetector.compute();
+
+    for(qsizetype i=0; i<targets.size(); i++)
+    {
+        auto* target = targets.at(i);
+        auto const computedAlarmLevel = m_conflictDetector.alarmLevel(i);
+        m_computedAlarmLevels.insert(target, computedAlarmLevel);
+        target->setAlarmLevel(qMax(m_receiverAlarmLevels.value(target, 0), computedAlarmLevel));
+    }
+    updateWarning();
 }
 
 void Traffic::TrafficDataProvider::updateStatusString()
@@ -624,3 +928,156 @@ void Traffic::TrafficDataProvider::updateStatusString()
     const QString result = tr("Not receiving traffic receiver heartbeat through any of the configured data connections.");
     setStatusString(result);
 }
+
+void Traffic::TrafficDataProvider::updateTrafficDataMetrics()
+{
+    auto const elapsedInS = static_cast<double>(m_metricsElapsedTimer.restart())/1000.0;
+
+    auto toMap = [elapsedInS](const QString& sourceName, const Traffic::TrafficDataMetrics::Snapshot& current, const Traffic::TrafficDataMetrics::Snapshot& last)
+    {
+        QVariantMap result;
+        result[u"sourceName"_qs] = sourceName;
+        result[u"bytesReceived"_qs] = current.bytesReceived;
+        result[u"messagesParsed"_qs] = current.messagesParsed;
+        result[u"checksumErrors"_qs] = current.checksumErrors;
+        result[u"framesDropped"_qs] = current.framesDropped;
+        result[u"unknownMessages"_qs] = current.unknownMessages;
+        result[u"messagesPerSecond"_qs] = (elapsedInS > 0.0) ? static_cast<double>(current.messagesParsed-last.messagesParsed)/elapsedInS : 0.0;
+        result[u"averageParseTimeInUS"_qs] = (current.messagesParsed > 0) ? static_cast<double>(current.parseTimeInNS)/static_cast<double>(current.messagesParsed)/1000.0 : 0.0;
+        return result;
+    };
+
+    QVariantList newMetrics;
+    QHash<const Traffic::TrafficDataSource_Abstract*, Traffic::TrafficDataMetrics::Snapshot> newLastMetrics;
+    Traffic::TrafficDataMetrics::Snapshot total;
+    Traffic::TrafficDataMetrics::Snapshot lastTotal;
+    foreach(auto dataSource, m_dataSources)
+    {
+        if (dataSource.isNull())
+        {
+            continue;
+        }
+        auto const current = dataSource->metrics();
+        newLastMetrics.insert(dataSource, current);
+        if (current.bytesReceived == 0)
+        {
+            continue;
+        }
+        auto const last = m_lastMetrics.value(dataSource);
+
+        auto map = toMap(dataSource->sourceName(), current, last);
+        newMetrics.append(map);
+
+        total.bytesReceived += current.bytesReceived;
+        total.checksumErrors += current.checksumErrors;
+        total.framesDropped += current.framesDropped;
+        total.messagesParsed += current.messagesParsed;
+        total.parseTimeInNS += current.parseTimeInNS;
+        total.unknownMessages += current.unknownMessages;
+        lastTotal.messagesParsed += last.messagesParsed;
+
+        // Structured debug message, only for sources that have received data
+        // since the last update. This is a debug message, so that active
+        // sources do not fill the log at level info.
+        if (current.bytesReceived != last.bytesReceived)
+        {
+            qDebug().noquote() << u"traffic-metrics source=\"%1\" bytes=%2 messages=%3 checksumErrors=%4 framesDropped=%5 unknownMessages=%6 messagesPerSecond=%7 averageParseTimeInUS=%8"_qs
+                                  .arg(dataSource->sourceName())
+                                  .arg(current.bytesReceived)
+                                  .arg(current.messagesParsed)
+                                  .arg(current.checksumErrors)
+                                  .arg(current.framesDropped)
+                                  .arg(current.unknownMessages)
+                                  .arg(map[u"messagesPerSecond"_qs].toDouble(), 0, 'f', 1)
+                                  .arg(map[u"averageParseTimeInUS"_qs].toDouble(), 0, 'f', 1);
+        }
+    }
+    newMetrics.append(toMap(tr("All data sources"), total, lastTotal));
+    m_lastMetrics = newLastMetrics;
+
+    m_trafficDataMetrics = newMetrics;
+    emit trafficDataMetricsChanged();
+}
+
+void Traffic::TrafficDataProvider::updateTrafficDataBroadcast()
+{
+    m_gdl90Broadcaster.setEnabled(GlobalObject::globalSettings()->trafficDataBroadcast());
+}
+
+void Traffic::TrafficDataProvider::updateTrafficDataFusion()
+{
+    auto const newTrafficDataFusion = GlobalObject::globalSettings()->trafficDataFusion();
+    if (newTrafficDataFusion == m_trafficDataFusion)
+    {
+        return;
+    }
+    m_trafficDataFusion = newTrafficDataFusion;
+    m_trafficFusion.clear();
+
+    // When combining traffic data, all sources need to be connected. Otherwise,
+    // only the preferred source is kept.
+    if (m_trafficDataFusion)
+    {
+        connectToTrafficReceiver();
+    }
+    else
+    {
+        disconnectLowerPrioritySources();
+    }
+}
+
+void Traffic::TrafficDataProvider::updateTrafficTrails()
+{
+    QVariantList newTrafficTrails;
+    foreach(const auto& trail, m_trackHistory.trails())
+    {
+        newTrafficTrails.append(QVariant::fromValue(trail));
+    }
+
+    // Avoid needless updates of the moving map while there is no traffic
+    if (newTrafficTrails.isEmpty() && m_trafficTrails.isEmpty())
+    {
+        return;
+    }
+    m_trafficTrails = newTrafficTrails;
+    emit trafficTrailsChanged();
+}
+
+void Traffic::TrafficDataProvider::updateWarning()
+{
+    // Valid traffic with the highest alarm level computed by the conflict
+    // detector
+    const Traffic::TrafficFactor_WithPosition* threat = nullptr;
+    int threatAlarmLevel = 0;
+    for(auto it = m_computedAlarmLevels.cbegin(); it != m_computedAlarmLevels.cend(); ++it)
+    {
+        if ((it.value() > threatAlarmLevel) && it.key()->valid())
+        {
+            threat = it.key();
+            threatAlarmLevel = it.value();
+        }
+    }
+
+    // The computed warning replaces the warning of the traffic receiver only
+    // if its alarm level is higher
+    auto newWarning = m_receiverWarning;
+    if ((threat != nullptr) && (threatAlarmLevel > m_receiverWarning.alarmLevel()))
+    {
+        Units::Angle relativeBearing;
+        auto const ownship = GlobalObject::positionProvider()->positionInfo();
+        auto const ownshipCoordinate = ownship.coordinate();
+        auto const threatCoordinate = threat->positionInfo().coordinate();
+        if (ownshipCoordinate.isValid() && threatCoordinate.isValid() && ownship.trueTrack().isFinite())
+        {
+            relativeBearing = Units::Angle::fromDEG(ownshipCoordinate.azimuthTo(threatCoordinate)) - ownship.trueTrack();
+        }
+        newWarning = Traffic::Warning(threatAlarmLevel, relativeBearing, threat->hDist(), threat->vDist());
+    }
+
+    if (m_Warning == newWarning)
+    {
+        return;
+    }
+    m_Warning = newWarning;
+    emit warningChanged(m_Warning);
+}
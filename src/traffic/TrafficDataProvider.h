@@ -20,14 +20,20 @@
 
 #pragma once
 
+#include <QElapsedTimer>
 #include <QNetworkDatagram>
 #include <QStandardPaths>
 #include <QUdpSocket>
 
 #include "GlobalObject.h"
 #include "positioning/PositionInfoSource_Abstract.h"
+#include "traffic/ConflictDetector.h"
 #include "traffic/ConnectionInfo.h"
+#include "traffic/GDL90Broadcaster.h"
 #include "traffic/TrafficDataSource_Abstract.h"
+#include "traffic/TrafficFusion.h"
+#include "traffic/TrafficObjectModel.h"
+#include "traffic/TrackHistory.h"
 
 namespace Traffic {
 
@@ -35,7 +41,10 @@ namespace Traffic {
  *
  *  This class manages multiple TrafficDataSources. It combines the data
  *  streams, and passes data from the most relevant (if any) traffic data source
- *  on to the consumers of this class.
+ *  on to the consumers of this class. If the setting
+ *  GlobalSettings::trafficDataFusion is true, traffic reported with position
+ *  is taken from all sources that receive heartbeat messages, and correlated
+ *  by TrafficFusion.
  *
  *  By default, it watches the following data channels:
  *
@@ -103,6 +112,35 @@ public:
      */
     Q_PROPERTY(QList<Traffic::TrafficFactor_WithPosition*> trafficObjects READ trafficObjects CONSTANT)
 
+    /*! \brief Counters of the traffic data pipeline
+     *
+     *  This property holds a list that can be used as a model in QML. It
+     *  contains one map for every data source that has received data,
+     *  followed by one map with the totals over all data sources. Every map
+     *  has the keys "sourceName", "bytesReceived", "messagesParsed",
+     *  "checksumErrors", "framesDropped", "unknownMessages", "messagesPerSecond" and
+     *  "averageParseTimeInUS".  The property is updated every
+     *  metricsInterval.
+     */
+    Q_PROPERTY(QVariantList trafficDataMetrics READ trafficDataMetrics NOTIFY trafficDataMetricsChanged)
+
+    /*! \brief Trails of traffic
+     *
+     *  This property holds the recent positions of all traffic that has been
+     *  reported within the last minute, as a list of QGeoPath, for display on
+     *  the moving map. The property is updated every trailsInterval.
+     */
+    Q_PROPERTY(QVariantList trafficTrails READ trafficTrails NOTIFY trafficTrailsChanged)
+
+    /*! \brief Traffic objects whose position is known, as a list model
+     *
+     *  This property holds the traffic objects of the property trafficObjects,
+     *  wrapped into a list model.  Incoming traffic data is coalesced and
+     *  published to QML at most once per display frame, which makes this model
+     *  the preferred way to show traffic in the GUI.
+     */
+    Q_PROPERTY(Traffic::TrafficObjectModel* trafficModel READ trafficModel CONSTANT)
+
     /*! \brief Most relevant traffic object whose position is not known
      *
      *  This property holds a pointer to the most relevant traffic object whose
@@ -167,6 +205,33 @@ public:
         return m_trafficObjects;
     }
 
+    /*! \brief Getter method for property with the same name
+     *
+     *  @returns Property trafficModel
+     */
+    [[nodiscard]] Traffic::TrafficObjectModel* trafficModel() const
+    {
+        return m_trafficModel;
+    }
+
+    /*! \brief Getter method for property with the same name
+     *
+     *  @returns Property trafficDataMetrics
+     */
+    [[nodiscard]] QVariantList trafficDataMetrics() const
+    {
+        return m_trafficDataMetrics;
+    }
+
+    /*! \brief Getter method for property with the same name
+     *
+     *  @returns Property trafficTrails
+     */
+    [[nodiscard]] QVariantList trafficTrails() const
+    {
+        return m_trafficTrails;
+    }
+
     /*! \brief Getter method for property with the same name
      *
      *  @returns Property trafficObjectWithoutPosition
@@ -292,6 +357,24 @@ public:
      */
     static constexpr Units::Distance maxHorizontalDistance = Units::Distance::fromNM(20.0);
 
+    /*! \brief Delay before all channels are tried
+     *
+     *  See connectToTrafficReceiver().
+     */
+    static constexpr auto probeDelay = 1s;
+
+    /*! \brief Interval for updating the traffic data metrics
+     *
+     *  See property trafficDataMetrics.
+     */
+    static constexpr auto metricsInterval = 10s;
+
+    /*! \brief Interval for updating the traffic trails
+     *
+     *  See property trafficTrails.
+     */
+    static constexpr auto trailsInterval = 1s;
+
 signals:
     /*! \brief Notifier signal */
     void dataSourcesChanged();
@@ -316,9 +399,15 @@ signals:
     /*! \brief Notifier signal */
     void receivingHeartbeatChanged(bool);
 
+    /*! \brief Notifier signal */
+    void trafficDataMetricsChanged();
+
     /*! \brief Notifier signal */
     void trafficReceiverRuntimeErrorChanged();
 
+    /*! \brief Notifier signal */
+    void trafficTrailsChanged();
+
     /*! \brief Notifier signal */
     void trafficReceiverSelfTestErrorChanged();
 
@@ -332,6 +421,10 @@ public slots:
      * nothing.  Otherwise, it stops any ongoing connection attempt and starts a
      * new attempt to connect to a potential receiver, via all available
      * channels simultaneously.
+     *
+     * If a TCP connection has delivered data in the current WiFi network
+     * before, that connection is tried first. The other channels follow after
+     * probeDelay, unless the first connection delivers data by then.
      */
     void connectToTrafficReceiver();
 
@@ -363,29 +456,45 @@ private slots:
     // Clear all data sources
     void clearDataSources();
 
+    // Starts connection attempts on all data sources
+    void connectAllDataSources();
+
     // Intializations that are moved out of the constructor, in order to avoid
     // nested uses of constructors in Global.
-    void deferredInitialization() const;
+    void deferredInitialization();
 
     // Sends out foreflight broadcast message See
     // https://www.foreflight.com/connect/spec/
     void foreFlightBroadcast();
 
+    // Re-broadcasts the position of the own aircraft via m_gdl90Broadcaster
+    void broadcastOwnship();
+
     // Load connection infos from file and create connections
     void loadConnectionInfos();
 
+    // Called when the FlarmnetDB has resolved registrations. Sets the call
+    // signs of traffic that is still shown without one.
+    void onRegistrationsChanged(const QStringList& keys);
+
     // Called if one of the sources indicates a heartbeat change
     void onSourceHeartbeatChanged();
 
-    // Called if one of the sources reports traffic (position unknown)
-    void onTrafficFactorWithPosition(const Traffic::TrafficFactor_WithPosition& factor);
+    // Called if one of the sources reports traffic (position known). Reports
+    // are ignored unless the source is m_currentSource, or unless traffic data
+    // fusion is enabled and the source receives heartbeat messages.
+    void onTrafficFactorWithPosition(Traffic::TrafficDataSource_Abstract* source, const Traffic::TrafficFactor_WithPosition& factor);
 
-    // Called if one of the sources reports traffic (position known)
+    // Called if one of the sources reports traffic (position unknown)
     void onTrafficFactorWithoutPosition(const Traffic::TrafficFactor_DistanceOnly& factor);
 
     // Called if one of the sources reports or clears an error string
     void onTrafficReceiverSelfTestError();
 
+    // Applies all traffic factors collected since the last frame to
+    // m_trafficObjects and publishes the changes via m_trafficModel
+    void publishTrafficFactors();
+
     // Called if one of the sources reports or clears an error string
     void onTrafficReceiverRuntimeError();
 
@@ -398,14 +507,74 @@ private slots:
     // Setter method
     void setReceivingHeartbeat(bool newReceivingHeartbeat);
 
-    // Setter method
+    // Sets the warning reported by the traffic receiver and updates the
+    // property warning
     void setWarning(const Traffic::Warning& warning);
 
+    // Predicts conflicts between own aircraft and those m_trafficObjects whose
+    // receiver does not predict conflicts, and sets the alarm levels of these
+    // traffic objects to the maximum of the predicted level and the level
+    // reported by the receiver. Called whenever the position of the own
+    // aircraft changes.
+    void updateConflicts();
+
     // Updates the property statusString that is inherited from
     // Positioning::PositionInfoSource_Abstract
     void updateStatusString();
 
+    // Collects the counters of all data sources, updates the property
+    // trafficDataMetrics and writes one debug message per active data source
+    void updateTrafficDataMetrics();
+
+    // Reads GlobalSettings::trafficDataBroadcast and enables or disables
+    // m_gdl90Broadcaster accordingly
+    void updateTrafficDataBroadcast();
+
+    // Reads GlobalSettings::trafficDataFusion and (dis)connects the sources of
+    // lower priority accordingly
+    void updateTrafficDataFusion();
+
+    // Updates the property trafficTrails from m_trackHistory
+    void updateTrafficTrails();
+
 private:
+    // Plain copy of the data contained in a TrafficFactor_WithPosition. Incoming
+    // traffic factors are stored in this form and applied to m_trafficObjects
+    // only once per frame.
+    struct PendingTrafficFactor
+    {
+        int alarmLevel {0};
+        QString callSign;
+        int computedAlarmLevel {0};
+        Units::Distance hDist;
+        QString ID;
+        QString key;
+        Positioning::PositionInfo positionInfo;
+        bool predictConflicts {false};
+        Traffic::TrafficFactor_Abstract::AircraftType type {Traffic::TrafficFactor_Abstract::unknown};
+        bool valid {false};
+        Units::Distance vDist;
+    };
+
+    // Applies a pending traffic factor to m_trafficObjects
+    void applyTrafficFactor(const PendingTrafficFactor& factor);
+
+    // Computes the property warning from m_receiverWarning and from the alarm
+    // levels computed by the conflict detector
+    void updateWarning();
+
+    // Disconnects all sources of lower priority than m_currentSource from their
+    // traffic receivers
+    void disconnectLowerPrioritySources();
+
+    // TCP data source that has last delivered data in the current WiFi
+    // network, or nullptr
+    [[nodiscard]] Traffic::TrafficDataSource_Abstract* lastGoodDataSource() const;
+
+    // Remembers m_currentSource as the last good data source for the current
+    // WiFi network, if it is a TCP data source
+    void saveLastGoodDataSource() const;
+
     // UDP Socket for ForeFlight Broadcast messages.
     // See https://www.foreflight.com/connect/spec/
     QNetworkDatagram foreFlightBroadcastDatagram {R"({"App":"Enroute Flight Navigation","GDL90":{"port":4000}})", QHostAddress::Broadcast, 63093};
@@ -415,19 +584,66 @@ private:
     // Targets
     QList<Traffic::TrafficFactor_WithPosition *> m_trafficObjects;
     QPointer<Traffic::TrafficFactor_DistanceOnly> m_trafficObjectWithoutPosition;
+    QPointer<Traffic::TrafficObjectModel> m_trafficModel;
+
+    // Traffic factors received since the last frame, at most one per track
+    // key. The track key is the ID of the traffic, or the key assigned by
+    // m_trafficFusion if traffic data from several sources is combined.
+    QHash<QString, PendingTrafficFactor> m_pendingTrafficFactors;
+    QTimer m_publishTimer;
+
+    // Track keys of the traffic objects
+    QHash<const Traffic::TrafficFactor_WithPosition*, QString> m_trafficKeys;
+
+    // Collision prediction for traffic that is reported with position
+    Traffic::ConflictDetector m_conflictDetector;
+
+    // Alarm levels of the traffic objects, as reported by the traffic receiver
+    // and as computed by m_conflictDetector. The alarm level of a traffic
+    // object is the maximum of both, so that it drops again when a predicted
+    // conflict is resolved. Only traffic whose receiver does not predict
+    // conflicts, that is, GDL90 and XGPS traffic, has a computed alarm level.
+    QHash<const Traffic::TrafficFactor_WithPosition*, int> m_receiverAlarmLevels;
+    QHash<const Traffic::TrafficFactor_WithPosition*, int> m_computedAlarmLevels;
+
+    // Correlation of traffic reported by several sources. Used only if
+    // m_trafficDataFusion is true.
+    Traffic::TrafficFusion m_trafficFusion;
+    bool m_trafficDataFusion {false};
+
+    // Traffic data metrics. The counters of the last update are kept in order
+    // to compute rates.
+    QVariantList m_trafficDataMetrics;
+    QHash<const Traffic::TrafficDataSource_Abstract*, Traffic::TrafficDataMetrics::Snapshot> m_lastMetrics;
+    QElapsedTimer m_metricsElapsedTimer;
+    QTimer m_metricsTimer;
+
+    // Re-broadcast of ownship and traffic data to other apps. Enabled only if
+    // GlobalSettings::trafficDataBroadcast is true.
+    Traffic::GDL90Broadcaster m_gdl90Broadcaster;
+
+    // Recent positions of traffic that is reported with position, and the
+    // trails computed from them
+    Traffic::TrackHistory m_trackHistory;
+    QVariantList m_trafficTrails;
+    QTimer m_trailsTimer;
 
     // TrafficData Sources
     QList<QPointer<Traffic::TrafficDataSource_Abstract>> m_dataSources;
     QPointer<Traffic::TrafficDataSource_Abstract> m_currentSource;
 
-    // Property cache
+    // Property cache. The warning is m_receiverWarning, the last warning
+    // reported by the traffic receiver, unless the conflict detector predicts
+    // a conflict with higher alarm level.
     Traffic::Warning m_Warning;
+    Traffic::Warning m_receiverWarning;
     QTimer m_WarningTimer;
     QString m_trafficReceiverRuntimeError;
     QString m_trafficReceiverSelfTestError;
 
     // Reconnect
     QTimer reconnectionTimer;
+    QTimer m_probeTimer;
 
     // Property Cache
     bool m_receivingHeartbeat {false};
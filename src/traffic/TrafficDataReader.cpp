@@ -0,0 +1,318 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <QCoreApplication>
+#include <QNetworkDatagram>
+#include <QTcpSocket>
+#include <QUdpSocket>
+
+#include "traffic/GDL90Broadcaster.h"
+#include "traffic/TrafficDataReader.h"
+#include "traffic/TrafficDataSource_Abstract.h"
+
+
+Traffic::TrafficDataReader::TrafficDataReader(QObject* parent)
+    : QObject(parent)
+{
+}
+
+
+//
+// Methods
+//
+
+QThread* Traffic::TrafficDataReader::ioThread()
+{
+    static QPointer<QThread> theThread;
+    if (theThread.isNull())
+    {
+        theThread = new QThread(QCoreApplication::instance());
+        theThread->setObjectName(u"Traffic I/O"_qs);
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, theThread, []() {
+            theThread->quit();
+            theThread->wait();
+        });
+        theThread->start();
+    }
+    return theThread;
+}
+
+
+void Traffic::TrafficDataReader::notifyConsumer()
+{
+    if (!m_framesAvailablePending.exchange(true))
+    {
+        emit framesAvailable();
+    }
+}
+
+
+void Traffic::TrafficDataReader::processFLARMData(const QByteArray& data)
+{
+    m_FLARMDataBuffer.append(data, [this](const QByteArray& sentence) { processFLARMSentence(sentence); });
+}
+
+
+void Traffic::TrafficDataReader::processFLARMSentence(const QByteArray& sentence)
+{
+    auto message = Traffic::TrafficDataSource_Abstract::getNMEAMessage(QString::fromLatin1(sentence));
+    if (message.isEmpty())
+    {
+        m_metrics->addChecksumError();
+        return;
+    }
+
+    // PFLAU carries the alarm level of the most relevant traffic
+    auto priority = message.startsWith(u"PFLAU");
+    pushFrame({Frame::FLARM, message.toLatin1()}, priority);
+}
+
+
+void Traffic::TrafficDataReader::pushFrame(Traffic::TrafficDataReader::Frame&& frame, bool priority)
+{
+    auto& queue = priority ? m_priorityFrames : m_frames;
+
+    // While a priority frame is kept aside, newer priority frames replace it,
+    // so that they cannot overtake it
+    auto pushed = false;
+    if (!(priority && m_hasLatestPriorityFrame))
+    {
+        pushed = queue.tryPush(std::move(frame));
+        if (!pushed)
+        {
+            notifyConsumer();
+            pushed = queue.tryPush(std::move(frame));
+        }
+    }
+
+    if (!pushed)
+    {
+        if (!priority)
+        {
+            m_metrics->addDroppedFrame();
+            return;
+        }
+
+        // Keep the newest warning, drop the older one that was kept aside
+        QMutexLocker const locker(&m_latestPriorityFrameMutex);
+        if (m_latestPriorityFrame.has_value())
+        {
+            m_metrics->addDroppedFrame();
+        }
+        m_latestPriorityFrame = std::move(frame);
+        m_hasLatestPriorityFrame = true;
+    }
+    if (priority)
+    {
+        notifyConsumer();
+    }
+}
+
+
+void Traffic::TrafficDataReader::resetFramesAvailable()
+{
+    m_framesAvailablePending = false;
+}
+
+
+void Traffic::TrafficDataReader::setMetrics(const std::shared_ptr<Traffic::TrafficDataMetrics>& metrics)
+{
+    m_metrics = metrics;
+}
+
+
+bool Traffic::TrafficDataReader::takeFrame(Traffic::TrafficDataReader::Frame& frame)
+{
+    if (m_priorityFrames.tryPop(frame))
+    {
+        return true;
+    }
+    if (m_hasLatestPriorityFrame)
+    {
+        QMutexLocker const locker(&m_latestPriorityFrameMutex);
+        if (m_latestPriorityFrame.has_value())
+        {
+            frame = std::move(*m_latestPriorityFrame);
+            m_latestPriorityFrame.reset();
+            m_hasLatestPriorityFrame = false;
+            return true;
+        }
+    }
+    return m_frames.tryPop(frame);
+}
+
+
+//
+// Slots
+//
+
+void Traffic::TrafficDataReader::abort()
+{
+    if (!m_socket.isNull())
+    {
+        m_socket->abort();
+    }
+    m_FLARMDataBuffer.clear();
+}
+
+
+void Traffic::TrafficDataReader::bindUdp(quint16 port)
+{
+    auto* socket = new QUdpSocket(this);
+    connect(socket, &QUdpSocket::readyRead, this, &Traffic::TrafficDataReader::onUdpReadyRead);
+    setSocket(socket);
+    socket->bind(port);
+}
+
+
+void Traffic::TrafficDataReader::connectToHost(const QString& hostName, quint16 port)
+{
+    auto* socket = new QTcpSocket(this);
+    connect(socket, &QTcpSocket::readyRead, this, &Traffic::TrafficDataReader::onTcpReadyRead);
+    connect(socket, &QTcpSocket::disconnected, this, &Traffic::TrafficDataReader::disconnected);
+    setSocket(socket);
+    socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+    socket->setSocketOption(QAbstractSocket::KeepAliveOption, 1);
+    socket->connectToHost(hostName, port);
+}
+
+
+void Traffic::TrafficDataReader::onTcpReadyRead()
+{
+    // Paranoid safety checks
+    if (m_socket.isNull())
+    {
+        return;
+    }
+
+    // Split data into lines. The last line might be incomplete, which is fine
+    // because processFLARMData() buffers incomplete sentences.
+    auto const data = m_socket->readAll();
+    m_metrics->addBytesReceived(data.size());
+    auto lines = data.split('\n');
+    foreach(auto line, lines)
+    {
+        if (line.endsWith('\r'))
+        {
+            line.chop(1);
+        }
+        if (line.isEmpty())
+        {
+            continue;
+        }
+
+        // Check if the TCP connection asks for a password
+        if (line.startsWith("PASS?"))
+        {
+            pushFrame({Frame::PasswordRequest, {}}, false);
+            continue;
+        }
+
+        // Process FLARM sentence
+        processFLARMData(line);
+    }
+    notifyConsumer();
+}
+
+
+void Traffic::TrafficDataReader::onUdpReadyRead()
+{
+    auto* socket = qobject_cast<QUdpSocket*>(m_socket);
+    if (socket == nullptr)
+    {
+        return;
+    }
+
+    // Read datagrams
+    while (socket->hasPendingDatagrams())
+    {
+        auto const datagram = socket->receiveDatagram();
+
+        // Skip datagrams that this app has broadcast itself
+        if (Traffic::GDL90Broadcaster::isOwnDatagram(datagram))
+        {
+            continue;
+        }
+        QByteArray const data = datagram.data();
+        m_metrics->addBytesReceived(data.size());
+
+        // Skip the datagram if it has already been received.
+        if (!m_receivedDatagramHashes.insert(qHash(data)))
+        {
+            continue;
+        }
+
+        // Process datagrams, depending on content type
+        if (data.startsWith("XGPS") || data.startsWith("XTRA"))
+        {
+            pushFrame({Frame::XGPS, data}, false);
+            continue;
+        }
+
+        // Split data into raw messages
+        foreach(auto rawMessage, data.split(0x7e))
+        {
+            if (rawMessage.isEmpty())
+            {
+                continue;
+            }
+            auto message = Traffic::TrafficDataSource_Abstract::decodeGDLMessage(rawMessage);
+            if (message.isEmpty())
+            {
+                m_metrics->addChecksumError();
+                continue;
+            }
+
+            // Traffic reports with traffic alert status
+            auto priority = (static_cast<quint8>(message.at(0)) == 20)
+                            && (message.size() > 1)
+                            && ((static_cast<quint8>(message.at(1)) >> 4) == 1);
+            pushFrame({Frame::GDL90, message}, priority);
+        }
+    }
+    notifyConsumer();
+}
+
+
+void Traffic::TrafficDataReader::setSocket(QAbstractSocket* socket)
+{
+    if (!m_socket.isNull())
+    {
+        m_socket->disconnect(this);
+        m_socket->abort();
+        m_socket->deleteLater();
+    }
+    m_FLARMDataBuffer.clear();
+
+    m_socket = socket;
+    connect(m_socket, &QAbstractSocket::errorOccurred, this, &Traffic::TrafficDataReader::errorOccurred);
+    connect(m_socket, &QAbstractSocket::stateChanged, this, &Traffic::TrafficDataReader::stateChanged);
+}
+
+
+void Traffic::TrafficDataReader::write(const QByteArray& data)
+{
+    if (m_socket.isNull())
+    {
+        return;
+    }
+    m_socket->write(data);
+    m_socket->flush();
+}
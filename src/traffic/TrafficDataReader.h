@@ -0,0 +1,244 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QAbstractSocket>
+#include <QMutex>
+#include <QPointer>
+#include <QThread>
+#include <memory>
+#include <optional>
+
+#include "traffic/FLARMDataBuffer.h"
+#include "traffic/RecentHashSet.h"
+#include "traffic/SPSCQueue.h"
+#include "traffic/TrafficDataMetrics.h"
+
+
+namespace Traffic {
+
+/*! \brief Socket reader for traffic data receivers
+ *
+ *  This class owns the network socket of a TrafficDataSource_AbstractSocket.
+ *  It reads incoming data, splits the data into frames, checks NMEA checksums,
+ *  undoes the GDL90 escape encoding and verifies GDL90 CRC checksums. Valid
+ *  frames are handed to the consumer through lock-free single-producer,
+ *  single-consumer queues.  The consumer is notified by the signal
+ *  framesAvailable() and collects the frames using takeFrame().
+ *
+ *  Frames that are relevant for traffic warnings (FLARM PFLAU messages and
+ *  GDL90 traffic reports with the traffic alert flag set) are delivered with
+ *  priority: they use a separate queue that takeFrame() empties first, and the
+ *  consumer is notified immediately, without waiting for the end of the current
+ *  read. If the consumer cannot keep up, the newest priority frame is never
+ *  dropped: it is kept aside and replaces older priority frames that could not
+ *  be queued. Dropped frames are counted in the TrafficDataMetrics.
+ *
+ *  An instance of this class can be moved to the thread returned by
+ *  ioThread().  Since the socket is created in the slots bindUdp() and
+ *  connectToHost(), all slots must then be called via queued connections.  The
+ *  method takeFrame() can be called from any single thread.
+ */
+class TrafficDataReader : public QObject {
+    Q_OBJECT
+
+public:
+    /*! \brief Frame read from the socket */
+    struct Frame
+    {
+        /*! \brief Type of frame */
+        enum Type
+        {
+            FLARM, /*!< FLARM/NMEA message with verified checksum, as returned by TrafficDataSource_Abstract::getNMEAMessage() */
+            GDL90, /*!< GDL90 message with verified checksum, as returned by TrafficDataSource_Abstract::decodeGDLMessage() */
+            PasswordRequest, /*!< Password request by the traffic data receiver, data is empty */
+            XGPS /*!< XGPS/XTRAFFIC string, unprocessed */
+        };
+
+        /*! \brief Type of frame */
+        Type type {FLARM};
+
+        /*! \brief Content of frame */
+        QByteArray data;
+    };
+
+    /*! \brief Standard constructor
+     *
+     *  @param parent The standard QObject parent pointer
+     */
+    explicit TrafficDataReader(QObject* parent = nullptr);
+
+    // Standard destructor
+    ~TrafficDataReader() override = default;
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Dedicated thread for traffic data I/O
+     *
+     *  This method creates a thread on first use, which is shared among all
+     *  instances of this class.  The thread is stopped when the application
+     *  quits.  This method must only be called from the GUI thread.
+     *
+     *  @returns Thread for traffic data I/O
+     */
+    [[nodiscard]] static QThread* ioThread();
+
+    /*! \brief Take one frame from the queues
+     *
+     *  This method must always be called from the same thread. It returns
+     *  priority frames first.  Before collecting frames in response to
+     *  framesAvailable(), the consumer needs to call resetFramesAvailable().
+     *
+     *  @param frame If a frame is available, it is moved here.
+     *
+     *  @returns True if a frame was available
+     */
+    bool takeFrame(Traffic::TrafficDataReader::Frame& frame);
+
+    /*! \brief Re-arm the notification
+     *
+     *  The signal framesAvailable() is emitted only once until this method is
+     *  called.  Consumers call this method before they start collecting frames.
+     */
+    void resetFramesAvailable();
+
+    /*! \brief Set counters
+     *
+     *  The reader counts received bytes and checksum errors in the given
+     *  counters, typically those of the data source that owns the reader. This
+     *  method must be called before the reader is moved to another thread.
+     *
+     *  @param metrics Counters, must not be null
+     */
+    void setMetrics(const std::shared_ptr<Traffic::TrafficDataMetrics>& metrics);
+
+public slots:
+    /*! \brief Abort the current connection
+     *
+     *  This method aborts the socket and discards buffered data.
+     */
+    void abort();
+
+    /*! \brief Bind a new UDP socket to the given port
+     *
+     *  Any existing socket is deleted.
+     *
+     *  @param port Port
+     */
+    void bindUdp(quint16 port);
+
+    /*! \brief Connect a new TCP socket to the given host
+     *
+     *  Any existing socket is deleted.
+     *
+     *  @param hostName Name of the host
+     *
+     *  @param port Port
+     */
+    void connectToHost(const QString& hostName, quint16 port);
+
+    /*! \brief Write data to the socket and flush
+     *
+     *  @param data Data
+     */
+    void write(const QByteArray& data);
+
+signals:
+    /*! \brief Emitted when the TCP socket has been disconnected */
+    void disconnected();
+
+    /*! \brief Forwarded from QAbstractSocket::errorOccurred */
+    void errorOccurred(QAbstractSocket::SocketError socketError);
+
+    /*! \brief Emitted when new frames are available
+     *
+     *  The signal is not emitted again until resetFramesAvailable() has been
+     *  called.
+     */
+    void framesAvailable();
+
+    /*! \brief Forwarded from QAbstractSocket::stateChanged */
+    void stateChanged(QAbstractSocket::SocketState socketState);
+
+private slots:
+    // Read lines from the TCP socket, check FLARM/NMEA sentences and queue
+    // frames
+    void onTcpReadyRead();
+
+    // Read datagrams from the UDP socket, decode GDL90 messages and queue
+    // frames
+    void onUdpReadyRead();
+
+private:
+    Q_DISABLE_COPY_MOVE(TrafficDataReader)
+
+    // Replaces the current socket and connects the signals of the new socket
+    void setSocket(QAbstractSocket* socket);
+
+    // Collects FLARM/NMEA data until a full sentence is found, and queues
+    // frames.
+    void processFLARMData(const QByteArray& data);
+
+    // Checks one FLARM/NMEA sentence and queues a frame if the sentence is
+    // valid
+    void processFLARMSentence(const QByteArray& sentence);
+
+    // Queues a frame. If the queue is full, the consumer is notified and the
+    // frame is queued again.  This will succeed if the consumer lives in the
+    // same thread. Otherwise, an ordinary frame is dropped, while a priority
+    // frame replaces m_latestPriorityFrame.
+    void pushFrame(Traffic::TrafficDataReader::Frame&& frame, bool priority);
+
+    // Emits framesAvailable() unless a notification is already pending
+    void notifyConsumer();
+
+    QPointer<QAbstractSocket> m_socket;
+
+    // Unprocessed FLARM/NMEA data from the TCP socket
+    Traffic::FLARMDataBuffer<QByteArray> m_FLARMDataBuffer;
+
+    // Counters, shared with the data source
+    std::shared_ptr<Traffic::TrafficDataMetrics> m_metrics {std::make_shared<Traffic::TrafficDataMetrics>()};
+
+    // Hashes of the last 512 datagrams. This is used to sort out doubly sent
+    // datagrams.
+    RecentHashSet<512> m_receivedDatagramHashes;
+
+    // Queues for frames. Warnings go to m_priorityFrames.
+    SPSCQueue<Frame, 32> m_priorityFrames;
+    SPSCQueue<Frame, 1024> m_frames;
+
+    // Most recent priority frame that did not fit into m_priorityFrames. It is
+    // newer than all frames in m_priorityFrames and therefore taken after
+    // them. The flag allows takeFrame() to skip the mutex in the common case.
+    QMutex m_latestPriorityFrameMutex;
+    std::optional<Frame> m_latestPriorityFrame;
+    std::atomic<bool> m_hasLatestPriorityFrame {false};
+
+    // True if framesAvailable() has been emitted, and the consumer has not
+    // called resetFramesAvailable() yet
+    std::atomic<bool> m_framesAvailablePending {false};
+};
+
+} // namespace Traffic
@@ -20,13 +20,22 @@
 
 #pragma once
 
+#include <array>
+#include <memory>
+
 #include "positioning/PositionInfo.h"
 #include "traffic/ConnectionInfo.h"
+#include "traffic/FLARMDataBuffer.h"
+#include "traffic/TrafficDataMetrics.h"
 #include "traffic/TrafficFactor_DistanceOnly.h"
 #include "traffic/TrafficFactor_WithPosition.h"
 #include "traffic/Warning.h"
 
 
+/*! \brief Lookup table for the CRC-16 checksum used by GDL90 */
+extern const std::array<quint16, 256> Crc16Table;
+
+
 namespace Traffic {
 
 /*! \brief Base class for all traffic receiver data sources
@@ -224,6 +233,70 @@ public:
         return m_trafficReceiverSelfTestError;
     }
 
+
+    //
+    // Methods
+    //
+
+    /*! \brief Counters for the data received from this source
+     *
+     *  This method is cheap and can be called from any thread.
+     *
+     *  @returns Snapshot of the counters
+     */
+    [[nodiscard]] Traffic::TrafficDataMetrics::Snapshot metrics() const
+    {
+        return m_metrics->snapshot();
+    }
+
+    /*! \brief Check if the traffic receiver predicts conflicts
+     *
+     *  FLARM devices report alarm levels that result from their own collision
+     *  prediction. GDL90 and XGPS traffic reports do not. This method refers to
+     *  the traffic factor that was last emitted by factorWithPosition(), and is
+     *  meant to be called from slots connected to that signal.
+     *
+     *  @returns True if the last traffic factor was reported in FLARM format
+     */
+    [[nodiscard]] bool receiverPredictsConflicts() const
+    {
+        return m_receiverPredictsConflicts;
+    }
+
+
+    //
+    // Static methods
+    //
+
+    /*! \brief Decode one GDL90 message
+     *
+     *  This method expects exactly one GDL90 message, with or without starting
+     *  and trailing 0x7e bytes. It undoes the escape character encoding and
+     *  verifies the CRC checksum.  The method does not depend on any state and
+     *  can safely be called from any thread.
+     *
+     *  @param rawMessage A QByteArray containing a GDL90 message.
+     *
+     *  @returns The message ID, followed by the message data, without the CRC
+     *  checksum.  If the message is invalid, an empty QByteArray is returned.
+     */
+    [[nodiscard]] static QByteArray decodeGDLMessage(const QByteArray& rawMessage);
+
+    /*! \brief Check FLARM/NMEA sentence
+     *
+     *  This method takes an input string and checks if it is a valid NMEA
+     *  sentence, of the form $message*checksum, where 'message' is the message
+     *  and 'checksum' is a valid checksum of the message. The method does not
+     *  depend on any state and can safely be called from any thread.
+     *
+     *  @param input A QString containing a FLARM/NMEA sentence
+     *
+     *  @returns If a valid sentence is detected, the substring 'message' is
+     *  returned. Otherwise, an empty string is returned.
+     */
+    [[nodiscard]] static QString getNMEAMessage(const QString& input);
+
+
 signals:
     /*! \brief Notifier signal */
     void connectivityStatusChanged(QString newStatus);
@@ -363,6 +436,18 @@ public slots:
     }
 
 protected:
+    /*! \brief Counters for the data received from this source
+     *
+     *  The pointer is never null. Subclasses that read data in another object,
+     *  such as TrafficDataReader, share the counters with that object.
+     *
+     *  @returns Counters of this data source
+     */
+    [[nodiscard]] std::shared_ptr<Traffic::TrafficDataMetrics> sharedMetrics() const
+    {
+        return m_metrics;
+    }
+
     /*! \brief Process FLARM/NMEA data
      *
      *  This method handles FLARM/NMEA data. It collects data until a full FLARM/NMEA sentence is found
@@ -372,6 +457,29 @@ protected:
      */
     void processFLARMData(const QString& data);
 
+    /*! \brief Process one FLARM/NMEA message
+     *
+     *  This method expects exactly one FLARM/NMEA message whose checksum has
+     *  already been verified, as returned by getNMEAMessage(). The method
+     *  interprets the message and updates the properties and emits signals as
+     *  appropriate. Invalid messages are silently ignored.
+     *
+     *  @param message A QString containing a FLARM/NMEA message, without
+     *  leading '$' and trailing checksum.
+     */
+    void processFLARMMessage(const QString& message);
+
+    /*! \brief Process one decoded GDL90 message
+     *
+     *  This method expects exactly one GDL90 message, as returned by
+     *  decodeGDLMessage().  The method interprets the message and updates the
+     *  properties and emits signals as appropriate. Invalid messages are
+     *  silently ignored.
+     *
+     *  @param decodedMessage A QByteArray containing a decoded GDL90 message.
+     */
+    void processDecodedGDLMessage(const QByteArray& decodedMessage);
+
     /*! \brief Process one GDL90 message
      *
      *  This method expects exactly one GDL90 message, including starting and
@@ -454,7 +562,10 @@ private:
     void processFLARMMessagePFLAU(const QStringList& arguments); // FLARM Heartbeat
     void processFLARMMessagePFLAV(const QStringList& arguments); // Version information
     void processFLARMMessagePGRMZ(const QStringList& arguments); // Garmin's barometric altitude
-    QString m_FLARMDataBuffer;
+    Traffic::FLARMDataBuffer<QString> m_FLARMDataBuffer;
+
+    // Counters, possibly shared with a TrafficDataReader
+    std::shared_ptr<Traffic::TrafficDataMetrics> m_metrics {std::make_shared<Traffic::TrafficDataMetrics>()};
 
     // Property caches
     bool m_canonical {false};
@@ -485,6 +596,15 @@ private:
     // Targets
     Traffic::TrafficFactor_WithPosition m_factor;
     Traffic::TrafficFactor_DistanceOnly m_factorDistanceOnly;
+
+    // True if the last traffic factor was reported in FLARM format, see
+    // receiverPredictsConflicts()
+    bool m_receiverPredictsConflicts {true};
+
+    // 24-bit address of the own aircraft, as reported in GDL90 ownship
+    // reports, or 0 if unknown. Traffic reports with this address are the
+    // echo of the own transponder and are ignored.
+    quint32 m_ownshipAddress {0};
 };
 
 } // namespace Traffic
@@ -19,6 +19,7 @@
  ***************************************************************************/
 
 #include "GlobalObject.h"
+#include "GlobalSettings.h"
 #include "platform/PlatformAdaptor_Abstract.h"
 #include "traffic/TrafficDataSource_AbstractSocket.h"
 
@@ -33,6 +34,44 @@ Traffic::TrafficDataSource_AbstractSocket::TrafficDataSource_AbstractSocket(bool
 }
 
 
+Traffic::TrafficDataSource_AbstractSocket::~TrafficDataSource_AbstractSocket()
+{
+    destroyReader();
+}
+
+
+void Traffic::TrafficDataSource_AbstractSocket::destroyReader()
+{
+    if (m_reader.isNull())
+    {
+        return;
+    }
+    m_reader->disconnect(this);
+    m_reader->deleteLater();
+    m_reader = nullptr;
+}
+
+
+Traffic::TrafficDataReader* Traffic::TrafficDataSource_AbstractSocket::ensureReader()
+{
+    auto* desiredThread = GlobalObject::globalSettings()->trafficDataThread() ? Traffic::TrafficDataReader::ioThread() : thread();
+    if (!m_reader.isNull() && (m_reader->thread() == desiredThread))
+    {
+        return m_reader;
+    }
+
+    destroyReader();
+    m_reader = new Traffic::TrafficDataReader();
+    m_reader->setMetrics(sharedMetrics());
+    connect(m_reader, &Traffic::TrafficDataReader::disconnected, this, &Traffic::TrafficDataSource_AbstractSocket::processDisconnected);
+    connect(m_reader, &Traffic::TrafficDataReader::errorOccurred, this, &Traffic::TrafficDataSource_AbstractSocket::onErrorOccurred);
+    connect(m_reader, &Traffic::TrafficDataReader::framesAvailable, this, &Traffic::TrafficDataSource_AbstractSocket::onFramesAvailable);
+    connect(m_reader, &Traffic::TrafficDataReader::stateChanged, this, &Traffic::TrafficDataSource_AbstractSocket::onStateChanged);
+    m_reader->moveToThread(desiredThread);
+    return m_reader;
+}
+
+
 void Traffic::TrafficDataSource_AbstractSocket::onErrorOccurred(QAbstractSocket::SocketError socketError)
 {
     switch (socketError) {
@@ -110,6 +149,44 @@ void Traffic::TrafficDataSource_AbstractSocket::onErrorOccurred(QAbstractSocket:
         break;
     }
 
+    processError(socketError);
+}
+
+
+void Traffic::TrafficDataSource_AbstractSocket::onFramesAvailable()
+{
+    // Paranoid safety checks
+    if (m_reader.isNull())
+    {
+        return;
+    }
+
+    // Update connectivity status
+    setConnectivityStatus( tr("Receiving Data.") );
+
+    // Process frames. The reader might be deleted while frames are processed,
+    // for instance if this data source is disconnected because another source
+    // has higher priority.
+    m_reader->resetFramesAvailable();
+    Traffic::TrafficDataReader::Frame frame;
+    while (!m_reader.isNull() && m_reader->takeFrame(frame))
+    {
+        switch(frame.type)
+        {
+        case Traffic::TrafficDataReader::Frame::FLARM:
+            processFLARMMessage(QString::fromLatin1(frame.data));
+            break;
+        case Traffic::TrafficDataReader::Frame::GDL90:
+            processDecodedGDLMessage(frame.data);
+            break;
+        case Traffic::TrafficDataReader::Frame::PasswordRequest:
+            processPasswordRequest();
+            break;
+        case Traffic::TrafficDataReader::Frame::XGPS:
+            processXGPSString(frame.data);
+            break;
+        }
+    }
 }
 
 
@@ -122,6 +199,7 @@ void Traffic::TrafficDataSource_AbstractSocket::onReceivingHeartbeatChanged(bool
 
 void Traffic::TrafficDataSource_AbstractSocket::onStateChanged(QAbstractSocket::SocketState socketState)
 {
+    m_socketState = socketState;
 
     // Compute new status
     switch( socketState ) {
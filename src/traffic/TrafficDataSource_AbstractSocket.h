@@ -21,7 +21,9 @@
 #pragma once
 
 #include <QAbstractSocket>
+#include <QPointer>
 
+#include "traffic/TrafficDataReader.h"
 #include "traffic/TrafficDataSource_Abstract.h"
 
 
@@ -37,6 +39,11 @@ namespace Traffic {
  *  It is assume that most users will connect to their traffic receicers via the
  *  WiFi network.  On Android, this class will therefore acquire/relase a WiFi
  *  whenever traffic receiver heartbeat messages are detected or lost.
+ *
+ *  The socket is owned by a TrafficDataReader. Depending on the setting
+ *  GlobalSettings::trafficDataThread, the reader lives in the thread of this
+ *  instance or in the dedicated thread TrafficDataReader::ioThread(). In
+ *  either case, the frames are interpreted in the thread of this instance.
  */
 
 class TrafficDataSource_AbstractSocket : public TrafficDataSource_Abstract {
@@ -51,6 +58,66 @@ public:
      */
     explicit TrafficDataSource_AbstractSocket(bool isCanonical, QObject* parent);
 
+    // Standard destructor
+    ~TrafficDataSource_AbstractSocket() override;
+
+protected:
+    /*! \brief Delete the reader
+     *
+     *  The reader and its socket are deleted. Frames that have not been
+     *  processed yet are discarded.
+     */
+    void destroyReader();
+
+    /*! \brief Make sure that a reader exists
+     *
+     *  If no reader exists, or if the existing reader does not live in the
+     *  thread selected by GlobalSettings::trafficDataThread, a new reader is
+     *  created and its signals are connected.
+     *
+     *  @returns Pointer to the reader
+     */
+    Traffic::TrafficDataReader* ensureReader();
+
+    /*! \brief Handle disconnection of the reader's TCP socket
+     *
+     *  The default implementation does nothing.
+     */
+    virtual void processDisconnected() {}
+
+    /*! \brief Handle error of the reader's socket
+     *
+     *  This method is called after the error string has been set. The default
+     *  implementation does nothing.
+     *
+     *  @param socketError Error reported by the socket
+     */
+    virtual void processError(QAbstractSocket::SocketError socketError) { Q_UNUSED(socketError) }
+
+    /*! \brief Handle password request by the traffic data receiver
+     *
+     *  The default implementation does nothing.
+     */
+    virtual void processPasswordRequest() {}
+
+    /*! \brief Reader
+     *
+     *  @returns Pointer to the reader, or nullptr if no reader exists
+     */
+    [[nodiscard]] Traffic::TrafficDataReader* reader() const
+    {
+        return m_reader;
+    }
+
+    /*! \brief Socket state
+     *
+     *  @returns Last state reported by the reader's socket
+     */
+    [[nodiscard]] QAbstractSocket::SocketState socketState() const
+    {
+        return m_socketState;
+    }
+
 protected slots:
     // Handle socket errors. This method will call
     // TrafficDataSource_Abstract::setErrorString() with a suitable,
@@ -63,9 +130,17 @@ protected slots:
     void onStateChanged(QAbstractSocket::SocketState socketState);
 
 private slots:
+    // Take all available frames from the reader and process them
+    void onFramesAvailable();
+
     // Acquire or release WiFi lock
     static void onReceivingHeartbeatChanged(bool receivingHB);
 
+private:
+    Q_DISABLE_COPY_MOVE(TrafficDataSource_AbstractSocket)
+
+    QPointer<Traffic::TrafficDataReader> m_reader;
+    QAbstractSocket::SocketState m_socketState {QAbstractSocket::UnconnectedState};
 };
 
 } // namespace Traffic
@@ -49,7 +49,7 @@ QDateTime interpretNMEATime(const QString& timeString)
     auto SS = timeString.mid(4,2);
     auto MS = timeString.mid(6);
     QTime time(HH.toInt(), MM.toInt(), SS.toInt());
-    if (MS.isEmpty()) {
+    if (!MS.isEmpty()) {
         time = time.addMSecs(qRound(MS.toDouble()*1000.0));
     }
     auto dateTime = QDateTime::currentDateTimeUtc();
@@ -57,13 +57,12 @@ QDateTime interpretNMEATime(const QString& timeString)
     return dateTime;
 }
 
-// This method takes an input string and checks if it is a valid NMEA sentence,
-// of the form $message*checksum, where 'message' is the message and 'checksum'
-// is a valid checksum of the message. If a valid sentence is detected, the
-// substring message is returned. If the input string is not a valid NMEA
-// sentence, an empty string is returned.
 
-QString getNMEAMessage(const QString& input)
+//
+// Static member functions
+//
+
+QString Traffic::TrafficDataSource_Abstract::getNMEAMessage(const QString& input)
 {
     // Paranoid safety checks
     if (input.length() < 5)
@@ -105,33 +104,8 @@ QString getNMEAMessage(const QString& input)
 
 void Traffic::TrafficDataSource_Abstract::processFLARMData(const QString& data)
 {
-    m_FLARMDataBuffer += data;
-
-    // Abort if the buffer is small that it cannot possibly contain a single valid NMEA sentence.
-    if (m_FLARMDataBuffer.length() < 5)
-    {
-        return;
-    }
-
-    // Search for the first '$' that is *not* at the beginning of the string. If a '$' is found, interpret
-    // the beginning of the string as a NMEA sentence and shorten the buffer.
-    auto idx = m_FLARMDataBuffer.indexOf('$', 1);
-    while (idx != -1)
-    {
-        auto potentialSentence = m_FLARMDataBuffer.first(idx);
-        m_FLARMDataBuffer = m_FLARMDataBuffer.mid(idx);
-        processFLARMSentence(potentialSentence);
-        idx = m_FLARMDataBuffer.indexOf('$', 1);
-    }
-
-    // m_FLARMDataBuffer is a string that might be a full or incomplete NMEA sentence.
-    // If it is a full sentence, then consume it. Otherwise, ignore it.
-    if (!getNMEAMessage(m_FLARMDataBuffer).isEmpty())
-    {
-        processFLARMSentence(m_FLARMDataBuffer);
-        m_FLARMDataBuffer.clear();
-    }
-
+    m_metrics->addBytesReceived(data.size());
+    m_FLARMDataBuffer.append(data, [this](const QString& sentence) { processFLARMSentence(sentence); });
 }
 
 
@@ -140,8 +114,16 @@ void Traffic::TrafficDataSource_Abstract::processFLARMSentence(const QString& se
     auto message = getNMEAMessage(sentence);
     if (message.isEmpty())
     {
+        m_metrics->addChecksumError();
         return;
     }
+    processFLARMMessage(message);
+}
+
+
+void Traffic::TrafficDataSource_Abstract::processFLARMMessage(const QString& message)
+{
+    Traffic::TrafficDataMetrics::ParseTimer const parseTimer(*m_metrics);
 
     // Split the message into pieces
     auto arguments = message.split(QStringLiteral(","));
@@ -206,6 +188,8 @@ void Traffic::TrafficDataSource_Abstract::processFLARMSentence(const QString& se
         processFLARMMessagePGRMZ(arguments);
         return;
     }
+
+    m_metrics->addUnknownMessage();
 }
 
 
@@ -332,6 +316,11 @@ void Traffic::TrafficDataSource_Abstract::processFLARMMessageGPRMC(const QString
 // Data on other proximate aircraft
 void Traffic::TrafficDataSource_Abstract::processFLARMMessagePFLAA(const QStringList& arguments)
 {
+    if (arguments.length() < 11)
+    {
+        return;
+    }
+
     // Helper variable
     bool ok = false;
 
@@ -458,7 +447,7 @@ void Traffic::TrafficDataSource_Abstract::processFLARMMessagePFLAA(const QString
         }
 
         m_factorDistanceOnly.setAlarmLevel(alarmLevel);
-        m_factorDistanceOnly.setCallSign( GlobalObject::flarmnetDB()->getRegistration(targetID) );
+        m_factorDistanceOnly.setCallSign( GlobalObject::flarmnetDB()->getCachedRegistration(targetID) );
         m_factorDistanceOnly.setCoordinate(Positioning::PositionProvider::lastValidCoordinate());
         m_factorDistanceOnly.setID(targetID);
         m_factorDistanceOnly.setHDist(hDist);
@@ -517,13 +506,14 @@ void Traffic::TrafficDataSource_Abstract::processFLARMMessagePFLAA(const QString
 
     // Construct a traffic object
     m_factor.setAlarmLevel(alarmLevel);
-    m_factor.setCallSign( GlobalObject::flarmnetDB()->getRegistration(targetID) );
+    m_factor.setCallSign( GlobalObject::flarmnetDB()->getCachedRegistration(targetID) );
     m_factor.setHDist(hDist);
     m_factor.setID(targetID);
     m_factor.setPositionInfo( Positioning::PositionInfo(pInfo) );
     m_factor.setType(type);
     m_factor.setVDist(vDist);
     m_factor.startLiveTime();
+    m_receiverPredictsConflicts = true;
     emit factorWithPosition(m_factor);
 }
 
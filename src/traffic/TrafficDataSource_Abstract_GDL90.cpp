@@ -167,9 +167,9 @@ auto pInfoFromOwnshipReport(const QByteArray &decodedData) -> QGeoPositionInfo
 }
 
 
-// Member functions
+// Static member functions
 
-void Traffic::TrafficDataSource_Abstract::processGDLMessage(const QByteArray& rawMessage)
+QByteArray Traffic::TrafficDataSource_Abstract::decodeGDLMessage(const QByteArray& rawMessage)
 {
 
     //
@@ -177,7 +177,7 @@ void Traffic::TrafficDataSource_Abstract::processGDLMessage(const QByteArray& ra
     //
 
     if (rawMessage.size() < 3) {
-        return;
+        return {};
     }
 
 
@@ -189,6 +189,9 @@ void Traffic::TrafficDataSource_Abstract::processGDLMessage(const QByteArray& ra
         message.reserve(rawMessage.size());
         bool isEscaped = false;
         foreach(auto byte, rawMessage) {
+            if (byte == 0x7e) {
+                continue;
+            }
             if (byte == 0x7d) {
                 isEscaped = true;
                 continue;
@@ -201,10 +204,15 @@ void Traffic::TrafficDataSource_Abstract::processGDLMessage(const QByteArray& ra
             message.append(byte);
         }
         if (isEscaped) {
-            return;
+            return {};
         }
     }
 
+    // Message ID and CRC checksum
+    if (message.size() < 3) {
+        return {};
+    }
+
 
     //
     // CRC Checksum verification
@@ -220,21 +228,51 @@ void Traffic::TrafficDataSource_Abstract::processGDLMessage(const QByteArray& ra
         savedCRC += static_cast<quint8>( message.at(message.size()-1) );
         savedCRC = (savedCRC << 8U) + static_cast<quint8>( message.at(message.size()-2) );
         if (crc != savedCRC) {
-            return;
+            return {};
         }
     }
 
-
-    // Extract Message ID, cut off Message ID and checksum from decodedData
-    auto messageID = static_cast<quint8>( message.at(0) );
+    // Cut off checksum
     message.chop(2);
-    message = message.mid(1);
+    return message;
+}
+
+
+// Member functions
+
+void Traffic::TrafficDataSource_Abstract::processGDLMessage(const QByteArray& rawMessage)
+{
+    m_metrics->addBytesReceived(rawMessage.size());
+    auto message = decodeGDLMessage(rawMessage);
+    if (message.isEmpty()) {
+        m_metrics->addChecksumError();
+        return;
+    }
+    processDecodedGDLMessage(message);
+}
+
+
+void Traffic::TrafficDataSource_Abstract::processDecodedGDLMessage(const QByteArray& decodedMessage)
+{
+    if (decodedMessage.isEmpty()) {
+        return;
+    }
+    Traffic::TrafficDataMetrics::ParseTimer const parseTimer(*m_metrics);
+
+    // Extract Message ID, cut off Message ID from decodedData
+    auto messageID = static_cast<quint8>( decodedMessage.at(0) );
+    auto message = decodedMessage.mid(1);
 
 
     //
     // Handle the various message types
     //
 
+    if ((messageID != 0) && (messageID != 10) && (messageID != 11) && (messageID != 20)) {
+        m_metrics->addUnknownMessage();
+        return;
+    }
+
     // Heartbeat message
     if (messageID == 0) {
         if (message.length() < 3) {
@@ -267,6 +305,9 @@ void Traffic::TrafficDataSource_Abstract::processGDLMessage(const QByteArray& ra
             return;
         }
 
+        // Remember address of own aircraft
+        m_ownshipAddress = (static_cast<quint8>(message.at(1)) << 16) + (static_cast<quint8>(message.at(2)) << 8) + static_cast<quint8>(message.at(3));
+
         // Copy true altitude into pInfo, if known
         if (m_trueAltitudeTimer.isActive()) {
             auto coordinate = pInfo.coordinate();
@@ -295,6 +336,10 @@ void Traffic::TrafficDataSource_Abstract::processGDLMessage(const QByteArray& ra
 
     // Ownship geometric altitude
     if (messageID == 11) {
+        if (message.length() < 4) {
+            return;
+        }
+
         // Find geometric alt and apply geoid correction
         auto dd0 = static_cast<quint8>(message.at(0));
         auto dd1 = static_cast<quint8>(message.at(1));
@@ -332,6 +377,11 @@ void Traffic::TrafficDataSource_Abstract::processGDLMessage(const QByteArray& ra
         auto id3 = static_cast<quint8>(message.at(3));
         auto id = QString::number(id0, 16) + QString::number(id1, 16) + QString::number(id2, 16) + QString::number(id3, 16);
 
+        // Ignore the echo of the own transponder
+        if ((m_ownshipAddress != 0) && (static_cast<quint32>((id1 << 16) + (id2 << 8) + id3) == m_ownshipAddress)) {
+            return;
+        }
+
         // Alert
         auto s0 = static_cast<quint8>(message.at(0)) >> 4;
         auto alert = (s0 == 1) ? 1 : 0;
@@ -428,6 +478,7 @@ void Traffic::TrafficDataSource_Abstract::processGDLMessage(const QByteArray& ra
             m_factor.setType(type);
             m_factor.setVDist(vDist);
             m_factor.startLiveTime();
+            m_receiverPredictsConflicts = false;
             emit factorWithPosition(m_factor);
         }
     }
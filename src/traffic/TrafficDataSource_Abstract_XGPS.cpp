@@ -18,9 +18,12 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
+#include <cmath>
+
 #include "GlobalObject.h"
 #include "positioning/PositionProvider.h"
 #include "traffic/TrafficDataSource_Abstract.h"
+#include "traffic/XGPSParser.h"
 
 
 // Member functions
@@ -29,36 +32,31 @@ void Traffic::TrafficDataSource_Abstract::processXGPSString(const QByteArray& da
 {
 
     //
-    // Handle the various message types
+    // Handle the various message types. The messages are parsed in place,
+    // without converting them to QStrings.
     //
 
+    std::string_view const message(data.constData(), data.size());
+    Traffic::TrafficDataMetrics::ParseTimer const parseTimer(*m_metrics);
+
     // Ownship report, serves also as heartbeat message
     if (data.startsWith("XGPS")) {
-        QString const str = QString::fromLatin1(data);
-        QStringList list = str.split(u',');
-        if (list.size() != 6) {
+        using Layout = Traffic::XGPS::OwnshipLayout;
+        Traffic::XGPS::Record<Layout> record;
+        if (!record.parse(message)) {
             return;
         }
 
-        bool ok = false;
-        double const lon = list[1].toDouble(&ok);
-        if (!ok) {
-            return;
-        }
-        double const lat = list[2].toDouble(&ok);
-        if (!ok) {
-            return;
-        }
-        double const alt = list[3].toDouble(&ok);
-        if (!ok) {
-            return;
-        }
-        double const tt = list[4].toDouble(&ok);
-        if (!ok) {
-            return;
-        }
-        double const gs = list[5].toDouble(&ok);
-        if (!ok) {
+        double lon = NAN;
+        double lat = NAN;
+        double alt = NAN;
+        double tt = NAN;
+        double gs = NAN;
+        if (!record.number(Layout::Longitude, lon)
+            || !record.number(Layout::Latitude, lat)
+            || !record.number(Layout::AltitudeInM, alt)
+            || !record.number(Layout::Track, tt)
+            || !record.number(Layout::GroundSpeedInMPS, gs)) {
             return;
         }
 
@@ -78,44 +76,38 @@ void Traffic::TrafficDataSource_Abstract::processXGPSString(const QByteArray& da
 
     // Traffic report
     if (data.startsWith("XTRA")) {
-        QString const str = QString::fromLatin1(data);
-        QStringList list = str.split(u',');
-        if (list.size() != 10) {
+        using Layout = Traffic::XGPS::TrafficLayout;
+        Traffic::XGPS::Record<Layout> record;
+        if (!record.parse(message)) {
             return;
         }
 
-        bool ok = false;
-        QString const targetID = list[1];
-        double const lat = list[2].toDouble(&ok);
-        if (!ok) {
-            return;
-        }
-        double const lon = list[3].toDouble(&ok);
-        if (!ok) {
-            return;
-        }
-        auto alt = Units::Distance::fromFT(list[4].toDouble(&ok));
-        if (!ok) {
-            return;
-        }
-        auto vSpeed = Units::Speed::fromFPM(list[5].toDouble(&ok));
-        if (!ok) {
-            return;
-        }
-        double const tt = list[7].toDouble(&ok);
-        if (!ok) {
-            return;
-        }
-        auto hSpeed = Units::Speed::fromKN(list[8].toDouble(&ok));
-        if (!ok) {
+        double lat = NAN;
+        double lon = NAN;
+        double altInFT = NAN;
+        double vSpeedInFPM = NAN;
+        double tt = NAN;
+        double hSpeedInKN = NAN;
+        if (!record.number(Layout::Latitude, lat)
+            || !record.number(Layout::Longitude, lon)
+            || !record.number(Layout::AltitudeInFT, altInFT)
+            || !record.number(Layout::VerticalSpeedInFPM, vSpeedInFPM)
+            || !record.number(Layout::Track, tt)
+            || !record.number(Layout::GroundSpeedInKN, hSpeedInKN)) {
             return;
         }
-        auto callsign = list[9].simplified();
+        auto alt = Units::Distance::fromFT(altInFT);
+        auto vSpeed = Units::Speed::fromFPM(vSpeedInFPM);
+        auto hSpeed = Units::Speed::fromKN(hSpeedInKN);
 
         auto trafficCoordinate = QGeoCoordinate(lat, lon, alt.toM());
         if (!trafficCoordinate.isValid()) {
             return;
         }
+        auto const targetIDField = record.field(Layout::ID);
+        auto const callsignField = record.field(Layout::CallSign);
+        QString const targetID = QString::fromLatin1(targetIDField.data(), static_cast<qsizetype>(targetIDField.size()));
+        auto callsign = QString::fromLatin1(callsignField.data(), static_cast<qsizetype>(callsignField.size())).simplified();
         QGeoPositionInfo geoPositionInfo(trafficCoordinate, QDateTime::currentDateTimeUtc());
         geoPositionInfo.setAttribute(QGeoPositionInfo::VerticalSpeed, vSpeed.toMPS());
         geoPositionInfo.setAttribute(QGeoPositionInfo::Direction, tt);
@@ -145,8 +137,10 @@ void Traffic::TrafficDataSource_Abstract::processXGPSString(const QByteArray& da
         m_factor.setType(Traffic::TrafficFactor_Abstract::unknown);
         m_factor.setVDist(vDist);
         m_factor.startLiveTime();
+        m_receiverPredictsConflicts = false;
         emit factorWithPosition(m_factor);
         return;
     }
 
+    m_metrics->addUnknownMessage();
 }
@@ -28,20 +28,18 @@ Traffic::TrafficDataSource_Tcp::TrafficDataSource_Tcp(bool isCanonical, QString
     Traffic::TrafficDataSource_AbstractSocket(isCanonical, parent),
     m_hostName(std::move(hostName)), m_port(port)
 {
-    // Connect socket
-    connect(&m_socket, &QTcpSocket::errorOccurred, this, &Traffic::TrafficDataSource_Tcp::onErrorOccurred);
-    connect(&m_socket, &QTcpSocket::readyRead, this, &Traffic::TrafficDataSource_Tcp::onReadyRead);
-    connect(&m_socket, &QTcpSocket::stateChanged, this, &Traffic::TrafficDataSource_Tcp::onStateChanged);
-    connect(&m_socket, &QAbstractSocket::disconnected, this, &Traffic::TrafficDataSource_Tcp::connectToTrafficReceiver, Qt::ConnectionType::QueuedConnection);
-
-    // Set up text stream
-    m_textStream.setDevice(&m_socket);
-    m_textStream.setEncoding(QStringConverter::Latin1);
-
     //
     // Initialize properties
     //
-    onStateChanged(m_socket.state());
+    onStateChanged(QAbstractSocket::UnconnectedState);
+
+    // Connection attempts and retries
+    m_connectTimeoutTimer.setSingleShot(true);
+    m_connectTimeoutTimer.setInterval(connectTimeout);
+    connect(&m_connectTimeoutTimer, &QTimer::timeout, this, &Traffic::TrafficDataSource_Tcp::onConnectTimeout);
+    m_retryTimer.setSingleShot(true);
+    connect(&m_retryTimer, &QTimer::timeout, this, &Traffic::TrafficDataSource_Tcp::startConnectionAttempt);
+    connect(this, &Traffic::TrafficDataSource_Abstract::receivingHeartbeatChanged, this, &Traffic::TrafficDataSource_Tcp::onHeartbeatChanged);
 }
 
 Traffic::TrafficDataSource_Tcp::~TrafficDataSource_Tcp()
@@ -59,19 +57,9 @@ void Traffic::TrafficDataSource_Tcp::connectToTrafficReceiver()
         return;
     }
 
-    // Reset password lifecycle
-    resetPasswordLifecycle();
-
-    // Start new connection
-    m_socket.abort();
-    setErrorString();
-    m_socket.setSocketOption(QAbstractSocket::LowDelayOption, 1);
-    m_socket.setSocketOption(QAbstractSocket::KeepAliveOption, 1);
-    m_socket.connectToHost(m_hostName, m_port);
-    m_textStream.setDevice(&m_socket);
-
-    // Update properties
-    onStateChanged(m_socket.state());
+    // An explicit request starts a new series of connection attempts
+    m_retryInterval = minRetryInterval;
+    startConnectionAttempt();
 }
 
 void Traffic::TrafficDataSource_Tcp::disconnectFromTrafficReceiver()
@@ -80,37 +68,79 @@ void Traffic::TrafficDataSource_Tcp::disconnectFromTrafficReceiver()
     // Reset password lifecycle
     resetPasswordLifecycle();
 
+    // Stop connection attempts
+    m_retryEnabled = false;
+    m_connectTimeoutTimer.stop();
+    m_retryTimer.stop();
+
     // Disconnect socket.
-    m_socket.abort();
+    if (reader() != nullptr)
+    {
+        QMetaObject::invokeMethod(reader(), "abort");
+    }
 
     // Update properties
-    onStateChanged(m_socket.state());
+    onStateChanged(QAbstractSocket::UnconnectedState);
 
 }
 
-void Traffic::TrafficDataSource_Tcp::onReadyRead()
+void Traffic::TrafficDataSource_Tcp::onConnectTimeout()
 {
+    if (socketState() == QAbstractSocket::ConnectedState)
+    {
+        return;
+    }
+    if (reader() != nullptr)
+    {
+        QMetaObject::invokeMethod(reader(), "abort");
+    }
+    onStateChanged(QAbstractSocket::UnconnectedState);
+    setErrorString( tr("The connection attempt timed out.") );
+    scheduleRetry();
+}
 
-    QString sentence;
-    while( m_textStream.readLineInto(&sentence) ) {
+void Traffic::TrafficDataSource_Tcp::onHeartbeatChanged(bool newHeartbeat)
+{
+    if (newHeartbeat)
+    {
+        m_retryInterval = minRetryInterval;
+    }
+}
 
-        // Check if the TCP connection asks for a password
-        if (sentence.startsWith(u"PASS?"_qs)) {
-            passwordRequest_Status = waitingForPassword;
-            passwordRequest_SSID = GlobalObject::platformAdaptor()->currentSSID();
-            auto* passwordDB = GlobalObject::passwordDB();
-            if (passwordDB->contains(passwordRequest_SSID)) {
-                setPassword(passwordRequest_SSID, passwordDB->getPassword(passwordRequest_SSID));
-            } else {
-                emit passwordRequest(passwordRequest_SSID);
-            }
-            continue;
-        }
+void Traffic::TrafficDataSource_Tcp::processDisconnected()
+{
+    // The traffic data receiver has rejected the password
+    if (passwordRequest_Status == waitingForDevice)
+    {
+        updatePasswordStatusOnDisconnected();
+        return;
+    }
+
+    // Reconnect
+    scheduleRetry();
+}
+
+void Traffic::TrafficDataSource_Tcp::processError(QAbstractSocket::SocketError socketError)
+{
+    Q_UNUSED(socketError)
 
-        // Process FLARM sentence
-        processFLARMData(sentence);
+    if (!receivingHeartbeat())
+    {
+        m_connectTimeoutTimer.stop();
+        scheduleRetry();
     }
+}
 
+void Traffic::TrafficDataSource_Tcp::processPasswordRequest()
+{
+    passwordRequest_Status = waitingForPassword;
+    passwordRequest_SSID = GlobalObject::platformAdaptor()->currentSSID();
+    auto* passwordDB = GlobalObject::passwordDB();
+    if (passwordDB->contains(passwordRequest_SSID)) {
+        setPassword(passwordRequest_SSID, passwordDB->getPassword(passwordRequest_SSID));
+    } else {
+        emit passwordRequest(passwordRequest_SSID);
+    }
 }
 
 void Traffic::TrafficDataSource_Tcp::resetPasswordLifecycle()
@@ -120,7 +150,6 @@ void Traffic::TrafficDataSource_Tcp::resetPasswordLifecycle()
     passwordRequest_password = QString();
 
     disconnect(this, &Traffic::TrafficDataSource_Abstract::receivingHeartbeatChanged, this, &Traffic::TrafficDataSource_Tcp::updatePasswordStatusOnHeartbeatChange);
-    disconnect(&m_socket, &QTcpSocket::disconnected, this, &Traffic::TrafficDataSource_Tcp::updatePasswordStatusOnDisconnected);
 
 }
 
@@ -152,13 +181,24 @@ void Traffic::TrafficDataSource_Tcp::setPassword(const QString& SSID, const QStr
     QTimer::singleShot(0, this, &Traffic::TrafficDataSource_Tcp::sendPassword_internal);
 }
 
+void Traffic::TrafficDataSource_Tcp::scheduleRetry()
+{
+    if (!m_retryEnabled || m_retryTimer.isActive())
+    {
+        return;
+    }
+    m_retryTimer.start(m_retryInterval);
+    m_retryInterval = qMin(2*m_retryInterval, std::chrono::milliseconds(maxRetryInterval));
+}
+
 void Traffic::TrafficDataSource_Tcp::sendPassword_internal()
 {
 
     // Make sure that this instance is in the state that we think it is
     // Otherwise, abort.
     if ((passwordRequest_Status != waitingForPassword)
-        || (m_socket.state() != QAbstractSocket::ConnectedState)
+        || (reader() == nullptr)
+        || (socketState() != QAbstractSocket::ConnectedState)
         || receivingHeartbeat()) {
         resetPasswordLifecycle();
         return;
@@ -166,14 +206,32 @@ void Traffic::TrafficDataSource_Tcp::sendPassword_internal()
 
     // Connect signals
     connect(this, &Traffic::TrafficDataSource_Abstract::receivingHeartbeatChanged, this, &Traffic::TrafficDataSource_Tcp::updatePasswordStatusOnHeartbeatChange);
-    connect(&m_socket, &QTcpSocket::disconnected, this, &Traffic::TrafficDataSource_Tcp::updatePasswordStatusOnDisconnected);
 
-    m_textStream << passwordRequest_password+"\n";
-    m_textStream.flush();
+    QMetaObject::invokeMethod(reader(), "write", Q_ARG(QByteArray, QString(passwordRequest_password+"\n").toLatin1()));
     passwordRequest_Status = waitingForDevice;
 
 }
 
+void Traffic::TrafficDataSource_Tcp::startConnectionAttempt()
+{
+    // Do not do anything if the traffic receiver is connected and is receiving.
+    if (receivingHeartbeat())
+    {
+        return;
+    }
+
+    // Reset password lifecycle
+    resetPasswordLifecycle();
+
+    // Start new connection. The reader might live in a different thread, so
+    // the socket state will be reported asynchronously via onStateChanged().
+    setErrorString();
+    m_retryEnabled = true;
+    m_retryTimer.stop();
+    m_connectTimeoutTimer.start();
+    QMetaObject::invokeMethod(ensureReader(), "connectToHost", Q_ARG(QString, m_hostName), Q_ARG(quint16, m_port));
+}
+
 void Traffic::TrafficDataSource_Tcp::updatePasswordStatusOnDisconnected()
 {
     if (passwordRequest_Status != waitingForDevice) {
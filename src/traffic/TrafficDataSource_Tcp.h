@@ -20,8 +20,7 @@
 
 #pragma once
 
-#include <QPointer>
-#include <QTcpSocket>
+#include <QTimer>
 
 #include "traffic/TrafficDataSource_AbstractSocket.h"
 
@@ -37,6 +36,13 @@ namespace Traffic {
  *  In most use cases, the connection will be established via the device's WiFi
  *  interface.  The class will therefore try to lock the WiFi once a heartbeat
  *  has been detected, and release the WiFi at the appropriate time.
+ *
+ *  Connection attempts that do not succeed within connectTimeout are aborted.
+ *  Failed attempts are retried with exponential backoff, starting at
+ *  minRetryInterval and growing up to maxRetryInterval, until
+ *  disconnectFromTrafficReceiver() is called. This way, a receiver is found
+ *  quickly when its WiFi network comes up, without waiting for the next
+ *  explicit call to connectToTrafficReceiver().
  */
 
 class TrafficDataSource_Tcp : public TrafficDataSource_AbstractSocket {
@@ -129,6 +135,26 @@ public:
         return m_port;
     }
 
+
+
+    //
+    // Constants
+    //
+
+    /*! \brief Time after which a connection attempt is aborted */
+    static constexpr auto connectTimeout = 3s;
+
+    /*! \brief Delay before the first retry of a failed connection attempt */
+    static constexpr auto minRetryInterval = 1s;
+
+    /*! \brief Maximal delay between retries of failed connection attempts
+     *
+     *  This equals the interval at which TrafficDataProvider reconnects all
+     *  data sources, so that a receiver that is out of range is not polled
+     *  more often than before.
+     */
+    static constexpr auto maxRetryInterval = 5min;
+
 public slots:
     /*! \brief Start attempt to connect to traffic receiver
      *
@@ -151,10 +177,34 @@ public slots:
      */
     void setPassword(const QString& SSID, const QString& password) override;
 
+protected:
+    // Schedules a reconnect and, if the instance is waiting for the traffic
+    // data receiver to accept a password, calls
+    // updatePasswordStatusOnDisconnected()
+    void processDisconnected() override;
+
+    // Schedules a retry, unless the traffic data receiver is delivering data
+    void processError(QAbstractSocket::SocketError socketError) override;
+
+    // Starts the password lifecycle. If a password for the current SSID is
+    // found in the database, that password is sent. Otherwise, the signal
+    // passwordRequest is emitted.
+    void processPasswordRequest() override;
+
 private slots:
-    // Read lines from the socket's text stream and passes the string on to
-    // processFLARMMessage.
-    void onReadyRead();
+    // Aborts the connection attempt if the socket is not connected yet, and
+    // schedules a retry
+    void onConnectTimeout();
+
+    // Resets the retry interval once data is received
+    void onHeartbeatChanged(bool newHeartbeat);
+
+    // Schedules a retry after the current retry interval, and doubles the
+    // interval
+    void scheduleRetry();
+
+    // Starts a connection attempt, without resetting the retry interval
+    void startConnectionAttempt();
 
     // This method does the actual job of sending the password to the traffic
     // data receiver
@@ -162,16 +212,15 @@ private slots:
     // It checks if the instance is actually waiting for a password and returns
     // if it is not.
     //
-    // It connects the slots updatePasswordStatusOnHeartbeatChange that will
-    // respond to heartbeat (=password accepted) and
-    // updatePasswordStatusOnDisconnected (=password rejected). It will send the
-    // password and set passwordRequest_Status to "waitingForDevice"
+    // It connects the slot updatePasswordStatusOnHeartbeatChange that will
+    // respond to heartbeat (=password accepted). It will send the password and
+    // set passwordRequest_Status to "waitingForDevice". Disconnection
+    // (=password rejected) is handled in processDisconnected().
     void sendPassword_internal();
 
     // This method set passwordRequest_Status to "idle", resets
     // passwordRequest_SSID and passwordRequest_password, and disconnects the
-    // slots updatePasswordStatusOnHeartbeatChange and
-    // updatePasswordStatusOnDisconnected);
+    // slot updatePasswordStatusOnHeartbeatChange.
     void resetPasswordLifecycle();
 
     // This slot is called when the password has been rejected by the traffic
@@ -187,17 +236,23 @@ private slots:
 private:
     Q_DISABLE_COPY_MOVE(TrafficDataSource_Tcp)
 
-    QTcpSocket m_socket;
-    QTextStream m_textStream;
     QString m_hostName;
     quint16 m_port;
 
+    // Connection attempts and retries. Retries are only scheduled while
+    // m_retryEnabled is true, that is, between connectToTrafficReceiver() and
+    // disconnectFromTrafficReceiver().
+    QTimer m_connectTimeoutTimer;
+    QTimer m_retryTimer;
+    std::chrono::milliseconds m_retryInterval {minRetryInterval};
+    bool m_retryEnabled {false};
+
 
     /* Password lifecycle
      *
-     * - The method onReadyRead detects that the device requests password. It
-     *   will store the current SSID in passwordRequest_SSID and set
-     *   passwordRequest_Status to waitingForPassword.
+     * - The method processPasswordRequest is called when the device requests a
+     *   password. It will store the current SSID in passwordRequest_SSID and
+     *   set passwordRequest_Status to waitingForPassword.
      *
      * - If a password for the SSID is found in the database, the method
      *   sendPassword is called with that password.  Otherwise, the signal
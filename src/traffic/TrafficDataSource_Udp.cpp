@@ -18,8 +18,6 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
-#include <QNetworkDatagram>
-
 #include "traffic/TrafficDataSource_Udp.h"
 
 
@@ -52,80 +50,17 @@ void Traffic::TrafficDataSource_Udp::connectToTrafficReceiver()
         return;
     }
 
-    // Paranoid safety checks
-    if (!m_socket.isNull())
-    {
-        delete m_socket;
-    }
-
-    // Create socket
-    m_socket = new QUdpSocket(this);
-    connect(m_socket, &QUdpSocket::errorOccurred, this, &Traffic::TrafficDataSource_Udp::onErrorOccurred);
-    connect(m_socket, &QUdpSocket::readyRead, this, &Traffic::TrafficDataSource_Udp::onReadyRead);
-    connect(m_socket, &QUdpSocket::stateChanged, this, &Traffic::TrafficDataSource_Udp::onStateChanged);
-    m_socket->bind(m_port);
-
-    // Update properties
+    // Bind a new socket. The reader might live in a different thread, so the
+    // socket state will be reported asynchronously via onStateChanged().
     setErrorString();
-    onStateChanged(m_socket->state());
+    QMetaObject::invokeMethod(ensureReader(), "bindUdp", Q_ARG(quint16, m_port));
 }
 
 void Traffic::TrafficDataSource_Udp::disconnectFromTrafficReceiver()
 {
     // Disconnect socket.
-    if (!m_socket.isNull())
-    {
-        m_socket->abort();
-    }
-    delete m_socket;
+    destroyReader();
 
     // Update properties
     onStateChanged(QAbstractSocket::UnconnectedState);
 }
-
-void Traffic::TrafficDataSource_Udp::onReadyRead()
-{
-    // Paranoid safety checks
-    if (m_socket.isNull())
-    {
-        return;
-    }
-
-    // Update connectivity status
-    setConnectivityStatus( tr("Receiving Data.") );
-
-    // Read datagrams
-    while (m_socket->hasPendingDatagrams())
-    {
-        QByteArray const data = m_socket->receiveDatagram().data();
-
-        // Return immediately if the datagram has already been received.
-        auto currentDatagramHash = qHash(data);
-        foreach(auto hash, receivedDatagramHashes)
-        {
-            if (hash == currentDatagramHash)
-            {
-                return;
-            }
-        }
-        receivedDatagramHashes[nextHashIndex] = currentDatagramHash;
-        nextHashIndex = (nextHashIndex+1) % receivedDatagramHashes.size();
-
-        // Process datagrams, depending on content type
-        if (data.startsWith("XGPS") || data.startsWith("XTRA"))
-        {
-            processXGPSString(data);
-        }
-        else
-        {
-            // Split data into raw messages
-            foreach(auto rawMessage, data.split(0x7e))
-            {
-                if (!rawMessage.isEmpty())
-                {
-                    processGDLMessage(rawMessage);
-                }
-            }
-        }
-    }
-}
@@ -20,10 +20,6 @@
 
 #pragma once
 
-
-#include <QPointer>
-#include <QUdpSocket>
-
 #include "traffic/TrafficDataSource_AbstractSocket.h"
 
 
@@ -130,23 +126,11 @@ public slots:
      */
     void disconnectFromTrafficReceiver() override;
 
-private slots:
-    // Read messages from the socket datagrams and passes the messages on to
-    // processGDLMessage
-    void onReadyRead();
-
 private:
     Q_DISABLE_COPY_MOVE(TrafficDataSource_Udp)
 
-    QPointer<QUdpSocket> m_socket;
     quint16 m_port;
 
-    // We use this vector to store the last 512 datatgram hashes in a circular
-    // array. This is used to sort out doubly sent datagrams. The nextHashIndex
-    // points to the next vector entry that will be re-written.
-    QVector<uint> receivedDatagramHashes {512, 0};
-    qsizetype nextHashIndex {0};
-
     // GPS altitude of owncraft
     Units::Distance m_trueAltitude;
     Units::Distance m_trueAltitude_FOM;
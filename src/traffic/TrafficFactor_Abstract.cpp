@@ -58,28 +58,35 @@ void Traffic::TrafficFactor_Abstract::dispatchUpdateValid()
 
 
 auto Traffic::TrafficFactor_Abstract::hasHigherPriorityThan(const TrafficFactor_Abstract& rhs) const -> bool
+{
+    return hasHigherPriority(valid(), alarmLevel(), hDist(), rhs.valid(), rhs.alarmLevel(), rhs.hDist());
+}
+
+
+auto Traffic::TrafficFactor_Abstract::hasHigherPriority(bool valid, int alarmLevel, Units::Distance hDist,
+                                                        bool rhsValid, int rhsAlarmLevel, Units::Distance rhsHDist) -> bool
 {
 
     // Criterion 1: Valid instances have higher priority than invalid ones
-    if (!rhs.valid()) {
+    if (!rhsValid) {
         return true;
     }
-    if (!valid()) {
+    if (!valid) {
         return false;
     }
     // At this point, both instances are valid.
 
     // Criterion 2: Alarm level
-    if (alarmLevel() > rhs.alarmLevel()) {
+    if (alarmLevel > rhsAlarmLevel) {
         return true;
     }
-    if (alarmLevel() < rhs.alarmLevel()) {
+    if (alarmLevel < rhsAlarmLevel) {
         return false;
     }
     // At this point, both instances have equal alarm levels
 
     // Final criterion: distance to current position
-    return (hDist() < rhs.hDist());
+    return (hDist < rhsHDist);
 
 }
 
@@ -119,6 +119,28 @@ public:
      */
     [[nodiscard]] auto hasHigherPriorityThan(const TrafficFactor_Abstract& rhs) const -> bool;
 
+    /*! \brief Estimates if traffic has higher priority than other traffic
+     *
+     * This method applies the criteria of hasHigherPriorityThan() to traffic
+     * data that is not stored in a traffic object.
+     *
+     * @param valid Validity of the left hand side
+     *
+     * @param alarmLevel Alarm level of the left hand side
+     *
+     * @param hDist Horizontal distance of the left hand side
+     *
+     * @param rhsValid Validity of the right hand side
+     *
+     * @param rhsAlarmLevel Alarm level of the right hand side
+     *
+     * @param rhsHDist Horizontal distance of the right hand side
+     *
+     * @returns Boolean with the result
+     */
+    [[nodiscard]] static auto hasHigherPriority(bool valid, int alarmLevel, Units::Distance hDist,
+                                                bool rhsValid, int rhsAlarmLevel, Units::Distance rhsHDist) -> bool;
+
     /*! \brief Starts or extends the lifetime of this object
      *
      *  Traffic information is valantile, and is considered valid only
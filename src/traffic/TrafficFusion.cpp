@@ -0,0 +1,159 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <QDateTime>
+
+#include "traffic/TrafficFusion.h"
+
+
+//
+// Methods
+//
+
+void Traffic::TrafficFusion::clear()
+{
+    m_tracks.clear();
+    m_aliases.clear();
+}
+
+
+QString Traffic::TrafficFusion::correlate(const QString& ID, const Positioning::PositionInfo& positionInfo, Units::Distance vDist, int sourceRank)
+{
+    auto const now = QDateTime::currentMSecsSinceEpoch();
+    auto const coordinate = positionInfo.coordinate();
+    auto const normalized = normalizedID(ID);
+
+    // Find track, first by ID, then by position
+    auto key = m_aliases.value(normalized);
+    if (key.isEmpty() && coordinate.isValid())
+    {
+        key = gate(coordinate, vDist, sourceRank);
+        if (!key.isEmpty())
+        {
+            m_aliases.insert(normalized, key);
+            m_tracks[key].IDs << normalized;
+        }
+    }
+
+    // Create new track if necessary. If the table is full, the track that has
+    // not been reported for the longest time is removed.
+    if (key.isEmpty())
+    {
+        if (m_tracks.size() >= maxTracks)
+        {
+            QString oldestKey;
+            qint64 oldest = now;
+            for(auto it = m_tracks.cbegin(); it != m_tracks.cend(); it++)
+            {
+                if (it.value().lastSeenInMS <= oldest)
+                {
+                    oldest = it.value().lastSeenInMS;
+                    oldestKey = it.key();
+                }
+            }
+            removeTrack(oldestKey);
+        }
+        key = normalized;
+        m_aliases.insert(normalized, key);
+        m_tracks[key].IDs << normalized;
+    }
+
+    // Update track
+    auto& track = m_tracks[key];
+    track.coordinate = coordinate;
+    track.vDist = vDist;
+    track.lastSeenInMS = now;
+    track.lastSeenBySource.insert(sourceRank, now);
+
+    // Drop the report if a preferred source has reported the track recently
+    for(auto it = track.lastSeenBySource.cbegin(); it != track.lastSeenBySource.cend(); it++)
+    {
+        if ((it.key() < sourceRank) && (now - it.value() <= freshnessInMS))
+        {
+            return {};
+        }
+    }
+    return key;
+}
+
+
+void Traffic::TrafficFusion::expire()
+{
+    auto const now = QDateTime::currentMSecsSinceEpoch();
+    QStringList expiredKeys;
+    for(auto it = m_tracks.cbegin(); it != m_tracks.cend(); it++)
+    {
+        if (now - it.value().lastSeenInMS > trackLifetimeInMS)
+        {
+            expiredKeys << it.key();
+        }
+    }
+    foreach(auto key, expiredKeys)
+    {
+        removeTrack(key);
+    }
+}
+
+
+QString Traffic::TrafficFusion::gate(const QGeoCoordinate& coordinate, Units::Distance vDist, int sourceRank) const
+{
+    QString result;
+    auto bestDistance = horizontalGate.toM();
+    for(auto it = m_tracks.cbegin(); it != m_tracks.cend(); it++)
+    {
+        const auto& track = it.value();
+        if (track.lastSeenBySource.contains(sourceRank) || !track.coordinate.isValid())
+        {
+            continue;
+        }
+        if (vDist.isFinite() && track.vDist.isFinite() && (qAbs((vDist-track.vDist).toM()) > verticalGate.toM()))
+        {
+            continue;
+        }
+        auto const distance = coordinate.distanceTo(track.coordinate);
+        if (distance < bestDistance)
+        {
+            bestDistance = distance;
+            result = it.key();
+        }
+    }
+    return result;
+}
+
+
+QString Traffic::TrafficFusion::normalizedID(const QString& ID)
+{
+    auto result = ID.toLower();
+    if (result.length() == 7)
+    {
+        return result.right(6);
+    }
+    return result;
+}
+
+
+void Traffic::TrafficFusion::removeTrack(const QString& key)
+{
+    auto track = m_tracks.take(key);
+    foreach(auto ID, track.IDs)
+    {
+        m_aliases.remove(ID);
+    }
+}
@@ -0,0 +1,157 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QGeoCoordinate>
+#include <QHash>
+#include <QStringList>
+
+#include "positioning/PositionInfo.h"
+#include "units/Distance.h"
+
+
+namespace Traffic {
+
+/*! \brief Correlation of traffic reported by several data sources
+ *
+ *  If several traffic data sources are used at the same time (for instance, a
+ *  FLARM device and an ADS-B receiver), the same aircraft is typically reported
+ *  by more than one source, possibly under different IDs.  This class
+ *  maintains a table of tracks and files every report under a track key.
+ *
+ *  - Reports are first correlated by ID. IDs are normalized, so that the
+ *    24-bit addresses used by FLARM and GDL90 match. The track keys returned
+ *    by correlate() are normalized IDs. They identify tracks, but callers
+ *    should keep showing the IDs reported by the sources.
+ *
+ *  - Reports whose ID is unknown are correlated by spatial gating with tracks
+ *    that the reporting source has not reported yet.
+ *
+ *  - For every track, the class records when each source has last reported
+ *    the track. Reports from a source are dropped as long as a preferred
+ *    source reports the same track with fresh data.
+ *
+ *  The number of tracks is limited to maxTracks, so that the cost per report
+ *  is bounded.
+ */
+
+class TrafficFusion
+{
+public:
+    /*! \brief Standard constructor */
+    TrafficFusion() = default;
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Remove all tracks */
+    void clear();
+
+    /*! \brief Correlate a report with the track table
+     *
+     *  @param ID ID of the traffic, as reported by the source
+     *
+     *  @param positionInfo Position of the traffic
+     *
+     *  @param vDist Vertical distance from own aircraft to traffic, might be
+     *  NaN
+     *
+     *  @param sourceRank Preference of the source. Lower numbers denote
+     *  preferred sources.
+     *
+     *  @returns Track key under which the report should be filed, or an empty
+     *  string if the report should be dropped because a preferred source
+     *  reports the same traffic.
+     */
+    QString correlate(const QString& ID, const Positioning::PositionInfo& positionInfo, Units::Distance vDist, int sourceRank);
+
+    /*! \brief Remove tracks that have not been reported for trackLifetimeInMS */
+    void expire();
+
+    /*! \brief Normalize ID
+     *
+     *  FLARM reports 24-bit addresses as six hex digits, GDL90 prepends the
+     *  address type.  This method returns the 24-bit address part of the ID,
+     *  in lower case, so that IDs from both protocols can be compared.  GDL90
+     *  IDs print the bytes of the address without leading zeros, so that
+     *  only seven-digit GDL90 IDs can be matched.  Other IDs are returned
+     *  unchanged, in lower case; these are correlated by position.
+     *
+     *  Normalized IDs are used only internally, to find tracks.  They are not
+     *  meant to be shown to the user or to look up registrations.
+     *
+     *  @param ID ID as reported by a data source
+     *
+     *  @returns Normalized ID
+     */
+    [[nodiscard]] static QString normalizedID(const QString& ID);
+
+
+    //
+    // Constants
+    //
+
+    /*! \brief Maximal number of tracks */
+    static constexpr qsizetype maxTracks = 256;
+
+    /*! \brief Period after which reports of a source are considered stale */
+    static constexpr qint64 freshnessInMS = 3000;
+
+    /*! \brief Period after which a track without reports is removed */
+    static constexpr qint64 trackLifetimeInMS = 10000;
+
+    /*! \brief Horizontal gate for spatial correlation */
+    static constexpr Units::Distance horizontalGate = Units::Distance::fromM(200.0);
+
+    /*! \brief Vertical gate for spatial correlation */
+    static constexpr Units::Distance verticalGate = Units::Distance::fromM(100.0);
+
+private:
+    struct Track
+    {
+        QGeoCoordinate coordinate;
+        Units::Distance vDist;
+        qint64 lastSeenInMS {0};
+
+        // Time of last report, by source rank
+        QHash<int, qint64> lastSeenBySource;
+
+        // Normalized IDs under which the track has been reported
+        QStringList IDs;
+    };
+
+    // Returns the key of the track that best matches the position, or an empty
+    // string. Only tracks not reported by the given source are considered.
+    [[nodiscard]] QString gate(const QGeoCoordinate& coordinate, Units::Distance vDist, int sourceRank) const;
+
+    // Removes a track and its aliases
+    void removeTrack(const QString& key);
+
+    // Tracks, by track key
+    QHash<QString, Track> m_tracks;
+
+    // Track keys, by normalized ID
+    QHash<QString, QString> m_aliases;
+};
+
+} // namespace Traffic
@@ -0,0 +1,179 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "traffic/TrafficObjectModel.h"
+
+
+Traffic::TrafficObjectModel::TrafficObjectModel(const QList<Traffic::TrafficFactor_WithPosition*>& trafficObjects, QObject* parent)
+    : QAbstractListModel(parent)
+{
+    m_frameTimer.setInterval(frameInterval);
+    m_frameTimer.setSingleShot(true);
+    connect(&m_frameTimer, &QTimer::timeout, this, &Traffic::TrafficObjectModel::publish);
+
+    m_trafficObjects.reserve(trafficObjects.size());
+    m_dirty.fill(false, trafficObjects.size());
+    for(qsizetype row = 0; row < trafficObjects.size(); row++)
+    {
+        auto* trafficObject = trafficObjects.at(row);
+        m_trafficObjects.append(trafficObject);
+        if (trafficObject == nullptr)
+        {
+            continue;
+        }
+
+        // All notifier signals of the object mark the row as dirty. The
+        // properties "color", "description", "icon" and "valid" are derived
+        // from the others and are covered by their own notifiers.
+        auto markRowDirty = [this, row]() { markDirty(row); };
+        connect(trafficObject, &Traffic::TrafficFactor_Abstract::alarmLevelChanged, this, markRowDirty);
+        connect(trafficObject, &Traffic::TrafficFactor_Abstract::animateChanged, this, markRowDirty);
+        connect(trafficObject, &Traffic::TrafficFactor_Abstract::callSignChanged, this, markRowDirty);
+        connect(trafficObject, &Traffic::TrafficFactor_Abstract::colorChanged, this, markRowDirty);
+        connect(trafficObject, &Traffic::TrafficFactor_Abstract::descriptionChanged, this, markRowDirty);
+        connect(trafficObject, &Traffic::TrafficFactor_Abstract::hDistChanged, this, markRowDirty);
+        connect(trafficObject, &Traffic::TrafficFactor_Abstract::IDChanged, this, markRowDirty);
+        connect(trafficObject, &Traffic::TrafficFactor_Abstract::typeChanged, this, markRowDirty);
+        connect(trafficObject, &Traffic::TrafficFactor_Abstract::validChanged, this, markRowDirty);
+        connect(trafficObject, &Traffic::TrafficFactor_Abstract::vDistChanged, this, markRowDirty);
+        connect(trafficObject, &Traffic::TrafficFactor_WithPosition::iconChanged, this, markRowDirty);
+        connect(trafficObject, &Traffic::TrafficFactor_WithPosition::positionInfoChanged, this, markRowDirty);
+    }
+}
+
+
+//
+// Methods
+//
+
+QVariant Traffic::TrafficObjectModel::data(const QModelIndex& index, int role) const
+{
+    if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid))
+    {
+        return {};
+    }
+    auto trafficObject = m_trafficObjects.at(index.row());
+    if (trafficObject.isNull())
+    {
+        return {};
+    }
+
+    switch(role)
+    {
+    case AlarmLevelRole:
+        return trafficObject->alarmLevel();
+    case AnimateRole:
+        return trafficObject->animate();
+    case CallSignRole:
+        return trafficObject->callSign();
+    case ColorRole:
+        return trafficObject->color();
+    case DescriptionRole:
+        return trafficObject->description();
+    case HDistRole:
+        return QVariant::fromValue(trafficObject->hDist());
+    case IconRole:
+        return trafficObject->icon();
+    case IDRole:
+        return trafficObject->ID();
+    case PositionInfoRole:
+        return QVariant::fromValue(trafficObject->positionInfo());
+    case TypeRole:
+        return QVariant::fromValue(trafficObject->type());
+    case ValidRole:
+        return trafficObject->valid();
+    case VDistRole:
+        return QVariant::fromValue(trafficObject->vDist());
+    default:
+        break;
+    }
+    return {};
+}
+
+
+void Traffic::TrafficObjectModel::markDirty(qsizetype row)
+{
+    m_dirty[row] = true;
+    m_hasDirtyRows = true;
+    if (!m_frameTimer.isActive())
+    {
+        m_frameTimer.start();
+    }
+}
+
+
+void Traffic::TrafficObjectModel::publish()
+{
+    m_frameTimer.stop();
+    if (!m_hasDirtyRows)
+    {
+        return;
+    }
+    m_hasDirtyRows = false;
+
+    // Emit one dataChanged() signal per contiguous range of dirty rows
+    qsizetype first = -1;
+    for(qsizetype row = 0; row <= m_dirty.size(); row++)
+    {
+        if ((row < m_dirty.size()) && m_dirty.at(row))
+        {
+            m_dirty[row] = false;
+            if (first < 0)
+            {
+                first = row;
+            }
+            continue;
+        }
+        if (first >= 0)
+        {
+            emit dataChanged(index(static_cast<int>(first)), index(static_cast<int>(row-1)));
+            first = -1;
+        }
+    }
+}
+
+
+QHash<int, QByteArray> Traffic::TrafficObjectModel::roleNames() const
+{
+    return {
+        {AlarmLevelRole, "alarmLevel"},
+        {AnimateRole, "animate"},
+        {CallSignRole, "callSign"},
+        {ColorRole, "color"},
+        {DescriptionRole, "description"},
+        {HDistRole, "hDist"},
+        {IconRole, "icon"},
+        {IDRole, "ID"},
+        {PositionInfoRole, "positionInfo"},
+        {TypeRole, "type"},
+        {ValidRole, "valid"},
+        {VDistRole, "vDist"}
+    };
+}
+
+
+int Traffic::TrafficObjectModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid())
+    {
+        return 0;
+    }
+    return static_cast<int>(m_trafficObjects.size());
+}
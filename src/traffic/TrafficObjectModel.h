@@ -0,0 +1,129 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QAbstractListModel>
+#include <QPointer>
+#include <QQmlEngine>
+#include <QTimer>
+
+#include "traffic/TrafficFactor_WithPosition.h"
+
+
+namespace Traffic {
+
+/*! \brief List model exposing traffic objects to QML
+ *
+ *  This class wraps the fixed list of traffic objects held by the
+ *  TrafficDataProvider into a QAbstractListModel.  Property changes of the
+ *  traffic objects are not forwarded to QML one by one. Instead, the model
+ *  marks the affected rows as dirty and publishes the changes once per display
+ *  frame, as one dataChanged() signal per contiguous range of dirty rows.
+ *
+ *  The roles of the model are named after the properties of
+ *  TrafficFactor_WithPosition, so that QML delegates can use the object
+ *  "model" in the same way they would use a TrafficFactor_WithPosition.
+ */
+class TrafficObjectModel : public QAbstractListModel
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_UNCREATABLE("")
+
+public:
+    /*! \brief Roles provided by this model */
+    enum Roles {
+        AlarmLevelRole = Qt::UserRole + 1, /*!< Property alarmLevel */
+        AnimateRole, /*!< Property animate */
+        CallSignRole, /*!< Property callSign */
+        ColorRole, /*!< Property color */
+        DescriptionRole, /*!< Property description */
+        HDistRole, /*!< Property hDist */
+        IconRole, /*!< Property icon */
+        IDRole, /*!< Property ID */
+        PositionInfoRole, /*!< Property positionInfo */
+        TypeRole, /*!< Property type */
+        ValidRole, /*!< Property valid */
+        VDistRole /*!< Property vDist */
+    };
+    Q_ENUM(Roles)
+
+    /*! \brief Standard constructor
+     *
+     *  @param trafficObjects Traffic objects that are exposed by this model.
+     *  The model does not take ownership.
+     *
+     *  @param parent The standard QObject parent pointer
+     */
+    explicit TrafficObjectModel(const QList<Traffic::TrafficFactor_WithPosition*>& trafficObjects, QObject* parent = nullptr);
+
+    // Standard destructor
+    ~TrafficObjectModel() override = default;
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Implementation of QAbstractItemModel::data */
+    [[nodiscard]] QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    /*! \brief Implementation of QAbstractItemModel::roleNames */
+    [[nodiscard]] QHash<int, QByteArray> roleNames() const override;
+
+    /*! \brief Implementation of QAbstractItemModel::rowCount */
+    [[nodiscard]] int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+
+
+    //
+    // Constants
+    //
+
+    /*! \brief Interval between two consecutive publications of changes
+     *
+     *  Changes of the traffic objects are published to QML at most once per
+     *  frameInterval.
+     */
+    static constexpr auto frameInterval = 100ms;
+
+public slots:
+    /*! \brief Publish pending changes
+     *
+     *  Emits dataChanged() for all rows that have changed since the last
+     *  publication, one signal per contiguous range of rows. This slot is called
+     *  automatically, but it can be called directly in order to publish changes
+     *  without waiting for the next frame.
+     */
+    void publish();
+
+private:
+    Q_DISABLE_COPY_MOVE(TrafficObjectModel)
+
+    // Marks a row as dirty and makes sure that the frame timer is running
+    void markDirty(qsizetype row);
+
+    QList<QPointer<Traffic::TrafficFactor_WithPosition>> m_trafficObjects;
+    QList<bool> m_dirty;
+    bool m_hasDirtyRows {false};
+    QTimer m_frameTimer;
+};
+
+} // namespace Traffic
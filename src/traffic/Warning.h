@@ -25,6 +25,7 @@
 
 namespace Traffic {
 
+class TrafficDataProvider;
 class TrafficDataSource_Abstract;
 
 /*! \brief Traffic warning
@@ -40,6 +41,7 @@ class TrafficDataSource_Abstract;
 class Warning {
     Q_GADGET
 
+    friend TrafficDataProvider;
     friend TrafficDataSource_Abstract;
 
 public:
@@ -142,6 +144,13 @@ private:
                      const QString& RelativeVertical,
                      const QString& RelativeDistance);
 
+    // Private constructor for aircraft alarms that are predicted by the app
+    // itself, only to be used by TrafficDataProvider
+    explicit Warning(int alarmLevel,
+                     Units::Angle relativeBearing,
+                     Units::Distance hDist,
+                     Units::Distance vDist);
+
     // Property values
     int m_alarmLevel {-1};
     int m_alarmType {-1};
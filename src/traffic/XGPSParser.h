@@ -0,0 +1,190 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <string_view>
+
+#if !defined(__cpp_lib_to_chars)
+#include <QByteArrayView>
+#endif
+
+
+namespace Traffic::XGPS {
+
+/*! \brief Field layout of XGPS ownship reports
+ *
+ *  XGPS<sim>,<lon>,<lat>,<alt>,<track>,<ground speed>
+ */
+struct OwnshipLayout
+{
+    static constexpr std::string_view tag = "XGPS";
+    static constexpr std::size_t numFields = 6;
+
+    enum Field : std::size_t
+    {
+        Longitude = 1,
+        Latitude = 2,
+        AltitudeInM = 3,
+        Track = 4,
+        GroundSpeedInMPS = 5
+    };
+};
+
+/*! \brief Field layout of XTRA traffic reports
+ *
+ *  XTRA<sim>,<ID>,<lat>,<lon>,<alt>,<vertical speed>,<airborne>,<track>,<ground speed>,<callsign>
+ */
+struct TrafficLayout
+{
+    static constexpr std::string_view tag = "XTRA";
+    static constexpr std::size_t numFields = 10;
+
+    enum Field : std::size_t
+    {
+        ID = 1,
+        Latitude = 2,
+        Longitude = 3,
+        AltitudeInFT = 4,
+        VerticalSpeedInFPM = 5,
+        Airborne = 6,
+        Track = 7,
+        GroundSpeedInKN = 8,
+        CallSign = 9
+    };
+};
+
+
+/*! \brief Record of the XGPS protocol, as used by ForeFlight
+ *
+ *  This class splits a message of the XGPS protocol into comma-separated
+ *  fields. It works directly on the bytes of the message and does not
+ *  allocate memory. The fields are views into the message, which must
+ *  therefore outlive the record.
+ *
+ *  @tparam Layout Field layout, either OwnshipLayout or TrafficLayout. A
+ *  message is accepted only if it starts with Layout::tag and has exactly
+ *  Layout::numFields fields.
+ */
+template<typename Layout>
+class Record
+{
+public:
+    /*! \brief Split message into fields
+     *
+     *  @param message Message
+     *
+     *  @returns True if the message matches the layout
+     */
+    bool parse(std::string_view message)
+    {
+        if (!message.starts_with(Layout::tag))
+        {
+            return false;
+        }
+
+        std::size_t index = 0;
+        std::size_t start = 0;
+        while (true)
+        {
+            auto const end = message.find(',', start);
+            if (index >= Layout::numFields)
+            {
+                return false;
+            }
+            m_fields[index++] = message.substr(start, end-start);
+            if (end == std::string_view::npos)
+            {
+                break;
+            }
+            start = end+1;
+        }
+        return index == Layout::numFields;
+    }
+
+    /*! \brief Raw field
+     *
+     *  @param index Field index, as defined in the layout
+     *
+     *  @returns View into the message
+     */
+    [[nodiscard]] std::string_view field(std::size_t index) const
+    {
+        return m_fields[index];
+    }
+
+    /*! \brief Numerical field
+     *
+     *  Leading and trailing whitespace, as well as a leading '+', are ignored.
+     *  A '+' must not be followed by another sign.
+     *
+     *  @param index Field index, as defined in the layout
+     *
+     *  @param result Number, set only on success
+     *
+     *  @returns True if the field is a number
+     */
+    [[nodiscard]] bool number(std::size_t index, double& result) const
+    {
+        auto text = m_fields[index];
+        auto const first = text.find_first_not_of(" \t\r\n");
+        if (first == std::string_view::npos)
+        {
+            return false;
+        }
+        text = text.substr(first, text.find_last_not_of(" \t\r\n") - first + 1);
+        if (text.starts_with('+'))
+        {
+            text.remove_prefix(1);
+            if (text.starts_with('-'))
+            {
+                return false;
+            }
+        }
+
+#if defined(__cpp_lib_to_chars)
+        double value = 0.0;
+        auto const [end, error] = std::from_chars(text.data(), text.data()+text.size(), value);
+        if ((error != std::errc()) || (end != text.data()+text.size()))
+        {
+            return false;
+        }
+        result = value;
+        return true;
+#else
+        // Standard libraries without floating point support in std::from_chars
+        bool ok = false;
+        auto const value = QByteArrayView(text.data(), static_cast<qsizetype>(text.size())).toDouble(&ok);
+        if (ok)
+        {
+            result = value;
+        }
+        return ok;
+#endif
+    }
+
+private:
+    std::array<std::string_view, Layout::numFields> m_fields {};
+};
+
+} // namespace Traffic::XGPS
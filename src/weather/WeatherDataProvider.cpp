@@ -36,6 +36,7 @@
 #include "geomaps/GeoMapProvider.h"
 #include "navigation/Clock.h"
 #include "navigation/FlightRoute.h"
+#include "navigation/Geodesy.h"
 #include "navigation/Navigator.h"
 #include "positioning/PositionProvider.h"
 #include "weather/METAR.h"
@@ -491,7 +492,9 @@ auto Weather::WeatherDataProvider::QNH() const -> Units::Pressure
     }
 
     // Find QNH of nearest airfield
+    Navigation::Geodesy::Point const here(Positioning::PositionProvider::lastValidCoordinate());
     Weather::Station *closestReportWithQNH = nullptr;
+    double closestSquaredChord = 0.0;
     Units::Pressure QNH;
     foreach(auto weatherStationPtr, _weatherStationsByICAOCode) {
         if (weatherStationPtr.isNull())
@@ -511,15 +514,11 @@ auto Weather::WeatherDataProvider::QNH() const -> Units::Pressure
         {
             continue;
         }
-        if (closestReportWithQNH == nullptr) {
-            closestReportWithQNH = weatherStationPtr;
-            continue;
-        }
-
-        QGeoCoordinate const here = Positioning::PositionProvider::lastValidCoordinate();
-        if (here.distanceTo(weatherStationPtr->coordinate()) < here.distanceTo(closestReportWithQNH->coordinate()))
+        auto const squaredChord = Navigation::Geodesy::squaredChord(here, Navigation::Geodesy::Point(weatherStationPtr->coordinate()));
+        if ((closestReportWithQNH == nullptr) || (squaredChord < closestSquaredChord))
         {
             closestReportWithQNH = weatherStationPtr;
+            closestSquaredChord = squaredChord;
         }
     }
     if (closestReportWithQNH != nullptr)
@@ -540,7 +539,9 @@ auto Weather::WeatherDataProvider::QNHInfo() const -> QString
     }
 
     // Find QNH of nearest airfield
+    Navigation::Geodesy::Point const here(Positioning::PositionProvider::lastValidCoordinate());
     Weather::Station *closestReportWithQNH = nullptr;
+    double closestSquaredChord = 0.0;
     Units::Pressure QNH;
     foreach(auto weatherStationPtr, _weatherStationsByICAOCode) {
         if (weatherStationPtr.isNull())
@@ -560,15 +561,11 @@ auto Weather::WeatherDataProvider::QNHInfo() const -> QString
         {
             continue;
         }
-        if (closestReportWithQNH == nullptr) {
-            closestReportWithQNH = weatherStationPtr;
-            continue;
-        }
-
-        QGeoCoordinate const here = Positioning::PositionProvider::lastValidCoordinate();
-        if (here.distanceTo(weatherStationPtr->coordinate()) < here.distanceTo(closestReportWithQNH->coordinate()))
+        auto const squaredChord = Navigation::Geodesy::squaredChord(here, Navigation::Geodesy::Point(weatherStationPtr->coordinate()));
+        if ((closestReportWithQNH == nullptr) || (squaredChord < closestSquaredChord))
         {
             closestReportWithQNH = weatherStationPtr;
+            closestSquaredChord = squaredChord;
         }
     }
     if (closestReportWithQNH != nullptr)
@@ -682,13 +679,20 @@ auto Weather::WeatherDataProvider::weatherStations() const -> QList<Weather::Sta
             sortedReports += stations;
         }
 
-    // Sort list
-    auto compare = [&](const Weather::Station *a, const Weather::Station *b) {
-        QGeoCoordinate const here = Positioning::PositionProvider::lastValidCoordinate();
-        return here.distanceTo(a->coordinate()) < here.distanceTo(b->coordinate());
-    };
-    std::sort(sortedReports.begin(), sortedReports.end(), compare);
-
-    return sortedReports;
+    // Sort list by distance. Distances are computed once per station, in one
+    // batch.
+    Navigation::Geodesy::PointArray points;
+    points.reserve(sortedReports.size());
+    foreach(auto* station, sortedReports)
+    {
+        points.append(station->coordinate());
+    }
+    QList<Weather::Station *> result;
+    result.reserve(sortedReports.size());
+    for(auto index : points.nearestIndices(Navigation::Geodesy::Point(Positioning::PositionProvider::lastValidCoordinate()), points.size()))
+    {
+        result += sortedReports[index];
+    }
+    return result;
 }
 
@@ -0,0 +1,217 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <algorithm>
+
+#include "units/Distance.h"
+#include "units/Speed.h"
+#include "weather/WindField.h"
+
+
+namespace {
+
+// Reads an array of numbers. Returns an empty vector if the value is not an
+// array of numbers.
+std::vector<double> readArray(const QJsonValue& value)
+{
+    std::vector<double> result;
+    auto const array = value.toArray();
+    result.reserve(array.size());
+    for(const auto& entry : array)
+    {
+        if (!entry.isDouble())
+        {
+            return {};
+        }
+        result.push_back(entry.toDouble());
+    }
+    return result;
+}
+
+// Checks if a grid is strictly increasing and has at least one entry
+bool isGrid(const std::vector<double>& grid)
+{
+    if (grid.empty())
+    {
+        return false;
+    }
+    return std::adjacent_find(grid.begin(), grid.end(), std::greater_equal<>()) == grid.end();
+}
+
+} // namespace
+
+
+//
+// Methods
+//
+
+auto Weather::WindField::column(const QGeoCoordinate& coordinate) const -> std::vector<Sample>
+{
+    qsizetype latIndex = 0;
+    double latWeight = 0.0;
+    qsizetype lonIndex = 0;
+    double lonWeight = 0.0;
+    if (!isValid() ||
+        !coordinate.isValid() ||
+        !locate(m_latitudesInDEG, coordinate.latitude(), latIndex, latWeight) ||
+        !locate(m_longitudesInDEG, coordinate.longitude(), lonIndex, lonWeight))
+    {
+        return {};
+    }
+
+    auto const numLat = static_cast<qsizetype>(m_latitudesInDEG.size());
+    auto const numLon = static_cast<qsizetype>(m_longitudesInDEG.size());
+    auto const nextLat = qMin(latIndex+1, numLat-1);
+    auto const nextLon = qMin(lonIndex+1, numLon-1);
+    auto const w00 = (1.0-latWeight)*(1.0-lonWeight);
+    auto const w01 = (1.0-latWeight)*lonWeight;
+    auto const w10 = latWeight*(1.0-lonWeight);
+    auto const w11 = latWeight*lonWeight;
+
+    std::vector<Sample> result(m_altitudesInM.size());
+    for(qsizetype level=0; level<static_cast<qsizetype>(result.size()); level++)
+    {
+        auto const offset = level*numLat*numLon;
+        const auto& s00 = m_samples[offset + latIndex*numLon + lonIndex];
+        const auto& s01 = m_samples[offset + latIndex*numLon + nextLon];
+        const auto& s10 = m_samples[offset + nextLat*numLon + lonIndex];
+        const auto& s11 = m_samples[offset + nextLat*numLon + nextLon];
+        result[level].windUInMPS = w00*s00.windUInMPS + w01*s01.windUInMPS + w10*s10.windUInMPS + w11*s11.windUInMPS;
+        result[level].windVInMPS = w00*s00.windVInMPS + w01*s01.windVInMPS + w10*s10.windVInMPS + w11*s11.windVInMPS;
+        result[level].temperatureInDegC = w00*s00.temperatureInDegC + w01*s01.temperatureInDegC + w10*s10.temperatureInDegC + w11*s11.temperatureInDegC;
+    }
+    return result;
+}
+
+
+auto Weather::WindField::interpolate(const std::vector<Sample>& column, double altitudeInM) const -> Sample
+{
+    if (column.empty() || (column.size() != m_altitudesInM.size()))
+    {
+        return {};
+    }
+
+    altitudeInM = std::clamp(altitudeInM, m_altitudesInM.front(), m_altitudesInM.back());
+    qsizetype index = 0;
+    double weight = 0.0;
+    (void)locate(m_altitudesInM, altitudeInM, index, weight);
+    auto const next = qMin(index+1, static_cast<qsizetype>(column.size())-1);
+
+    Sample result;
+    result.windUInMPS = (1.0-weight)*column[index].windUInMPS + weight*column[next].windUInMPS;
+    result.windVInMPS = (1.0-weight)*column[index].windVInMPS + weight*column[next].windVInMPS;
+    result.temperatureInDegC = (1.0-weight)*column[index].temperatureInDegC + weight*column[next].temperatureInDegC;
+    return result;
+}
+
+
+auto Weather::WindField::loadFromJSON(const QString& fileName) -> QString
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        *this = {};
+        return QObject::tr("Unable to open the file '%1' for reading.").arg(fileName);
+    }
+    return loadFromJSON(file.readAll());
+}
+
+
+auto Weather::WindField::loadFromJSON(const QByteArray& JSON) -> QString
+{
+    *this = {};
+
+    QJsonParseError parseError{};
+    auto document = QJsonDocument::fromJson(JSON, &parseError);
+    if (parseError.error != QJsonParseError::NoError)
+    {
+        return parseError.errorString();
+    }
+
+    auto content = document.object();
+    if (content.isEmpty())
+    {
+        return QObject::tr("JSON document contains no data.");
+    }
+    if (content[QStringLiteral("content")] != "wind field")
+    {
+        return QObject::tr("JSON document does not describe a wind field.");
+    }
+
+    auto latitudes = readArray(content[QStringLiteral("latitudes_deg")]);
+    auto longitudes = readArray(content[QStringLiteral("longitudes_deg")]);
+    auto altitudes = readArray(content[QStringLiteral("altitudes_ft")]);
+    if (!isGrid(latitudes) || !isGrid(longitudes) || !isGrid(altitudes))
+    {
+        return QObject::tr("Grid of the wind field is invalid.");
+    }
+
+    auto const windU = readArray(content[QStringLiteral("windU_kt")]);
+    auto const windV = readArray(content[QStringLiteral("windV_kt")]);
+    auto const temperature = readArray(content[QStringLiteral("temperature_degC")]);
+    auto const numSamples = latitudes.size()*longitudes.size()*altitudes.size();
+    if ((windU.size() != numSamples) || (windV.size() != numSamples) || (temperature.size() != numSamples))
+    {
+        return QObject::tr("Number of values does not match the grid of the wind field.");
+    }
+
+    for(auto& altitude : altitudes)
+    {
+        altitude = Units::Distance::fromFT(altitude).toM();
+    }
+    std::vector<Sample> samples(numSamples);
+    for(std::size_t i=0; i<numSamples; i++)
+    {
+        samples[i].windUInMPS = Units::Speed::fromKN(windU[i]).toMPS();
+        samples[i].windVInMPS = Units::Speed::fromKN(windV[i]).toMPS();
+        samples[i].temperatureInDegC = temperature[i];
+    }
+
+    m_latitudesInDEG = std::move(latitudes);
+    m_longitudesInDEG = std::move(longitudes);
+    m_altitudesInM = std::move(altitudes);
+    m_samples = std::move(samples);
+    return {};
+}
+
+
+auto Weather::WindField::locate(const std::vector<double>& grid, double value, qsizetype& index, double& weight) -> bool
+{
+    if (!(value >= grid.front()) || !(value <= grid.back()))
+    {
+        return false;
+    }
+    if (grid.size() == 1)
+    {
+        index = 0;
+        weight = 0.0;
+        return true;
+    }
+
+    auto const upper = std::upper_bound(grid.begin(), grid.end()-1, value);
+    index = static_cast<qsizetype>(upper - grid.begin()) - 1;
+    weight = (value - grid[index])/(grid[index+1] - grid[index]);
+    return true;
+}
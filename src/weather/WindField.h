@@ -0,0 +1,150 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <QGeoCoordinate>
+#include <QString>
+#include <vector>
+
+
+namespace Weather {
+
+/*! \brief Winds and temperatures aloft on a grid
+ *
+ *  This class holds wind and temperature forecasts on a regular grid of
+ *  latitudes, longitudes and altitudes, typically for the area of a flight.
+ *  The data is read from a JSON document of the following form.
+ *
+ *  \code{.json}
+ *  {
+ *    "content": "wind field",
+ *    "latitudes_deg": [47.0, 48.0, 49.0],
+ *    "longitudes_deg": [7.0, 8.0, 9.0, 10.0],
+ *    "altitudes_ft": [0, 3000, 6000, 9000],
+ *    "windU_kt": [ ... ],
+ *    "windV_kt": [ ... ],
+ *    "temperature_degC": [ ... ]
+ *  }
+ *  \endcode
+ *
+ *  Latitudes, longitudes and altitudes (MSL) must be strictly increasing.
+ *  The arrays windU_kt (eastward component of the wind vector), windV_kt
+ *  (northward component) and temperature_degC contain one value per grid
+ *  point, where the longitude index runs fastest and the altitude index
+ *  slowest.
+ *
+ *  Lookups proceed in two steps. The method column() interpolates
+ *  horizontally and returns the values at all altitude levels of one
+ *  location. The method interpolate() interpolates such a column vertically.
+ *  Users that evaluate the field repeatedly at the same locations, but at
+ *  different altitudes, should cache the columns.
+ */
+
+class WindField
+{
+public:
+    /*! \brief Wind and temperature at one point */
+    struct Sample
+    {
+        /*! \brief Eastward component of the wind vector, in m/s */
+        double windUInMPS {qQNaN()};
+
+        /*! \brief Northward component of the wind vector, in m/s */
+        double windVInMPS {qQNaN()};
+
+        /*! \brief Temperature in degree Celsius */
+        double temperatureInDegC {qQNaN()};
+    };
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Altitude levels
+     *
+     *  @returns Altitudes of the grid levels in meters MSL, in increasing
+     *  order
+     */
+    [[nodiscard]] auto altitudesInM() const -> const std::vector<double>& { return m_altitudesInM; }
+
+    /*! \brief Horizontal interpolation
+     *
+     *  @param coordinate Coordinate
+     *
+     *  @returns One sample per altitude level, bilinearly interpolated between
+     *  the neighbouring grid points. The list is empty if the field is invalid
+     *  or if the coordinate lies outside of the grid.
+     */
+    [[nodiscard]] auto column(const QGeoCoordinate& coordinate) const -> std::vector<Sample>;
+
+    /*! \brief Vertical interpolation
+     *
+     *  @param column Column, as returned by column()
+     *
+     *  @param altitudeInM Altitude in meters MSL. Altitudes above the highest
+     *  or below the lowest level are clamped.
+     *
+     *  @returns Sample, linearly interpolated between the neighbouring levels,
+     *  or a sample with NaN values if the column is empty
+     */
+    [[nodiscard]] auto interpolate(const std::vector<Sample>& column, double altitudeInM) const -> Sample;
+
+    /*! \brief Validity
+     *
+     *  @returns True if the field contains data
+     */
+    [[nodiscard]] auto isValid() const -> bool { return !m_samples.empty(); }
+
+    /*! \brief Reads wind field from a file
+     *
+     *  @param fileName File name
+     *
+     *  @returns Empty string in case of success, human-readable, translated
+     *  error message otherwise. In case of error, the field is invalid.
+     */
+    [[nodiscard]] auto loadFromJSON(const QString& fileName) -> QString;
+
+    /*! \brief Reads wind field from a JSON document
+     *
+     *  @param JSON JSON data
+     *
+     *  @returns Empty string in case of success, human-readable, translated
+     *  error message otherwise. In case of error, the field is invalid.
+     */
+    [[nodiscard]] auto loadFromJSON(const QByteArray& JSON) -> QString;
+
+private:
+    // Finds the grid interval that contains value. Returns false if value lies
+    // outside of the grid.
+    [[nodiscard]] static auto locate(const std::vector<double>& grid, double value, qsizetype& index, double& weight) -> bool;
+
+    // Grid
+    std::vector<double> m_latitudesInDEG;
+    std::vector<double> m_longitudesInDEG;
+    std::vector<double> m_altitudesInM;
+
+    // Samples, longitude index running fastest
+    std::vector<Sample> m_samples;
+};
+
+} // namespace Weather
@@ -0,0 +1,27 @@
+#
+# Static library with the sources of the app
+#
+# Defines the function enroute_add_app_library(target), which builds the list
+# SOURCES of the app, without main.cpp and without resources, into a static
+# library. The library has the include directories and link libraries of the
+# app. It is used by the unit tests and by the fuzz targets, and must be
+# called from a directory that is added from src/CMakeLists.txt.
+#
+
+function(enroute_add_app_library target)
+    set(APP_SOURCES "")
+    foreach(source ${SOURCES})
+        if ((source MATCHES "^\\$<") OR (source MATCHES "\\.(qrc|m)$") OR (source MATCHES "(^|/)main\\.cpp$"))
+            continue()
+        endif()
+        get_filename_component(source ${source} ABSOLUTE BASE_DIR ${CMAKE_SOURCE_DIR}/src)
+        list(APPEND APP_SOURCES ${source})
+    endforeach()
+
+    add_library(${target} STATIC ${APP_SOURCES})
+    get_target_property(ENROUTE_INCLUDE_DIRECTORIES ${PROJECT_NAME} INCLUDE_DIRECTORIES)
+    get_target_property(ENROUTE_LINK_LIBRARIES ${PROJECT_NAME} LINK_LIBRARIES)
+    target_include_directories(${target} PUBLIC ${CMAKE_SOURCE_DIR}/src ${ENROUTE_INCLUDE_DIRECTORIES})
+    target_link_libraries(${target} PUBLIC ${ENROUTE_LINK_LIBRARIES})
+    target_precompile_headers(${target} PUBLIC <QQmlEngine>)
+endfunction()
@@ -0,0 +1,44 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include <cstddef>
+#include <cstdint>
+
+#include "FuzzTrafficDataSource.h"
+
+
+// Fuzz target for TrafficDataSource_Abstract::processFLARMData. The input is
+// FLARM/NMEA data, as read from a serial port or a TCP connection. The data may
+// contain any number of sentences, including partial ones.
+
+extern "C" int LLVMFuzzerInitialize(int* argc, char*** argv)
+{
+    Traffic::FuzzTrafficDataSource::initialize(argc, argv);
+    return 0;
+}
+
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    Traffic::FuzzTrafficDataSource source;
+    source.processFLARMData(QString::fromLatin1(reinterpret_cast<const char*>(data), static_cast<qsizetype>(size)));
+    return 0;
+}
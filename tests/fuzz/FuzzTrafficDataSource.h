@@ -0,0 +1,88 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <QCoreApplication>
+#include <QStandardPaths>
+
+#include "GlobalObject.h"
+#include "navigation/Navigator.h"
+#include "positioning/PositionProvider.h"
+#include "traffic/FlarmnetDB.h"
+#include "traffic/TrafficDataSource_Abstract.h"
+#include "traffic/Warning.h"
+
+
+namespace Traffic {
+
+/*! \brief Traffic data source for the fuzz targets
+ *
+ *  This class gives the fuzz targets access to the parsers of
+ *  TrafficDataSource_Abstract. It never connects to a traffic receiver.
+ */
+
+class FuzzTrafficDataSource : public TrafficDataSource_Abstract
+{
+public:
+    /*! \brief Standard constructor */
+    FuzzTrafficDataSource() : TrafficDataSource_Abstract(false, nullptr) {}
+
+    using TrafficDataSource_Abstract::processFLARMData;
+    using TrafficDataSource_Abstract::processGDLMessage;
+    using TrafficDataSource_Abstract::processXGPSString;
+
+    [[nodiscard]] QString dataFormat() const override { return {}; }
+    [[nodiscard]] QString icon() const override { return {}; }
+    [[nodiscard]] QString sourceName() const override { return {}; }
+    void connectToTrafficReceiver() override {}
+    void disconnectFromTrafficReceiver() override {}
+
+    /*! \brief Set up the fuzz target
+     *
+     *  The parsers use global objects such as the PositionProvider, which
+     *  require a QCoreApplication. As in main(), the application is named, so
+     *  that the global objects find their settings, and the metatypes of
+     *  queued signals are registered. The global objects used by the parsers
+     *  are constructed here, so that their construction is not attributed to
+     *  the first input.  Settings and caches are written to test locations, so
+     *  that fuzzing does not touch the data of the app.
+     *
+     *  @param argc Argument count, as passed to LLVMFuzzerInitialize
+     *
+     *  @param argv Arguments, as passed to LLVMFuzzerInitialize
+     */
+    static void initialize(int* argc, char*** argv)
+    {
+        QStandardPaths::setTestModeEnabled(true);
+        static QCoreApplication const application(*argc, *argv);
+        QCoreApplication::setOrganizationName(QStringLiteral("Akaflieg Freiburg"));
+        QCoreApplication::setOrganizationDomain(QStringLiteral("akaflieg_freiburg.de"));
+        QCoreApplication::setApplicationName(QStringLiteral("enroute flight navigation"));
+        qRegisterMetaType<Traffic::Warning>();
+
+        GlobalObject::flarmnetDB();
+        GlobalObject::navigator();
+        GlobalObject::positionProvider();
+    }
+};
+
+} // namespace Traffic
@@ -0,0 +1,115 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include <QTest>
+
+#include "TestAircraft.h"
+#include "navigation/Aircraft.h"
+#include "navigation/Leg.h"
+#include "navigation/RoutePerformance.h"
+
+
+namespace {
+
+// Aircraft file, as written by versions of the app that did not know about
+// climb and descent performance
+const QByteArray oldFormat = R"({
+    "content": "aircraft",
+    "cruiseSpeed_mps": 51.44,
+    "descentSpeed_mps": 41.16,
+    "fuelConsumption_lph": 25,
+    "fuelConsumptionUnit": 0,
+    "horizontalDistanceUnit": 0,
+    "minimumSpeed_mps": 30.87,
+    "name": "D-EABC",
+    "verticalDistanceUnit": 0
+})";
+
+// Aircraft loaded from oldFormat
+Navigation::Aircraft oldFormatAircraft()
+{
+    Navigation::Aircraft aircraft;
+    auto const error = aircraft.loadFromJSON(oldFormat);
+    if (!error.isEmpty())
+    {
+        qWarning() << error;
+    }
+    return aircraft;
+}
+
+} // namespace
+
+
+void TestAircraft::oldFormatJSON()
+{
+    auto const aircraft = oldFormatAircraft();
+    QCOMPARE(aircraft.name(), u"D-EABC"_qs);
+    QCOMPARE(aircraft.cruiseSpeed().toMPS(), 51.44);
+    QCOMPARE(aircraft.descentSpeed().toMPS(), 41.16);
+    QVERIFY(!aircraft.climbSpeed().isFinite());
+    QVERIFY(!aircraft.climbRate().isFinite());
+    QVERIFY(!aircraft.descentRate().isFinite());
+
+    // Save and load again
+    Navigation::Aircraft reloaded;
+    QVERIFY(reloaded.loadFromJSON(aircraft.toJSON()).isEmpty());
+    QCOMPARE(reloaded.name(), aircraft.name());
+    QCOMPARE(reloaded.cruiseSpeed().toMPS(), aircraft.cruiseSpeed().toMPS());
+    QCOMPARE(reloaded.descentSpeed().toMPS(), aircraft.descentSpeed().toMPS());
+    QCOMPARE(reloaded.fuelConsumption().toLPH(), aircraft.fuelConsumption().toLPH());
+    QVERIFY(!reloaded.climbSpeed().isFinite());
+    QVERIFY(!reloaded.climbRate().isFinite());
+    QVERIFY(!reloaded.descentRate().isFinite());
+}
+
+
+void TestAircraft::routePerformanceFallback()
+{
+    auto const aircraft = oldFormatAircraft();
+
+    Weather::Wind wind;
+    wind.setSpeed(Units::Speed::fromKN(15.0));
+    wind.setDirectionFrom(Units::Angle::fromDEG(250.0));
+
+    const QGeoCoordinate start(48.0, 7.8);
+    QList<Navigation::Leg> legs;
+    legs << Navigation::Leg(start, start.atDistanceAndAzimuth(30000.0, 10.0));
+    legs << Navigation::Leg(legs.constLast().endPoint(), legs.constLast().endPoint().coordinate().atDistanceAndAzimuth(20000.0, 130.0));
+
+    Navigation::RoutePerformance performance;
+    performance.setRoute(legs);
+
+    // The cruise altitude is known, but climb and descent are not. The whole
+    // route is therefore flown at cruise altitude and cruise speed.
+    auto const cruiseAltitude = Units::Distance::fromFT(3500.0);
+    auto const result = performance.compute(aircraft, wind, cruiseAltitude);
+    QCOMPARE(result.size(), legs.size());
+    for(qsizetype i=0; i<legs.size(); i++)
+    {
+        auto const ETE = legs[i].ETE(wind, aircraft).toS();
+        QVERIFY(qAbs(result[i].ETE.toS() - ETE) <= 0.01*ETE);
+        QVERIFY(qAbs(result[i].fuel.toL() - legs[i].Fuel(wind, aircraft).toL()) <= 0.01*legs[i].Fuel(wind, aircraft).toL());
+        QCOMPARE(result[i].altitudeAtStart.toM(), cruiseAltitude.toM());
+        QCOMPARE(result[i].altitudeAtEnd.toM(), cruiseAltitude.toM());
+    }
+    QVERIFY(!performance.topOfClimb().isFinite());
+    QVERIFY(!performance.topOfDescent().isFinite());
+}
@@ -0,0 +1,43 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <QObject>
+
+
+/*! \brief Unit tests for Navigation::Aircraft */
+
+class TestAircraft : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Aircraft files written before climb and descent performance were added
+    // load with unknown climb speed, climb rate and descent rate, and keep
+    // these values unknown when saved again
+    void oldFormatJSON();
+
+    // Without climb and descent performance, Navigation::RoutePerformance
+    // computes the same times and fuel as the wind triangle of
+    // Navigation::Leg
+    void routePerformanceFallback();
+};
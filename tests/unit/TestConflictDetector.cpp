@@ -0,0 +1,102 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include <QGeoPositionInfo>
+#include <QTest>
+
+#include "TestConflictDetector.h"
+#include "traffic/ConflictDetector.h"
+
+
+namespace {
+
+// Position of the own aircraft
+const QGeoCoordinate ownshipCoordinate(48.0, 8.0);
+
+// Position info at the given coordinate, with the given track and ground speed
+Positioning::PositionInfo positionInfo(const QGeoCoordinate& coordinate, double trackInDEG, double groundSpeedInMPS)
+{
+    QGeoPositionInfo info(coordinate, QDateTime::currentDateTimeUtc());
+    info.setAttribute(QGeoPositionInfo::Direction, trackInDEG);
+    info.setAttribute(QGeoPositionInfo::GroundSpeed, groundSpeedInMPS);
+    return Positioning::PositionInfo(info);
+}
+
+// Alarm level of one traffic, relative to the own aircraft that flies north
+// at 50 m/s
+int alarmLevel(const Positioning::PositionInfo& traffic, Units::Distance vDist)
+{
+    Traffic::ConflictDetector detector;
+    detector.setOwnship(positionInfo(ownshipCoordinate, 0.0, 50.0));
+    auto const index = detector.addTarget(u"3c6545"_qs, traffic, vDist);
+    detector.compute();
+    return detector.alarmLevel(index);
+}
+
+} // namespace
+
+
+void TestConflictDetector::headOn()
+{
+    // 500 m ahead, flying south at 50 m/s. The closest point of approach is
+    // reached after 5 s.
+    Traffic::ConflictDetector detector;
+    detector.setOwnship(positionInfo(ownshipCoordinate, 0.0, 50.0));
+    auto const index = detector.addTarget(u"3c6545"_qs, positionInfo(ownshipCoordinate.atDistanceAndAzimuth(500.0, 0.0), 180.0, 50.0), Units::Distance::fromM(0.0));
+    detector.compute();
+
+    QCOMPARE(detector.alarmLevel(index), 3);
+    QVERIFY(qAbs(detector.timeToCPA(index).toS() - 5.0) <= Traffic::ConflictDetector::timeStepInS);
+    QVERIFY(detector.distanceAtCPA(index).toM() < 10.0);
+}
+
+
+void TestConflictDetector::diverging()
+{
+    // 100 m ahead, flying north at 100 m/s
+    QCOMPARE(alarmLevel(positionInfo(ownshipCoordinate.atDistanceAndAzimuth(100.0, 0.0), 0.0, 100.0), Units::Distance::fromM(0.0)), 0);
+
+    // 100 m behind, flying south
+    QCOMPARE(alarmLevel(positionInfo(ownshipCoordinate.atDistanceAndAzimuth(100.0, 180.0), 180.0, 50.0), Units::Distance::fromM(0.0)), 0);
+}
+
+
+void TestConflictDetector::verticallySeparated()
+{
+    auto const traffic = positionInfo(ownshipCoordinate.atDistanceAndAzimuth(500.0, 0.0), 180.0, 50.0);
+    QCOMPARE(alarmLevel(traffic, Units::Distance::fromM(300.0)), 0);
+    QCOMPARE(alarmLevel(traffic, Units::Distance::fromM(-300.0)), 0);
+}
+
+
+void TestConflictDetector::noVerticalData()
+{
+    auto const traffic = positionInfo(ownshipCoordinate.atDistanceAndAzimuth(500.0, 0.0), 180.0, 50.0);
+    QCOMPARE(alarmLevel(traffic, Units::Distance::fromM(qQNaN())), 1);
+}
+
+
+void TestConflictDetector::ownshipEcho()
+{
+    auto const echo = positionInfo(ownshipCoordinate.atDistanceAndAzimuth(5.0, 90.0), 0.0, 50.0);
+    QCOMPARE(alarmLevel(echo, Units::Distance::fromM(0.0)), 0);
+    QCOMPARE(alarmLevel(echo, Units::Distance::fromM(qQNaN())), 0);
+}
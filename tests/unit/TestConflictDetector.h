@@ -0,0 +1,49 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <QObject>
+
+
+/*! \brief Unit tests for Traffic::ConflictDetector */
+
+class TestConflictDetector : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Head-on traffic at the same altitude raises the highest alarm level
+    void headOn();
+
+    // Traffic that is already diverging is never in conflict, even if it is
+    // close
+    void diverging();
+
+    // Traffic at a safe vertical distance is not in conflict
+    void verticallySeparated();
+
+    // Traffic without vertical distance is alarmed at most with level 1
+    void noVerticalData();
+
+    // The echo of the own transponder is not in conflict
+    void ownshipEcho();
+};
@@ -0,0 +1,240 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include <QByteArray>
+#include <QGeoPositionInfo>
+#include <QList>
+#include <QTest>
+
+#include "TestGDL90Broadcaster.h"
+#include "traffic/GDL90Broadcaster.h"
+#include "traffic/TrafficDataSource_Abstract.h"
+
+
+namespace {
+
+// Traffic data source that exposes the GDL90 parser and records the data it
+// decodes
+class Receiver : public Traffic::TrafficDataSource_Abstract
+{
+public:
+    Receiver() : TrafficDataSource_Abstract(false, nullptr)
+    {
+        connect(this, &Traffic::TrafficDataSource_Abstract::positionUpdated, this, [this](const Positioning::PositionInfo& positionInfo) {
+            positions << positionInfo;
+        });
+        connect(this, &Traffic::TrafficDataSource_Abstract::pressureAltitudeUpdated, this, [this](Units::Distance pressureAltitude) {
+            pressureAltitudes << pressureAltitude;
+        });
+        connect(this, &Traffic::TrafficDataSource_Abstract::factorWithPosition, this, [this](const Traffic::TrafficFactor_WithPosition& factor) {
+            Factor copy;
+            copy.ID = factor.ID();
+            copy.callSign = factor.callSign();
+            copy.alarmLevel = factor.alarmLevel();
+            copy.type = factor.type();
+            copy.coordinate = factor.positionInfo().coordinate();
+            copy.vDist = factor.vDist();
+            factors << copy;
+        });
+    }
+
+    using TrafficDataSource_Abstract::processGDLMessage;
+
+    [[nodiscard]] QString dataFormat() const override { return {}; }
+    [[nodiscard]] QString icon() const override { return {}; }
+    [[nodiscard]] QString sourceName() const override { return {}; }
+    void connectToTrafficReceiver() override {}
+    void disconnectFromTrafficReceiver() override {}
+
+    // Decoded traffic. The parser reuses its factor, so the values are copied.
+    struct Factor
+    {
+        QString ID;
+        QString callSign;
+        int alarmLevel {0};
+        Traffic::TrafficFactor_Abstract::AircraftType type {Traffic::TrafficFactor_Abstract::unknown};
+        QGeoCoordinate coordinate;
+        Units::Distance vDist;
+    };
+
+    QList<Positioning::PositionInfo> positions;
+    QList<Units::Distance> pressureAltitudes;
+    QList<Factor> factors;
+};
+
+// Broadcaster that hands its datagrams to a Receiver, in the same way as
+// TrafficDataSource_Udp does, instead of sending them
+class LoopbackBroadcaster : public Traffic::GDL90Broadcaster
+{
+public:
+    explicit LoopbackBroadcaster(Receiver& receiver) : m_receiver(receiver)
+    {
+        setEnabled(true);
+    }
+
+    // Calls the private slot that the heartbeat timer triggers
+    void heartbeat()
+    {
+        QMetaObject::invokeMethod(this, "sendHeartbeat");
+    }
+
+    int datagrams {0};
+
+protected:
+    void sendDatagram(QByteArrayView datagram) override
+    {
+        datagrams++;
+        foreach(auto const& frame, datagram.toByteArray().split(0x7e))
+        {
+            if (!frame.isEmpty())
+            {
+                m_receiver.processGDLMessage(frame);
+            }
+        }
+    }
+
+private:
+    Receiver& m_receiver;
+};
+
+// Position of the own aircraft, near Freiburg
+Positioning::PositionInfo ownshipPosition()
+{
+    QGeoPositionInfo info(QGeoCoordinate(47.9885, 7.8358), QDateTime::currentDateTimeUtc());
+    info.setAttribute(QGeoPositionInfo::GroundSpeed, Units::Speed::fromKN(95.0).toMPS());
+    info.setAttribute(QGeoPositionInfo::Direction, 273.0);
+    info.setAttribute(QGeoPositionInfo::VerticalSpeed, Units::Speed::fromFPM(-320.0).toMPS());
+    info.setAttribute(QGeoPositionInfo::HorizontalAccuracy, 8.0);
+    return Positioning::PositionInfo(info);
+}
+
+// Traffic at the given coordinate, valid for the lifetime of a factor
+void setupTraffic(Traffic::TrafficFactor_WithPosition& factor, const QString& ID, const QGeoCoordinate& coordinate)
+{
+    factor.setID(ID);
+    factor.setCallSign(u"d-Eabc"_qs);
+    factor.setAlarmLevel(2);
+    factor.setType(Traffic::TrafficFactor_Abstract::Glider);
+    factor.setHDist(Units::Distance::fromNM(1.5));
+    factor.setVDist(Units::Distance::fromFT(500.0));
+    factor.setPositionInfo(Positioning::PositionInfo(QGeoPositionInfo(coordinate, QDateTime::currentDateTimeUtc())));
+    factor.startLiveTime();
+}
+
+// Resolution of latitude and longitude in GDL90 reports, in degrees
+constexpr double coordinateResolution = 180.0/0x800000;
+
+} // namespace
+
+
+void TestGDL90Broadcaster::heartbeat()
+{
+    Receiver receiver;
+    LoopbackBroadcaster broadcaster(receiver);
+    QVERIFY(!receiver.receivingHeartbeat());
+
+    broadcaster.heartbeat();
+    QCOMPARE(broadcaster.datagrams, 1);
+    QVERIFY(receiver.receivingHeartbeat());
+    QVERIFY(receiver.sharedMetrics()->snapshot().checksumErrors == 0);
+}
+
+
+void TestGDL90Broadcaster::ownship()
+{
+    Receiver receiver;
+    LoopbackBroadcaster broadcaster(receiver);
+
+    auto const sent = ownshipPosition();
+    broadcaster.sendOwnship(sent, Units::Distance::fromFT(3000.0));
+    QCOMPARE(receiver.positions.size(), 1);
+    QCOMPARE(receiver.pressureAltitudes.size(), 1);
+
+    auto const& received = receiver.positions.constFirst();
+    QVERIFY(received.isValid());
+    QVERIFY(qAbs(received.coordinate().latitude() - sent.coordinate().latitude()) <= coordinateResolution);
+    QVERIFY(qAbs(received.coordinate().longitude() - sent.coordinate().longitude()) <= coordinateResolution);
+    QVERIFY(qAbs(received.groundSpeed().toKN() - 95.0) <= 0.5);
+    QVERIFY(qAbs(received.trueTrack().toDEG() - 273.0) <= 360.0/256.0);
+    QVERIFY(qAbs(received.verticalSpeed().toFPM() + 320.0) <= 64.0);
+    QVERIFY(received.positionErrorEstimate().toM() <= 10.0);
+    QCOMPARE(receiver.pressureAltitudes.constFirst().toFeet(), 3000.0);
+
+    // Unknown pressure altitude is sent as such
+    Receiver receiver2;
+    LoopbackBroadcaster broadcaster2(receiver2);
+    broadcaster2.sendOwnship(sent, Units::Distance::fromM(qQNaN()));
+    QCOMPARE(receiver2.pressureAltitudes.size(), 1);
+    QVERIFY(!receiver2.pressureAltitudes.constFirst().isFinite());
+}
+
+
+void TestGDL90Broadcaster::traffic()
+{
+    Receiver receiver;
+    LoopbackBroadcaster broadcaster(receiver);
+
+    // The receiver computes vertical distances only if it knows the pressure
+    // altitude of the own aircraft
+    broadcaster.sendOwnship(ownshipPosition(), Units::Distance::fromFT(3000.0));
+
+    Traffic::TrafficFactor_WithPosition glider;
+    setupTraffic(glider, u"13C6545"_qs, QGeoCoordinate(48.01, 7.83));
+    Traffic::TrafficFactor_WithPosition invalid;
+    QVERIFY(glider.valid());
+    QVERIFY(!invalid.valid());
+
+    broadcaster.sendTraffic({&glider, &invalid, nullptr}, Units::Distance::fromFT(3000.0));
+    QCOMPARE(receiver.factors.size(), 1);
+
+    auto const& received = receiver.factors.constFirst();
+    QCOMPARE(received.ID, u"13c6545"_qs);
+    QCOMPARE(received.callSign, u"D EABC"_qs);
+    QCOMPARE(received.alarmLevel, 1);
+    QCOMPARE(received.type, Traffic::TrafficFactor_Abstract::Glider);
+    QVERIFY(qAbs(received.coordinate.latitude() - 48.01) <= coordinateResolution);
+    QVERIFY(qAbs(received.coordinate.longitude() - 7.83) <= coordinateResolution);
+    QCOMPARE(received.vDist.toFeet(), 500.0);
+    QVERIFY(receiver.sharedMetrics()->snapshot().checksumErrors == 0);
+}
+
+
+void TestGDL90Broadcaster::escaping()
+{
+    Receiver receiver;
+    LoopbackBroadcaster broadcaster(receiver);
+
+    // Address 0x7e7d7e, latitude 0x227e7d and longitude 0x7d7e00 in units of
+    // the coordinate resolution
+    QGeoCoordinate const coordinate(0x227e7d*coordinateResolution, 0x7d7e00*coordinateResolution);
+    Traffic::TrafficFactor_WithPosition factor;
+    setupTraffic(factor, u"17e7d7e"_qs, coordinate);
+
+    broadcaster.sendTraffic({&factor}, Units::Distance::fromM(qQNaN()));
+    QCOMPARE(receiver.factors.size(), 1);
+
+    auto const& received = receiver.factors.constFirst();
+    QCOMPARE(received.ID, u"17e7d7e"_qs);
+    QCOMPARE(received.coordinate.latitude(), coordinate.latitude());
+    QCOMPARE(received.coordinate.longitude(), coordinate.longitude());
+    QVERIFY(!received.vDist.isFinite());
+    QVERIFY(receiver.sharedMetrics()->snapshot().checksumErrors == 0);
+}
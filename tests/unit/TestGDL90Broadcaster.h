@@ -0,0 +1,53 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <QObject>
+
+
+/*! \brief Unit tests for Traffic::GDL90Broadcaster
+ *
+ *  The messages sent by the broadcaster are decoded by the GDL90 parser of
+ *  TrafficDataSource_Abstract, and the decoded values are compared to the
+ *  values that were sent.
+ */
+
+class TestGDL90Broadcaster : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Heartbeat is recognized by the receiver
+    void heartbeat();
+
+    // Position, speeds, track and pressure altitude of the own aircraft
+    // survive the round trip, up to the resolution of the format
+    void ownship();
+
+    // ID, call sign, alarm level, type, position and vertical distance of
+    // traffic survive the round trip
+    void traffic();
+
+    // Addresses and positions that contain the flag and escape bytes 0x7e
+    // and 0x7d are escaped correctly
+    void escaping();
+};
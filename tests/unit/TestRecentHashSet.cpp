@@ -0,0 +1,176 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include <QByteArray>
+#include <QRandomGenerator>
+#include <QTest>
+#include <deque>
+#include <limits>
+#include <unordered_set>
+
+#include "TestRecentHashSet.h"
+#include "traffic/RecentHashSet.h"
+
+
+namespace {
+
+constexpr std::size_t window = 512;
+
+// Reference implementation of RecentHashSet
+class ReferenceSet
+{
+public:
+    bool insert(std::size_t hash)
+    {
+        if (m_set.contains(hash))
+        {
+            return false;
+        }
+        if (m_fifo.size() == window)
+        {
+            m_set.erase(m_fifo.front());
+            m_fifo.pop_front();
+        }
+        m_fifo.push_back(hash);
+        m_set.insert(hash);
+        return true;
+    }
+
+private:
+    std::deque<std::size_t> m_fifo;
+    std::unordered_set<std::size_t> m_set;
+};
+
+// Hashes of a flood of datagrams. Every datagram carries a sequence number and
+// is repeated up to three times, with up to maxJitter other datagrams in
+// between, as traffic data receivers do when they send on several channels.
+QList<std::size_t> floodHashes(qsizetype numDatagrams, qsizetype maxJitter, quint32 seed)
+{
+    QRandomGenerator generator(seed);
+    QList<std::size_t> result;
+    result.reserve(3*numDatagrams);
+    QList<std::pair<qsizetype, std::size_t>> pending;
+    for(qsizetype i=0; i<numDatagrams; i++)
+    {
+        auto const datagram = QByteArray("$PFLAA,0,") + QByteArray::number(i) + QByteArray(",1234,220,2,3C6545*");
+        auto const hash = static_cast<std::size_t>(qHash(datagram));
+        result << hash;
+        auto const repeats = generator.bounded(3);
+        for(int r=0; r<repeats; r++)
+        {
+            pending << std::pair(i + 1 + generator.bounded(maxJitter), hash);
+        }
+        for(qsizetype p=pending.size()-1; p>=0; p--)
+        {
+            if (pending[p].first == i)
+            {
+                result << pending[p].second;
+                pending.removeAt(p);
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+
+void TestRecentHashSet::expiry()
+{
+    Traffic::RecentHashSet<window> set;
+    for(std::size_t i=0; i<window; i++)
+    {
+        QVERIFY(set.insert(i));
+    }
+    for(std::size_t i=0; i<window; i++)
+    {
+        QVERIFY(set.contains(i));
+        QVERIFY(!set.insert(i));
+    }
+
+    // Every new value expires the oldest one
+    for(std::size_t i=window; i<3*window; i++)
+    {
+        QVERIFY(set.insert(i));
+        QVERIFY(!set.contains(i-window));
+        QVERIFY(set.contains(i-window+1));
+    }
+}
+
+
+void TestRecentHashSet::duplicateFlood()
+{
+    auto const hashes = floodHashes(200000, 64, 1);
+
+    Traffic::RecentHashSet<window> set;
+    ReferenceSet reference;
+    qsizetype accepted = 0;
+    for(auto hash : hashes)
+    {
+        auto const inserted = set.insert(hash);
+        QCOMPARE(inserted, reference.insert(hash));
+        if (inserted)
+        {
+            accepted++;
+        }
+    }
+
+    // Repetitions arrive well within the window, so that every datagram is
+    // accepted exactly once
+    QCOMPARE(accepted, qsizetype(200000));
+}
+
+
+void TestRecentHashSet::structuredHashes()
+{
+    // Values that differ only in a few bits. If the home slot were taken from
+    // the low bits of the product, the values with large shifts would all share
+    // one home slot, and probe sequences would grow to the size of the table.
+    for(int shift : {0, 10, 20, 32, 48})
+    {
+        if (shift >= std::numeric_limits<std::size_t>::digits)
+        {
+            continue;
+        }
+        Traffic::RecentHashSet<window> set;
+        ReferenceSet reference;
+        for(std::size_t i=0; i<20*window; i++)
+        {
+            auto const hash = (i % (2*window)) << shift;
+            QCOMPARE(set.insert(hash), reference.insert(hash));
+        }
+    }
+}
+
+
+void TestRecentHashSet::benchmarkFlood()
+{
+    auto const hashes = floodHashes(100000, 64, 2);
+    QBENCHMARK {
+        Traffic::RecentHashSet<window> set;
+        qsizetype accepted = 0;
+        for(auto hash : hashes)
+        {
+            accepted += set.insert(hash) ? 1 : 0;
+        }
+        QCOMPARE(accepted, qsizetype(100000));
+    }
+}
@@ -0,0 +1,46 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <QObject>
+
+
+/*! \brief Unit tests for Traffic::RecentHashSet */
+
+class TestRecentHashSet : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Values are found until they expire from the window
+    void expiry();
+
+    // Flood of UDP datagrams, every datagram repeated several times with
+    // jitter, compared against a straightforward reference implementation
+    void duplicateFlood();
+
+    // Hash values that differ only in their low or only in their high bits
+    void structuredHashes();
+
+    // Throughput of insertions during a duplicate flood
+    void benchmarkFlood();
+};
@@ -0,0 +1,120 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include <QNetworkDatagram>
+#include <QTest>
+#include <QUdpSocket>
+
+#include "TestTrafficDataReader.h"
+#include "traffic/TrafficDataReader.h"
+
+
+namespace {
+
+// Number of datagrams that the reader remembers in order to sort out
+// duplicates, see TrafficDataReader::m_receivedDatagramHashes
+constexpr qsizetype window = 512;
+
+// XGPS traffic report with the given sequence number
+QByteArray xtraffic(qsizetype number)
+{
+    return QByteArray("XTRAFFICenroute,") + QByteArray::number(number) + QByteArray(",47.9885,7.8358,3500.0,0.0,1,273.0,48.9,D-EABC");
+}
+
+// GDL90 heartbeat, as in the example of the GDL90 specification
+const QByteArray heartbeat = QByteArray::fromHex("7e008141dbd00802b38b7e");
+
+} // namespace
+
+
+void TestTrafficDataReader::udpDuplicates()
+{
+    auto metrics = std::make_shared<Traffic::TrafficDataMetrics>();
+    Traffic::TrafficDataReader reader;
+    reader.setMetrics(metrics);
+
+    // Collect frames in the same way as TrafficDataSource_AbstractSocket does
+    QList<Traffic::TrafficDataReader::Frame> frames;
+    connect(&reader, &Traffic::TrafficDataReader::framesAvailable, this, [&]() {
+        reader.resetFramesAvailable();
+        Traffic::TrafficDataReader::Frame frame;
+        while (reader.takeFrame(frame))
+        {
+            frames << frame;
+        }
+    });
+
+    // Find a free port
+    QUdpSocket probe;
+    QVERIFY(probe.bind(QHostAddress::LocalHost, 0));
+    auto const port = probe.localPort();
+    probe.close();
+    reader.bindUdp(port);
+
+    // Datagrams are sent in batches, so that the receive buffer of the socket
+    // cannot overflow
+    QUdpSocket sender;
+    quint64 bytesSent = 0;
+    auto send = [&](const QByteArray& datagram) {
+        QCOMPARE(sender.writeDatagram(datagram, QHostAddress::LocalHost, port), qint64(datagram.size()));
+        bytesSent += datagram.size();
+    };
+
+    constexpr qsizetype numDatagrams = window + 100;
+    for(qsizetype i=0; i<numDatagrams; i++)
+    {
+        send(xtraffic(i));
+        send(xtraffic(i));
+        if ((i % 50 == 49) || (i == numDatagrams-1))
+        {
+            QTRY_COMPARE(metrics->snapshot().bytesReceived, bytesSent);
+        }
+    }
+    QCOMPARE(frames.size(), numDatagrams);
+    for(qsizetype i=0; i<numDatagrams; i++)
+    {
+        QCOMPARE(frames.at(i).type, Traffic::TrafficDataReader::Frame::XGPS);
+        QCOMPARE(frames.at(i).data, xtraffic(i));
+    }
+
+    // The first datagram has expired from the window, the last one has not
+    frames.clear();
+    send(xtraffic(0));
+    send(xtraffic(numDatagrams-1));
+    QTRY_COMPARE(metrics->snapshot().bytesReceived, bytesSent);
+    QCOMPARE(frames.size(), 1);
+    QCOMPARE(frames.constFirst().data, xtraffic(0));
+
+    // GDL90 datagrams are decoded once. Datagrams with invalid checksum are
+    // counted, but not delivered.
+    frames.clear();
+    auto corrupted = heartbeat;
+    corrupted[3] = static_cast<char>(corrupted[3] ^ 0x01);
+    send(heartbeat);
+    send(heartbeat);
+    send(corrupted);
+    QTRY_COMPARE(metrics->snapshot().bytesReceived, bytesSent);
+    QCOMPARE(frames.size(), 1);
+    QCOMPARE(frames.constFirst().type, Traffic::TrafficDataReader::Frame::GDL90);
+    QCOMPARE(static_cast<quint8>(frames.constFirst().data.at(0)), quint8(0));
+    QCOMPARE(metrics->snapshot().checksumErrors, quint64(1));
+    QCOMPARE(metrics->snapshot().framesDropped, quint64(0));
+}
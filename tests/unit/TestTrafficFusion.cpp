@@ -0,0 +1,114 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include <QGeoPositionInfo>
+#include <QTest>
+
+#include "TestTrafficFusion.h"
+#include "traffic/TrafficFactor_WithPosition.h"
+#include "traffic/TrafficFusion.h"
+
+
+namespace {
+
+// Position info at the given coordinate
+Positioning::PositionInfo positionInfo(const QGeoCoordinate& coordinate)
+{
+    return Positioning::PositionInfo(QGeoPositionInfo(coordinate, QDateTime::currentDateTimeUtc()));
+}
+
+// Traffic factor with the given ID at the given coordinate
+void setupTraffic(Traffic::TrafficFactor_WithPosition& factor, const QString& ID, const QGeoCoordinate& coordinate)
+{
+    factor.setID(ID);
+    factor.setVDist(Units::Distance::fromM(50.0));
+    factor.setPositionInfo(positionInfo(coordinate));
+}
+
+// Rank of the data sources, in the order of TrafficDataProvider::dataSources
+constexpr int flarmRank = 0;
+constexpr int gdl90Rank = 1;
+constexpr int otherRank = 2;
+
+} // namespace
+
+
+void TestTrafficFusion::flarmAndGDL90()
+{
+    Traffic::TrafficFusion fusion;
+
+    // FLARM reports the ICAO address in upper case, GDL90 prepends the address
+    // type
+    Traffic::TrafficFactor_WithPosition flarm;
+    setupTraffic(flarm, u"3C6545"_qs, QGeoCoordinate(48.0, 8.0));
+    Traffic::TrafficFactor_WithPosition gdl90;
+    setupTraffic(gdl90, u"13c6545"_qs, QGeoCoordinate(48.0, 8.001));
+
+    auto const gdl90Key = fusion.correlate(gdl90.ID(), gdl90.positionInfo(), gdl90.vDist(), gdl90Rank);
+    QVERIFY(!gdl90Key.isEmpty());
+    auto const flarmKey = fusion.correlate(flarm.ID(), flarm.positionInfo(), flarm.vDist(), flarmRank);
+    QCOMPARE(flarmKey, gdl90Key);
+
+    // The track key is internal. The IDs reported by the sources, which are
+    // shown to the user and used to look up registrations, are unchanged.
+    QCOMPARE(flarm.ID(), u"3C6545"_qs);
+    QCOMPARE(gdl90.ID(), u"13c6545"_qs);
+}
+
+
+void TestTrafficFusion::preferredSource()
+{
+    Traffic::TrafficFusion fusion;
+    auto const info = positionInfo(QGeoCoordinate(48.0, 8.0));
+
+    QVERIFY(!fusion.correlate(u"3C6545"_qs, info, Units::Distance::fromM(50.0), flarmRank).isEmpty());
+    QVERIFY(fusion.correlate(u"13c6545"_qs, info, Units::Distance::fromM(50.0), gdl90Rank).isEmpty());
+
+    // Other traffic is not affected
+    QVERIFY(!fusion.correlate(u"13d1234"_qs, info, Units::Distance::fromM(1000.0), gdl90Rank).isEmpty());
+
+    // Once the tracks are gone, the report is accepted again
+    fusion.clear();
+    QVERIFY(!fusion.correlate(u"13c6545"_qs, info, Units::Distance::fromM(50.0), gdl90Rank).isEmpty());
+}
+
+
+void TestTrafficFusion::spatialGating()
+{
+    Traffic::TrafficFusion fusion;
+    const QGeoCoordinate coordinate(48.0, 8.0);
+
+    // GDL90 prints the bytes of the address without leading zeros, so that
+    // the ID "10a0b0c" of address 0a0b0c cannot be matched by ID
+    auto const flarmKey = fusion.correlate(u"0A0B0C"_qs, positionInfo(coordinate), Units::Distance::fromM(50.0), flarmRank);
+    auto const gdl90Key = fusion.correlate(u"1abc"_qs, positionInfo(coordinate.atDistanceAndAzimuth(50.0, 90.0)), Units::Distance::fromM(60.0), gdl90Rank);
+    // The report is filed with the FLARM track and dropped, because FLARM is
+    // preferred
+    QVERIFY(gdl90Key.isEmpty());
+
+    // Traffic outside the gates is a different track
+    auto const farKey = fusion.correlate(u"1def"_qs, positionInfo(coordinate.atDistanceAndAzimuth(1000.0, 90.0)), Units::Distance::fromM(50.0), otherRank);
+    QVERIFY(!farKey.isEmpty());
+    QVERIFY(farKey != flarmKey);
+    auto const highKey = fusion.correlate(u"1bcd"_qs, positionInfo(coordinate), Units::Distance::fromM(500.0), otherRank);
+    QVERIFY(!highKey.isEmpty());
+    QVERIFY(highKey != flarmKey);
+}
@@ -0,0 +1,106 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include <QTest>
+
+#include "TestVerticalLimit.h"
+#include "geomaps/VerticalLimit.h"
+
+
+using Reference = GeoMaps::VerticalLimit::Reference;
+
+
+void TestVerticalLimit::parse_data()
+{
+    QTest::addColumn<QString>("limit");
+    QTest::addColumn<Reference>("reference");
+    QTest::addColumn<float>("value");
+
+    // Ground
+    QTest::newRow("GND") << u"GND"_qs << Reference::GND << 0.0F;
+    QTest::newRow("SFC") << u"SFC"_qs << Reference::GND << 0.0F;
+    QTest::newRow("ground") << u" ground "_qs << Reference::GND << 0.0F;
+    QTest::newRow("Surface") << u"Surface"_qs << Reference::GND << 0.0F;
+    QTest::newRow("0 AGL") << u"0 AGL"_qs << Reference::GND << 0.0F;
+    QTest::newRow("0ft ASFC") << u"0ft ASFC"_qs << Reference::GND << 0.0F;
+
+    // No limit
+    QTest::newRow("UNL") << u"UNL"_qs << Reference::UNL << 0.0F;
+    QTest::newRow("UNLIM") << u"UNLIM"_qs << Reference::UNL << 0.0F;
+    QTest::newRow("unlimited") << u"unlimited"_qs << Reference::UNL << 0.0F;
+
+    // Flight levels
+    QTest::newRow("FL 65") << u"FL 65"_qs << Reference::FL << 65.0F;
+    QTest::newRow("FL065") << u"FL065"_qs << Reference::FL << 65.0F;
+    QTest::newRow("fl95") << u"fl95"_qs << Reference::FL << 95.0F;
+    QTest::newRow("FL 100 (MON-FRI)") << u"FL 100 (MON-FRI)"_qs << Reference::FL << 100.0F;
+
+    // Altitudes above mean sea level
+    QTest::newRow("2500") << u"2500"_qs << Reference::MSL << 2500.0F;
+    QTest::newRow("4500 ft MSL") << u"4500 ft MSL"_qs << Reference::MSL << 4500.0F;
+    QTest::newRow("1000ft AMSL") << u"1000ft AMSL"_qs << Reference::MSL << 1000.0F;
+    QTest::newRow("3500F ALT") << u"3500F ALT"_qs << Reference::MSL << 3500.0F;
+    QTest::newRow("1000 m") << u"1000 m"_qs << Reference::MSL << 3280.84F;
+    QTest::newRow("2000 MSL") << u"2000 MSL"_qs << Reference::MSL << 2000.0F;
+
+    // Heights above ground
+    QTest::newRow("1500 AGL") << u"1500 AGL"_qs << Reference::AGL << 1500.0F;
+    QTest::newRow("300 m AGL") << u"300 m AGL"_qs << Reference::AGL << 984.252F;
+    QTest::newRow("2000ft GND") << u"2000ft GND"_qs << Reference::AGL << 2000.0F;
+    QTest::newRow("1000 SFC") << u"1000 SFC"_qs << Reference::AGL << 1000.0F;
+    QTest::newRow("500FT ASFC") << u"500FT ASFC"_qs << Reference::AGL << 500.0F;
+
+    // Strings that cannot be parsed
+    QTest::newRow("empty") << QString() << Reference::Unknown << 0.0F;
+    QTest::newRow("NOTAM") << u"NOTAM"_qs << Reference::Unknown << 0.0F;
+    QTest::newRow("by ATC") << u"by ATC"_qs << Reference::Unknown << 0.0F;
+    QTest::newRow("FL") << u"FL"_qs << Reference::Unknown << 0.0F;
+    QTest::newRow("FLIGHT") << u"FLIGHT"_qs << Reference::Unknown << 0.0F;
+    QTest::newRow("GNDX") << u"GNDX"_qs << Reference::Unknown << 0.0F;
+    QTest::newRow("-500") << u"-500"_qs << Reference::Unknown << 0.0F;
+    QTest::newRow("1.2.3") << u"1.2.3"_qs << Reference::Unknown << 0.0F;
+}
+
+
+void TestVerticalLimit::parse()
+{
+    QFETCH(QString, limit);
+    QFETCH(Reference, reference);
+    QFETCH(float, value);
+
+    GeoMaps::VerticalLimit const verticalLimit(limit);
+    QCOMPARE(verticalLimit.reference(), reference);
+    QVERIFY(qAbs(verticalLimit.value() - value) < 0.01F);
+}
+
+
+void TestVerticalLimit::estimatedMSL()
+{
+    auto const fallback = Units::Distance::fromFT(-1.0);
+
+    QCOMPARE(GeoMaps::VerticalLimit(u"4500 ft MSL"_qs).estimatedMSL(fallback).toFeet(), 4500.0);
+    QCOMPARE(GeoMaps::VerticalLimit(u"1500 AGL"_qs).estimatedMSL(fallback).toFeet(), 1500.0);
+    QCOMPARE(GeoMaps::VerticalLimit(u"FL 65"_qs).estimatedMSL(fallback).toFeet(), 6500.0);
+    QCOMPARE(GeoMaps::VerticalLimit(u"GND"_qs).estimatedMSL(fallback).toFeet(), 0.0);
+    QVERIFY(qIsInf(GeoMaps::VerticalLimit(u"UNL"_qs).estimatedMSL(fallback).toFeet()));
+    QCOMPARE(GeoMaps::VerticalLimit(u"NOTAM"_qs).estimatedMSL(fallback).toFeet(), -1.0);
+    QCOMPARE(GeoMaps::VerticalLimit().estimatedMSL(fallback).toFeet(), -1.0);
+}
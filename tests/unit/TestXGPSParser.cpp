@@ -0,0 +1,274 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include <QByteArray>
+#include <QList>
+#include <QRandomGenerator>
+#include <QTest>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "TestXGPSParser.h"
+#include "traffic/XGPSParser.h"
+
+
+namespace {
+
+using OwnshipRecord = Traffic::XGPS::Record<Traffic::XGPS::OwnshipLayout>;
+using TrafficRecord = Traffic::XGPS::Record<Traffic::XGPS::TrafficLayout>;
+
+const std::vector<std::string> validMessages = {
+    "XGPSStratux,7.85,47.99,1066.8,84.4,48.9",
+    "XGPSMy Sim,-118.32486725,33.85397339,1142.9,68.2,76.4",
+    "XTRAFFICStratux,3c6545,48.01,7.83,3700.0,-256,1,270.0,95.0,DEXYZ",
+    "XTRAFFICMy Sim,168,33.85397339,-118.32486725,3749.9,-193.2,0,68.2,148.6,KS6",
+};
+
+// Reference implementation: split at every comma
+std::vector<std::string_view> split(std::string_view message)
+{
+    std::vector<std::string_view> result;
+    std::size_t start = 0;
+    while (true)
+    {
+        auto const end = message.find(',', start);
+        result.push_back(message.substr(start, end-start));
+        if (end == std::string_view::npos)
+        {
+            return result;
+        }
+        start = end+1;
+    }
+}
+
+// Checks a record against the reference splitter, and checks that every
+// number accepted by the record is read in the same way by std::strtod
+template<typename Record, typename Layout>
+bool agreesWithReference(std::string_view message)
+{
+    Record record;
+    auto const fields = split(message);
+    auto const expected = message.starts_with(Layout::tag) && (fields.size() == Layout::numFields);
+    if (record.parse(message) != expected)
+    {
+        return false;
+    }
+    if (!expected)
+    {
+        return true;
+    }
+
+    for(std::size_t i=0; i<Layout::numFields; i++)
+    {
+        auto const field = record.field(i);
+        if ((field != fields[i]) || (field.data() < message.data()) || (field.data()+field.size() > message.data()+message.size()))
+        {
+            return false;
+        }
+
+        double value = 0.0;
+        if (!record.number(i, value))
+        {
+            continue;
+        }
+        std::string text(field);
+        auto const first = text.find_first_not_of(" \t\r\n");
+        text = text.substr(first, text.find_last_not_of(" \t\r\n") - first + 1);
+        char* end = nullptr;
+        auto const reference = std::strtod(text.c_str(), &end);
+        if (end != text.c_str()+text.size())
+        {
+            return false;
+        }
+        if ((value != reference) && !(std::isnan(value) && std::isnan(reference)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Random modification of a message
+std::string mutate(std::string message, QRandomGenerator& generator)
+{
+    static const std::string alphabet = ",,,+-. 0123456789eEinfaXGPSTR\t\r\n\x7f\xff";
+    auto const numMutations = 1 + generator.bounded(4);
+    for(int m=0; m<numMutations; m++)
+    {
+        auto const position = message.empty() ? 0 : static_cast<std::size_t>(generator.bounded(static_cast<int>(message.size())));
+        auto const character = alphabet[static_cast<std::size_t>(generator.bounded(static_cast<int>(alphabet.size())))];
+        switch(generator.bounded(5))
+        {
+        case 0:
+            if (!message.empty())
+            {
+                message[position] = character;
+            }
+            break;
+        case 1:
+            message.insert(position, 1, character);
+            break;
+        case 2:
+            if (!message.empty())
+            {
+                message.erase(position, 1);
+            }
+            break;
+        case 3:
+            message.resize(position);
+            break;
+        default:
+            message[position % qMax(std::size_t(1), message.size())] = static_cast<char>(generator.bounded(256));
+            break;
+        }
+    }
+    return message;
+}
+
+} // namespace
+
+
+void TestXGPSParser::messages()
+{
+    double value = 0.0;
+
+    OwnshipRecord ownship;
+    QVERIFY(ownship.parse(validMessages[0]));
+    QVERIFY(ownship.field(0) == "XGPSStratux");
+    QVERIFY(ownship.number(Traffic::XGPS::OwnshipLayout::Latitude, value));
+    QCOMPARE(value, 47.99);
+    QVERIFY(ownship.number(Traffic::XGPS::OwnshipLayout::GroundSpeedInMPS, value));
+    QCOMPARE(value, 48.9);
+
+    TrafficRecord traffic;
+    QVERIFY(traffic.parse(validMessages[3]));
+    QVERIFY(traffic.field(Traffic::XGPS::TrafficLayout::ID) == "168");
+    QVERIFY(traffic.field(Traffic::XGPS::TrafficLayout::CallSign) == "KS6");
+    QVERIFY(traffic.number(Traffic::XGPS::TrafficLayout::Longitude, value));
+    QCOMPARE(value, -118.32486725);
+
+    // Wrong tag, too few and too many fields
+    QVERIFY(!ownship.parse(validMessages[2]));
+    QVERIFY(!traffic.parse(validMessages[0]));
+    QVERIFY(!ownship.parse("XGPSStratux,7.85,47.99,1066.8,84.4"));
+    QVERIFY(!ownship.parse("XGPSStratux,7.85,47.99,1066.8,84.4,48.9,"));
+    QVERIFY(!ownship.parse(""));
+    QVERIFY(!ownship.parse("XGP"));
+
+    // Empty fields are fields
+    QVERIFY(ownship.parse("XGPS,,,,,"));
+    QVERIFY(!ownship.number(Traffic::XGPS::OwnshipLayout::Longitude, value));
+}
+
+
+void TestXGPSParser::numbers()
+{
+    OwnshipRecord ownship;
+    double value = 0.0;
+
+    QVERIFY(ownship.parse("XGPSSim, 7.5 ,+47.25,\t-12\r\n,1e3,x"));
+    QVERIFY(ownship.number(Traffic::XGPS::OwnshipLayout::Longitude, value));
+    QCOMPARE(value, 7.5);
+    QVERIFY(ownship.number(Traffic::XGPS::OwnshipLayout::Latitude, value));
+    QCOMPARE(value, 47.25);
+    QVERIFY(ownship.number(Traffic::XGPS::OwnshipLayout::AltitudeInM, value));
+    QCOMPARE(value, -12.0);
+    QVERIFY(ownship.number(Traffic::XGPS::OwnshipLayout::Track, value));
+    QCOMPARE(value, 1000.0);
+
+    // Failure leaves the result untouched
+    value = 3.0;
+    QVERIFY(!ownship.number(Traffic::XGPS::OwnshipLayout::GroundSpeedInMPS, value));
+    QCOMPARE(value, 3.0);
+
+    for(const auto* message : {"XGPSSim,1.5x,0,0,0,0", "XGPSSim,1 5,0,0,0,0", "XGPSSim,+,0,0,0,0", "XGPSSim,++1,0,0,0,0", "XGPSSim,+-1,0,0,0,0", "XGPSSim,   ,0,0,0,0"})
+    {
+        QVERIFY(ownship.parse(message));
+        QVERIFY2(!ownship.number(Traffic::XGPS::OwnshipLayout::Longitude, value), message);
+    }
+}
+
+
+void TestXGPSParser::fuzz()
+{
+    QRandomGenerator generator(1);
+    for(int i=0; i<100000; i++)
+    {
+        auto const& original = validMessages[static_cast<std::size_t>(i) % validMessages.size()];
+        auto const message = mutate(original, generator);
+        QVERIFY2((agreesWithReference<OwnshipRecord, Traffic::XGPS::OwnshipLayout>(message)), message.c_str());
+        QVERIFY2((agreesWithReference<TrafficRecord, Traffic::XGPS::TrafficLayout>(message)), message.c_str());
+    }
+}
+
+
+void TestXGPSParser::benchmarkRecord()
+{
+    auto const& message = validMessages[3];
+    double sum = 0.0;
+    QBENCHMARK {
+        for(int i=0; i<10000; i++)
+        {
+            TrafficRecord record;
+            if (record.parse(message))
+            {
+                double value = 0.0;
+                for(auto index : {Traffic::XGPS::TrafficLayout::Latitude, Traffic::XGPS::TrafficLayout::Longitude, Traffic::XGPS::TrafficLayout::AltitudeInFT,
+                                  Traffic::XGPS::TrafficLayout::VerticalSpeedInFPM, Traffic::XGPS::TrafficLayout::Track, Traffic::XGPS::TrafficLayout::GroundSpeedInKN})
+                {
+                    if (record.number(index, value))
+                    {
+                        sum += value;
+                    }
+                }
+            }
+        }
+    }
+    QVERIFY(sum != 0.0);
+}
+
+
+void TestXGPSParser::benchmarkSplit()
+{
+    auto const message = QByteArray::fromStdString(validMessages[3]);
+    double sum = 0.0;
+    QBENCHMARK {
+        for(int i=0; i<10000; i++)
+        {
+            auto const fields = message.split(',');
+            if (fields.size() == 10)
+            {
+                for(auto index : {2, 3, 4, 5, 7, 8})
+                {
+                    bool ok = false;
+                    auto const value = fields[index].trimmed().toDouble(&ok);
+                    if (ok)
+                    {
+                        sum += value;
+                    }
+                }
+            }
+        }
+    }
+    QVERIFY(sum != 0.0);
+}
@@ -0,0 +1,49 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <QObject>
+
+
+/*! \brief Unit tests for Traffic::XGPS::Record */
+
+class TestXGPSParser : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Well-formed and malformed ownship and traffic reports
+    void messages();
+
+    // Numerical fields, including whitespace and signs
+    void numbers();
+
+    // Random mutations of valid messages, compared against a reference
+    // splitter and against std::strtod
+    void fuzz();
+
+    // Throughput of parsing traffic reports
+    void benchmarkRecord();
+
+    // Throughput of the same work with QByteArray::split(), for comparison
+    void benchmarkSplit();
+};
@@ -0,0 +1,77 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include <QCoreApplication>
+#include <QStandardPaths>
+#include <QTest>
+
+#include "TestAircraft.h"
+#include "TestConflictDetector.h"
+#include "TestGDL90Broadcaster.h"
+#include "TestRecentHashSet.h"
+#include "TestTrafficDataReader.h"
+#include "TestTrafficFusion.h"
+#include "TestVerticalLimit.h"
+#include "TestXGPSParser.h"
+
+
+// Runs all unit tests. Command line arguments are passed to every test, see
+// QTest::qExec().
+auto main(int argc, char *argv[]) -> int
+{
+    QCoreApplication const application(argc, argv);
+    QStandardPaths::setTestModeEnabled(true);
+
+    int status = 0;
+    {
+        TestAircraft test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    {
+        TestConflictDetector test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    {
+        TestGDL90Broadcaster test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    {
+        TestRecentHashSet test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    {
+        TestTrafficDataReader test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    {
+        TestTrafficFusion test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    {
+        TestVerticalLimit test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    {
+        TestXGPSParser test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+    return status;
+}